@@ -0,0 +1,290 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <log4cpp/Category.hh>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+// Captured packets are streamed to a temporary file as they arrive so a long capture of many universes
+// is limited by disk space rather than memory. Only a small index entry per packet is kept in memory.
+//
+// Each record is a 13 byte header followed by the payload:
+//    uint32 ms since the capture started, uint16 universe, uint8 protocol, uint8 sequence number,
+//    uint16 channels, uint8 encoding, uint16 stored payload length
+// The payload is optionally xored with the previous packet for the same universe (ENCODING_DELTA) and
+// then optionally run length encoded (ENCODING_RLE). Every KEYFRAME_INTERVAL packets a universe is
+// stored without the delta so reading can start part way through.
+class CaptureLog
+{
+public:
+    static const uint8_t ENCODING_DELTA = 0x01;
+    static const uint8_t ENCODING_RLE = 0x02;
+    static const int KEYFRAME_INTERVAL = 40;
+    static const int RECORD_HEADER_SIZE = 13;
+    static const int MAX_STORED_SIZE = 512; // anything that does not compress is stored as is
+
+private:
+    static const size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+    static const size_t READ_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    wxFile _file;
+    wxString _filename;
+    wxLongLong _startMS = 0;
+    std::vector<uint8_t> _writeBuffer;
+    wxFileOffset _flushed = 0; // bytes already in the file
+    std::vector<uint8_t> _readBuffer;
+    wxFileOffset _readStart = 0; // file offset of the first byte in the read buffer
+    uint64_t _rawBytes = 0;
+    uint64_t _packets = 0;
+
+    bool Open()
+    {
+        static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        _filename = wxFileName::CreateTempFileName("xCapture");
+        if (_filename == "" || !_file.Open(_filename, wxFile::read_write))
+        {
+            logger_base.error("Unable to create capture file %s.", (const char*)_filename.c_str());
+            return false;
+        }
+        logger_base.debug("Capturing to %s.", (const char*)_filename.c_str());
+        _startMS = wxGetUTCTimeMillis();
+        _writeBuffer.reserve(WRITE_BUFFER_SIZE);
+        return true;
+    }
+
+    void Flush()
+    {
+        if (_writeBuffer.size() == 0) return;
+        _file.Seek(_flushed);
+        _file.Write(_writeBuffer.data(), _writeBuffer.size());
+        _flushed += _writeBuffer.size();
+        _writeBuffer.clear();
+    }
+
+    // returns the encoded size or -1 if it would not be smaller than the input ... so out never needs
+    // to be bigger than the input
+    static int RLEEncode(const uint8_t* in, int length, uint8_t* out)
+    {
+        // control byte < 0x80 is followed by that many + 1 bytes to copy
+        // control byte >= 0x80 is followed by one byte repeated control - 0x7E times
+        int o = 0;
+        int i = 0;
+        while (i < length)
+        {
+            int run = 1;
+            while (i + run < length && run < 129 && in[i + run] == in[i]) run++;
+
+            if (run >= 3)
+            {
+                if (o + 2 >= length) return -1;
+                out[o++] = (uint8_t)(0x7E + run);
+                out[o++] = in[i];
+                i += run;
+            }
+            else
+            {
+                int start = i;
+                int count = 0;
+                while (i < length && count < 128)
+                {
+                    if (i + 2 < length && in[i] == in[i + 1] && in[i] == in[i + 2]) break;
+                    i++;
+                    count++;
+                }
+                if (o + 1 + count >= length) return -1;
+                out[o++] = (uint8_t)(count - 1);
+                memcpy(out + o, in + start, count);
+                o += count;
+            }
+        }
+        return o;
+    }
+
+    static bool RLEDecode(const uint8_t* in, int storedLength, uint8_t* out, int length)
+    {
+        int o = 0;
+        int i = 0;
+        while (i < storedLength)
+        {
+            uint8_t c = in[i++];
+            if (c < 0x80)
+            {
+                int count = c + 1;
+                if (o + count > length || i + count > storedLength) return false;
+                memcpy(out + o, in + i, count);
+                i += count;
+                o += count;
+            }
+            else
+            {
+                int count = c - 0x7E;
+                if (o + count > length || i >= storedLength) return false;
+                memset(out + o, in[i++], count);
+                o += count;
+            }
+        }
+        return o == length;
+    }
+
+    const uint8_t* ReadBytes(wxFileOffset offset, size_t size)
+    {
+        if (offset + (wxFileOffset)size > _flushed) Flush();
+
+        // saving reads frame by frame which is close to the order the packets were written so
+        // read ahead in big blocks rather than one packet at a time
+        if (offset < _readStart || offset + (wxFileOffset)size > _readStart + (wxFileOffset)_readBuffer.size())
+        {
+            size_t toRead = std::max(size, (size_t)std::min((wxFileOffset)READ_BUFFER_SIZE, _flushed - offset));
+            _readBuffer.resize(toRead);
+            _file.Seek(offset);
+            if (_file.Read(_readBuffer.data(), toRead) != (ssize_t)toRead)
+            {
+                _readBuffer.clear();
+                return nullptr;
+            }
+            _readStart = offset;
+        }
+        return _readBuffer.data() + (offset - _readStart);
+    }
+
+public:
+
+    CaptureLog() {}
+    CaptureLog(const CaptureLog&) = delete;
+    CaptureLog& operator=(const CaptureLog&) = delete;
+    virtual ~CaptureLog() { Close(); }
+
+    // deletes the file and everything captured into it
+    void Close()
+    {
+        if (_file.IsOpened())
+        {
+            _file.Close();
+            wxRemoveFile(_filename);
+        }
+        _writeBuffer.clear();
+        _readBuffer.clear();
+        _flushed = 0;
+        _readStart = 0;
+        _rawBytes = 0;
+        _packets = 0;
+    }
+
+    bool IsOpen() const { return _file.IsOpened(); }
+    uint64_t GetPackets() const { return _packets; }
+    uint64_t GetRawBytes() const { return _rawBytes; }
+    wxFileOffset GetSize() const { return _flushed + _writeBuffer.size(); }
+
+    // Appends a packet. previous is the last packet written for this universe or nullptr to write a
+    // keyframe. Returns the offset of the record or -1 if it could not be written.
+    wxFileOffset Write(int universe, uint8_t protocol, uint8_t seq, const uint8_t* data, int length, const uint8_t* previous)
+    {
+        if (!_file.IsOpened() && !Open()) return -1;
+
+        if (length < 0) length = 0;
+        if (length > 512) length = 512;
+
+        uint8_t delta[512];
+        const uint8_t* source = data;
+        uint8_t encoding = 0;
+        if (previous != nullptr)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                delta[i] = data[i] ^ previous[i];
+            }
+            source = delta;
+            encoding |= ENCODING_DELTA;
+        }
+
+        wxFileOffset offset = GetSize();
+        if (_writeBuffer.size() + RECORD_HEADER_SIZE + MAX_STORED_SIZE > WRITE_BUFFER_SIZE) Flush();
+
+        size_t start = _writeBuffer.size();
+        _writeBuffer.resize(start + RECORD_HEADER_SIZE + MAX_STORED_SIZE);
+        uint8_t* p = _writeBuffer.data() + start;
+
+        int stored = RLEEncode(source, length, p + RECORD_HEADER_SIZE);
+        if (stored < 0)
+        {
+            memcpy(p + RECORD_HEADER_SIZE, source, length);
+            stored = length;
+        }
+        else
+        {
+            encoding |= ENCODING_RLE;
+        }
+
+        uint32_t ms = (uint32_t)(wxGetUTCTimeMillis() - _startMS).GetLo();
+        p[0] = (uint8_t)(ms & 0xFF);
+        p[1] = (uint8_t)((ms >> 8) & 0xFF);
+        p[2] = (uint8_t)((ms >> 16) & 0xFF);
+        p[3] = (uint8_t)((ms >> 24) & 0xFF);
+        p[4] = (uint8_t)(universe & 0xFF);
+        p[5] = (uint8_t)((universe >> 8) & 0xFF);
+        p[6] = protocol;
+        p[7] = seq;
+        p[8] = (uint8_t)(length & 0xFF);
+        p[9] = (uint8_t)((length >> 8) & 0xFF);
+        p[10] = encoding;
+        p[11] = (uint8_t)(stored & 0xFF);
+        p[12] = (uint8_t)((stored >> 8) & 0xFF);
+        _writeBuffer.resize(start + RECORD_HEADER_SIZE + stored);
+
+        _rawBytes += length;
+        _packets++;
+        return offset;
+    }
+
+    // Decodes the record at offset into data. For delta records data must hold the previous packet
+    // for the universe.
+    bool Read(wxFileOffset offset, uint8_t* data, int length)
+    {
+        const uint8_t* p = ReadBytes(offset, RECORD_HEADER_SIZE);
+        if (p == nullptr) return false;
+        int recordLength = (int)p[8] + ((int)p[9] << 8);
+        uint8_t encoding = p[10];
+        int stored = (int)p[11] + ((int)p[12] << 8);
+        if (recordLength != length || stored > MAX_STORED_SIZE) return false;
+
+        p = ReadBytes(offset + RECORD_HEADER_SIZE, stored);
+        if (p == nullptr) return false;
+
+        uint8_t decoded[512];
+        if (encoding & ENCODING_RLE)
+        {
+            if (!RLEDecode(p, stored, decoded, length)) return false;
+        }
+        else
+        {
+            if (stored != length) return false;
+            memcpy(decoded, p, length);
+        }
+
+        if (encoding & ENCODING_DELTA)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                data[i] ^= decoded[i];
+            }
+        }
+        else
+        {
+            memcpy(data, decoded, length);
+        }
+        return true;
+    }
+};
@@ -13,6 +13,7 @@
 
 #include "xCaptureMain.h"
 #include <wx/msgdlg.h>
+#include <algorithm>
 #include <wx/config.h>
 #include <log4cpp/Category.hh>
 #include <wx/file.h>
@@ -120,6 +121,8 @@ void xCaptureFrame::PurgeCollectedData()
         _capturedData.pop_front();
         delete toDelete;
     }
+    _collectorLookup.clear();
+    _captureLog.Close();
 }
 
 void xCaptureFrame::StashPacket(long type, wxByte* packet, int len)
@@ -162,14 +165,12 @@ void xCaptureFrame::StashPacket(long type, wxByte* packet, int len)
 
     if (!_capturing) return;
 
-    for (auto it = _capturedData.begin(); it != _capturedData.end(); ++it)
+    auto found = _collectorLookup.find(GetCollectorKey(type, universe));
+    if (found != _collectorLookup.end())
     {
-        if ((*it)->_protocol == type && (*it)->_universe == universe)
-        {
-            _capturedPackets++;
-            (*it)->AddPacket(type, packet, len);
-            return;
-        }
+        _capturedPackets++;
+        found->second->AddPacket(type, packet, len, _captureLog);
+        return;
     }
 
     // Doing thise here means we only need to check the list when it isnt already captured
@@ -177,7 +178,8 @@ void xCaptureFrame::StashPacket(long type, wxByte* packet, int len)
 
     Collector* c = new Collector(type, universe);
     _capturedData.push_back(c);
-    c->AddPacket(type, packet, len);
+    _collectorLookup[GetCollectorKey(type, universe)] = c;
+    c->AddPacket(type, packet, len, _captureLog);
     _capturedPackets++;
 }
 
@@ -218,10 +220,10 @@ int xCaptureFrame::GuessFrameMS()
         }
         else
         {
-            totalgap += ((*it)->_timeStamp - last).GetValue().ToDouble();
+            totalgap += (it->_timeStamp - last).GetValue().ToDouble();
             count++;
         }
-        last = (*it)->_timeStamp;
+        last = it->_timeStamp;
     }
     logger_base.debug("Guessing frame time. Total time %fms. Intervals %d, Average Frame %fms, Estimate %dms",
         totalgap,
@@ -590,14 +592,16 @@ void xCaptureFrame::OnAbout(wxCommandEvent& event)
     wxMessageBox(about, _("Welcome to..."));
 }
 
-PacketData::PacketData(long type, wxByte* packet, int len)
+PacketData::PacketData(long type, wxByte* packet, int len, wxByte*& payload)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     _timeStamp = wxDateTime::UNow();
     _frameTimeMS = -1;
     _seq = 0;
     _length = 0;
-    _pdata = nullptr;
+    _offset = -1;
+    _keyframe = true;
+    payload = nullptr;
 
     if (type == xCaptureFrame::ID_E131SOCKET)
     {
@@ -621,8 +625,8 @@ PacketData::PacketData(long type, wxByte* packet, int len)
             logger_base.warn("    Packet looks unlikely to be valid.");
             _length = len - 126;
         }
-        _pdata = (wxByte*)malloc(_length);
-        memcpy(_pdata, &packet[126], _length);
+        _length = std::max(0, std::min(512, _length));
+        payload = &packet[126];
     }
     else if (type == xCaptureFrame::ID_ARTNETSOCKET)
     {
@@ -645,19 +649,25 @@ PacketData::PacketData(long type, wxByte* packet, int len)
             logger_base.warn("    Packet looks unlikely to be valid.");
             _length = len - 18;
         }
-        _pdata = (wxByte*)malloc(_length);
-        memcpy(_pdata, &packet[18], _length);
+        _length = std::max(0, std::min(512, _length));
+        payload = &packet[18];
     }
 }
 
-Collector::~Collector()
+void Collector::AddPacket(long type, wxByte* packet, int len, CaptureLog& log)
 {
-    while (_packets.size() > 0)
-    {
-        auto toDelete = _packets.front();
-        _packets.pop_front();
-        delete toDelete;
-    }
+    wxByte* payload = nullptr;
+    PacketData p(type, packet, len, payload);
+
+    // a difference only works against a packet of the same size
+    p._keyframe = _sinceKeyframe == 0 || (int)_last.size() != p._length;
+    p._offset = log.Write(_universe, _protocol == xCaptureFrame::ID_E131SOCKET ? 0 : 1, (uint8_t)p._seq, payload, p._length, p._keyframe ? nullptr : _last.data());
+    if (p._offset < 0) return;
+
+    _last.assign(payload, payload + p._length);
+    _sinceKeyframe = p._keyframe ? 1 : _sinceKeyframe + 1;
+    if (_sinceKeyframe >= CaptureLog::KEYFRAME_INTERVAL) _sinceKeyframe = 0;
+    _packets.push_back(p);
 }
 
 // relies on missing sequence numbers to detect missing frames
@@ -672,9 +682,9 @@ void Collector::CalculateFrames(wxDateTime startTime, int frameMS)
     // rebase the start time to the start time in this universe if possible
     if (_packets.size() > 0)
     {
-        double rawFrameMS = (_packets.front()->_timeStamp - startTime).GetValue().ToDouble();
+        double rawFrameMS = (_packets.front()._timeStamp - startTime).GetValue().ToDouble();
         ms = ((int)(rawFrameMS / frameMS)) * frameMS;
-        lastseq = _packets.front()->_seq - 1;
+        lastseq = _packets.front()._seq - 1;
         if (lastseq < 0) lastseq = 255;
     }
 
@@ -684,14 +694,14 @@ void Collector::CalculateFrames(wxDateTime startTime, int frameMS)
         lastseq += 1;
         if (lastseq > 255) lastseq = 0;
 
-        if (lastseq != (*it)->_seq)
+        if (lastseq != it->_seq)
         {
             // a frame is missing
             // check it is only one
             auto next = it;
             ++next;
 
-            if (next != _packets.end() && (*next)->_seq == lastseq)
+            if (next != _packets.end() && next->_seq == lastseq)
             {
                 logger_base.warn("Universe %d missing one packet sequence lastSeq %d", _universe, lastseq);
                 // only one frame was missing so assume it was lost
@@ -705,29 +715,57 @@ void Collector::CalculateFrames(wxDateTime startTime, int frameMS)
                 {
                     logger_base.warn("Universe %d missing multiple packets from sequence %d", _universe, lastseq);
                 }
-                lastseq = (*it)->_seq;
+                lastseq = it->_seq;
             }
         }
-        (*it)->_frameTimeMS = ms;
+        it->_frameTimeMS = ms;
         ms += frameMS;
         first = false;
     }
 }
 
+// the packets frame times only ever go up so we can binary search them
 PacketData* Collector::GetPacket(long ms)
 {
-    auto it = _packets.begin();
-    while (it != _packets.end() && ms > (*it)->_frameTimeMS)
+    auto it = std::lower_bound(_packets.begin(), _packets.end(), ms, [](const PacketData& p, long ms) { return p._frameTimeMS < ms; });
+
+    if (it != _packets.end() && ms == it->_frameTimeMS)
     {
-        ++it;
+        return &(*it);
     }
 
-    if (it != _packets.end() && ms == (*it)->_frameTimeMS)
+    return nullptr;
+}
+
+// Returns the packet data for the frame or nullptr if there is none. The data is only good until the
+// next call.
+const wxByte* Collector::ReadPacket(long ms, CaptureLog& log, int& length)
+{
+    PacketData* p = GetPacket(ms);
+    if (p == nullptr) return nullptr;
+
+    // differences have to be applied in order from the last keyframe but as saving asks for the
+    // packets in order this is normally just the next one
+    int index = p - _packets.data();
+    int from = index;
+    while (from > 0 && !_packets[from]._keyframe) from--;
+    if (_decodedIndex >= from && _decodedIndex <= index) from = _decodedIndex + 1;
+
+    for (int i = from; i <= index; i++)
     {
-        return (*it);
+        _decoded.resize(_packets[i]._length);
+        if (!log.Read(_packets[i]._offset, _decoded.data(), _packets[i]._length))
+        {
+            static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+            logger_base.error("Universe %d packet %d could not be read back from the capture file.", _universe, i);
+            _decodedIndex = -1;
+            return nullptr;
+        }
+        _decodedIndex = i;
     }
 
-    return nullptr;
+    length = p->_length;
+    return _decoded.data();
 }
 
 bool Collector::operator<(const Collector& c) const
@@ -1074,13 +1112,14 @@ void xCaptureFrame::OnButton_StartStopClick(wxCommandEvent& event)
         Button_StartStop->SetLabel("Start");
         UpdateCaptureDesc();
 
-        logger_base.debug("Capture stopped.");
+        logger_base.debug("Capture stopped. %llu packets, %llu bytes of channel data stored in %lld bytes.",
+            (unsigned long long)_captureLog.GetPackets(), (unsigned long long)_captureLog.GetRawBytes(), (long long)_captureLog.GetSize());
         for (auto it = _capturedData.begin(); it != _capturedData.end(); ++it)
         {
             logger_base.debug("    Protocol %s, Universe %d, Size %d, Frames %d",
                 (*it)->_protocol == ID_E131SOCKET ? "E131" : "ArtNET",
                 (*it)->_universe,
-                (*it)->_packets.size() > 0 ? (*it)->_packets.front()->_length : 0,
+                (*it)->_packets.size() > 0 ? (*it)->_packets.front()._length : 0,
                 (int)(*it)->_packets.size()
             );
         }
@@ -1135,9 +1174,9 @@ void xCaptureFrame::OnButton_SaveClick(wxCommandEvent& event)
 
             log += wxString::Format("Channel %ld, Protocol %s, Universe %d, Size %d, Frames %d, StartFrameMS %dms, EndFrameMS %dms\n",
                 (*it)->_startChannel, (*it)->_protocol == ID_E131SOCKET ? "E131" : "ArtNET",
-                (*it)->_universe, (*it)->_packets.size() > 0 ? (*it)->_packets.front()->_length : 0,
-                (int)(*it)->_packets.size(), (*it)->_packets.size() > 0 ? (*it)->_packets.front()->_frameTimeMS : -1,
-                (*it)->_packets.size() > 0 ? (*it)->_packets.back()->_frameTimeMS : -1);
+                (*it)->_universe, (*it)->_packets.size() > 0 ? (*it)->_packets.front()._length : 0,
+                (int)(*it)->_packets.size(), (*it)->_packets.size() > 0 ? (*it)->_packets.front()._frameTimeMS : -1,
+                (*it)->_packets.size() > 0 ? (*it)->_packets.back()._frameTimeMS : -1);
         }
         log += wxString::Format("Channel Structure End!\n");
 
@@ -1165,7 +1204,7 @@ long xCaptureFrame::GetChannelsPerFrame()
         (*it)->_startChannel = size + 1;
         if ((*it)->_packets.size() > 0)
         {
-            size += (*it)->_packets.front()->_length;
+            size += (*it)->_packets.front()._length;
         }
     }
 
@@ -1179,9 +1218,9 @@ wxDateTime xCaptureFrame::GetStartTime()
     {
         if ((*it)->_packets.size() > 0)
         {
-            if ((*it)->_packets.front()->_timeStamp < startTime)
+            if ((*it)->_packets.front()._timeStamp < startTime)
             {
-                startTime = (*it)->_packets.front()->_timeStamp;
+                startTime = (*it)->_packets.front()._timeStamp;
             }
         }
     }
@@ -1431,10 +1470,11 @@ void xCaptureFrame::SaveFSEQ(wxString file, int frameMS, long channelsPerFrame,
         {
             for (auto it = _capturedData.begin(); it != _capturedData.end(); ++it)
             {
-                PacketData* p = (*it)->GetPacket(i * frameMS);
-                if (p != nullptr)
+                int length = 0;
+                const wxByte* data = (*it)->ReadPacket(i * frameMS, _captureLog, length);
+                if (data != nullptr)
                 {
-                    memcpy(buf + (*it)->_startChannel - 1, p->_pdata, p->_length);
+                    memcpy(buf + (*it)->_startChannel - 1, data, length);
                 }
                 else
                 {
@@ -1551,11 +1591,11 @@ void xCaptureFrame::SaveESEQ(wxString file, int frameMS, long channelsPerFrame,
             //logger_base.debug("Writing frame %d %dms", i + 1, i * frameMS);
             for (auto it = _capturedData.begin(); it != _capturedData.end(); ++it)
             {
-                PacketData* p = (*it)->GetPacket(i * frameMS);
-                if (p != nullptr)
+                int length = 0;
+                const wxByte* data = (*it)->ReadPacket(i * frameMS, _captureLog, length);
+                if (data != nullptr)
                 {
-                    //logger_base.debug("   Adding data uni %d ch %ld time %dms len %d seq %d time %d.%03d", (*it)->_universe, (*it)->_startChannel, p->_frameTimeMS, p->_length, p->_seq, p->_timeStamp.GetSecond(), p->_timeStamp.GetMillisecond());
-                    memcpy(buf + (*it)->_startChannel - 1, p->_pdata, p->_length);
+                    memcpy(buf + (*it)->_startChannel - 1, data, length);
                 }
                 else
                 {
@@ -1606,9 +1646,9 @@ void xCaptureFrame::OnButton_AnalyseClick(wxCommandEvent& event)
 
         log += wxString::Format("Channel %ld, Protocol %s, Universe %d, Size %d, Frames %d, StartFrameMS %dms, EndFrameMS %dms\n",
             (*it)->_startChannel, (*it)->_protocol == ID_E131SOCKET ? "E131" : "ArtNET",
-            (*it)->_universe, (*it)->_packets.size() > 0 ? (*it)->_packets.front()->_length : 0,
-            (int)(*it)->_packets.size(), (*it)->_packets.size() > 0 ? (*it)->_packets.front()->_frameTimeMS : -1,
-            (*it)->_packets.size() > 0 ? (*it)->_packets.back()->_frameTimeMS : -1);
+            (*it)->_universe, (*it)->_packets.size() > 0 ? (*it)->_packets.front()._length : 0,
+            (int)(*it)->_packets.size(), (*it)->_packets.size() > 0 ? (*it)->_packets.front()._frameTimeMS : -1,
+            (*it)->_packets.size() > 0 ? (*it)->_packets.back()._frameTimeMS : -1);
     }
     log += wxString::Format("Channel Structure End!\n");
 
@@ -37,22 +37,26 @@
 //*)
 
 #include "../xLights/xLightsTimer.h"
+#include "CaptureLog.h"
 #include <list>
+#include <vector>
+#include <unordered_map>
 #include <wx/socket.h>
 
 class wxDebugReportCompress;
 class wxDatagramSocket;
 
+// The index entry for a captured packet ... the data itself is in the capture log
 class PacketData
 {
 public:
     wxDateTime _timeStamp;
     int _seq;
     int _length;
-    wxByte* _pdata;
     int _frameTimeMS;
-    virtual ~PacketData() { if (_pdata != nullptr) free(_pdata); }
-    PacketData(long type, wxByte* packet, int len);
+    wxFileOffset _offset; // where the packet is in the capture log
+    bool _keyframe; // stored in full rather than as a difference from the packet before
+    PacketData(long type, wxByte* packet, int len, wxByte*& payload);
 };
 
 class Collector
@@ -61,12 +65,17 @@ public:
     int _universe;
     long _protocol;
     long _startChannel; // 1 based start channel
-    std::list<PacketData*> _packets;
-    virtual ~Collector();
+    std::vector<PacketData> _packets;
+    std::vector<wxByte> _last; // the last packet written to the log
+    int _sinceKeyframe = 0;
+    std::vector<wxByte> _decoded; // the last packet read back from the log
+    int _decodedIndex = -1;
+    virtual ~Collector() {}
     Collector(long type, int universe) { _startChannel = -1; _universe = universe; _protocol = type; }
-    void AddPacket(long type, wxByte* packet, int len) { _packets.push_back(new PacketData(type, packet, len)); }
+    void AddPacket(long type, wxByte* packet, int len, CaptureLog& log);
     void CalculateFrames(wxDateTime startTime, int frameMS);
     PacketData* GetPacket(long ms);
+    const wxByte* ReadPacket(long ms, CaptureLog& log, int& length);
     bool operator<(const Collector& c) const;
 };
 
@@ -75,6 +84,8 @@ class xCaptureFrame : public wxFrame
     void ValidateWindow();
 
     std::list<Collector*> _capturedData;
+    std::unordered_map<long, Collector*> _collectorLookup; // keyed on GetCollectorKey
+    CaptureLog _captureLog;
     wxDatagramSocket* _e131Socket;
     wxDatagramSocket* _artNETSocket;
     bool _capturing;
@@ -90,6 +101,7 @@ class xCaptureFrame : public wxFrame
     void AddUniverseRange(int low, int high);
     void PurgeCollectedData();
     void StashPacket(long type, wxByte* packet, int len);
+    static long GetCollectorKey(long type, int universe) { return ((long)universe << 1) + (type == ID_E131SOCKET ? 0 : 1); }
     bool IsUniverseToBeCaptured(int universe, bool ignoreall = false);
     int GuessFrameMS();
     long GetChannelsPerFrame();
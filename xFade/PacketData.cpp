@@ -2,6 +2,10 @@
 
 #include <wx/socket.h>
 
+#ifdef XFADE_SIMD
+#include <emmintrin.h>
+#endif
+
 PacketData::PacketData()
 {
     memset(_data, 0x00, sizeof(_data));
@@ -62,8 +66,10 @@ void PacketData::SetData(int c, uint8_t dd)
     }
 }
 
-bool PacketData::Update(long type, uint8_t packet[], int len)
+bool PacketData::Update(long type, uint8_t packet[], int len, bool* copied)
 {
+    if (copied != nullptr) *copied = false;
+
     if (type == E131PORT)
     {
         // validate the packet
@@ -78,11 +84,12 @@ bool PacketData::Update(long type, uint8_t packet[], int len)
         if (packet[11] != 0x31) return false;
         if (packet[12] != 0x37) return false;
 
-        _universe = ((int)_data[113] << 8) + (int)_data[114];
+        _universe = ((int)packet[113] << 8) + (int)packet[114];
         _type = type;
         _length = len;
         wxASSERT(_length >= E131_PACKET_HEADERLEN && _length <= E131_PACKET_HEADERLEN + 512);
         memcpy(_data, packet, len);
+        if (copied != nullptr) *copied = true;
     }
     else if (type == ARTNETPORT)
     {
@@ -97,11 +104,12 @@ bool PacketData::Update(long type, uint8_t packet[], int len)
         if (packet[6] != 't') return false;
         if (packet[9] != 0x50) return true; // pretend success as otherwise I will log excessively
 
-        _universe = ((int)_data[15] << 8) + (int)_data[14];
+        _universe = ((int)packet[15] << 8) + (int)packet[14];
         _type = type;
         _length = len;
         wxASSERT(_length >= ARTNET_PACKET_HEADERLEN && _length <= ARTNET_PACKET_HEADERLEN + 512);
         memcpy(_data, packet, len);
+        if (copied != nullptr) *copied = true;
     }
 
     return true;
@@ -150,12 +158,6 @@ int PacketData::GetDataLength() const
     return 0;
 }
 
-int PacketData::GetNextSequenceNum(int u)
-{
-    _sequenceNum[u] = _sequenceNum[u] >= 255 ? 0 : _sequenceNum[u] + 1;
-    return _sequenceNum[u];
-}
-
 void PacketData::InitialiseArtNETHeader()
 {
     memset(_data, 0x00, sizeof(_data));
@@ -289,39 +291,60 @@ void PacketData::InitialiseLength(long type, int length, int universe)
     }
 }
 
-void PacketData::ApplyBrightness(int brightness, const std::list<int>& excludeChannels)
+// excluded is one byte per channel, 0xFF for channels brightness must not touch, or nullptr if there are none
+void PacketData::ApplyBrightness(int brightness, const uint8_t* excluded)
 {
     if (brightness == 100) return;
 
-    if (excludeChannels.size() == 0)
+    uint8_t* p = GetDataPtr();
+    int channels = GetDataLength();
+
+    if (excluded == nullptr && brightness == 0)
     {
-        if (brightness == 0)
-        {
-            memset(GetDataPtr(), 0x00, GetDataLength());
-        }
-        else
+        memset(p, 0x00, channels);
+        return;
+    }
+
+    // x * brightness / 100 is done as (x * brightness * 5243) >> 19 which gives exactly the same
+    // answer for anything up to 255 * 100 and lets the SIMD loop stay in 16 bits
+    int i = 0;
+#ifdef XFADE_SIMD
+    __m128i zero = _mm_setzero_si128();
+    __m128i b = _mm_set1_epi16((short)brightness);
+    __m128i div = _mm_set1_epi16(5243);
+    for (; i + XFADE_SIMD_WIDTH <= channels; i += XFADE_SIMD_WIDTH)
+    {
+        __m128i v = _mm_loadu_si128((__m128i*)(p + i));
+        __m128i lo = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), b), div), 3);
+        __m128i hi = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), b), div), 3);
+        __m128i r = _mm_packus_epi16(lo, hi);
+        if (excluded != nullptr)
         {
-            uint8_t* p = GetDataPtr();
-            for (int i = 0; i < GetDataLength(); i++)
-            {
-                *(p + i) = (uint8_t)((int)*(p + i) * brightness / 100);
-            }
+            __m128i mask = _mm_loadu_si128((__m128i*)(excluded + i));
+            r = _mm_or_si128(_mm_and_si128(mask, v), _mm_andnot_si128(mask, r));
         }
+        _mm_storeu_si128((__m128i*)(p + i), r);
     }
-    else
+#endif
+    for (; i < channels; i++)
     {
-        uint8_t* p = GetDataPtr();
-        for (int i = 0; i < GetDataLength(); i++)
+        if (excluded == nullptr || excluded[i] == 0)
         {
-            if (std::find(excludeChannels.begin(), excludeChannels.end(), i + 1) == excludeChannels.end())
-            {
-                *(p + i) = (uint8_t)((int)*(p + i) * brightness / 100);
-            }
+            *(p + i) = (uint8_t)(((uint32_t)*(p + i) * brightness * 5243) >> 19);
         }
     }
 }
 
-void PacketData::CopyFrom(PacketData* source, long targetType)
+// copies just the packet itself ... not the tag
+void PacketData::CopyFrame(const PacketData& source)
+{
+    _type = source._type;
+    _universe = source._universe;
+    _length = source._length;
+    memcpy(_data, source._data, _length);
+}
+
+void PacketData::CopyFrom(PacketData* source, long targetType, uint8_t sequenceNum)
 {
     wxASSERT(source != nullptr);
     _length = 0;
@@ -339,13 +362,13 @@ void PacketData::CopyFrom(PacketData* source, long targetType)
             wxASSERT(_length >= E131_PACKET_HEADERLEN && _length <= E131_PACKET_HEADERLEN + 512);
             memset(&_data[44], 0x00, 64);
             strncpy((char*)&_data[44], _tag.c_str(), 64);
-            _data[111] = GetNextSequenceNum(_universe);
+            _data[111] = sequenceNum;
         }
         else if (_type == ARTNETPORT)
         {
             wxASSERT(_length >= ARTNET_PACKET_HEADERLEN && _length <= ARTNET_PACKET_HEADERLEN + 512);
             // nothing to do
-            _data[12] = GetNextSequenceNum(_universe);
+            _data[12] = sequenceNum;
         }
     }
     else
@@ -355,18 +378,18 @@ void PacketData::CopyFrom(PacketData* source, long targetType)
             // converting from ARTNET
             _length = E131_PACKET_HEADERLEN + source->GetDataLength();
             InitialiseE131Header();
-            memcpy(source->GetDataPtr(), GetDataPtr(), GetDataLength());
+            memcpy(GetDataPtr(), source->GetDataPtr(), GetDataLength());
             memset(&_data[44], 0x00, 64);
             strncpy((char*)&_data[44], _tag.c_str(), 64);
-            _data[111] = GetNextSequenceNum(_universe);
+            _data[111] = sequenceNum;
         }
         else if (_type == ARTNETPORT)
         {
             // converting from E131
             _length = ARTNET_PACKET_HEADERLEN + source->GetDataLength();
             InitialiseArtNETHeader();
-            memcpy(source->GetDataPtr(), GetDataPtr(), GetDataLength());
-            _data[12] = GetNextSequenceNum(_universe);
+            memcpy(GetDataPtr(), source->GetDataPtr(), GetDataLength());
+            _data[12] = sequenceNum;
         }
     }
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define PACKETDATA_H
 
 #include <wx/wx.h>
-#include <map>
+#include <atomic>
 
 #define ZERO 0
 #define E131PORT 5568
@@ -13,6 +13,12 @@
 #define E131_PACKET_HEADERLEN 126
 #define E131_PACKET_LEN (E131_PACKET_HEADERLEN + 512)
 
+// SSE2 is always there on x64 so the per channel loops can work on 16 channels at a time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XFADE_SIMD
+#define XFADE_SIMD_WIDTH 16
+#endif
+
 class wxDatagramSocket;
 
 class PacketData
@@ -22,7 +28,6 @@ public:
     long _type = 0;
     int _universe = 0;
     int _length = 0;
-    std::map<int, int> _sequenceNum;
     std::string _tag = "";
 
     virtual ~PacketData() { }
@@ -30,18 +35,67 @@ public:
     uint8_t GetData(int c);
     uint8_t* GetDataPtr();
     void SetData(int c, uint8_t dd);
-    bool Update(long type, uint8_t packet[], int len);
+    bool Update(long type, uint8_t packet[], int len, bool* copied = nullptr);
     void Send(wxDatagramSocket* e131Socket, wxDatagramSocket* artNETSocket, const std::string& ip) const;
     int GetDataLength() const;
     uint8_t UniverseHigh() const { return (_universe >> 8) & 0xFF; }
     uint8_t UniverseLow() const { return _universe & 0xFF; }
-    void CopyFrom(PacketData* source, long targetType);
-    int GetNextSequenceNum(int u);
+    void CopyFrom(PacketData* source, long targetType, uint8_t sequenceNum);
+    void CopyFrame(const PacketData& source);
     void InitialiseArtNETHeader();
     void InitialiseE131Header();
     int GetSequenceNum() const;
     void InitialiseLength(long type, int length, int universe);
-    void ApplyBrightness(int brightness, const std::list<int>& excludeChannels);
+    void ApplyBrightness(int brightness, const uint8_t* excluded);
+};
+
+// Holds the most recent packet received for one side of a universe. The receiver writes into a spare
+// buffer and swaps it in, the emitter swaps out whatever is newest when it wants a frame, so neither
+// ever waits on the other and a packet that arrives between two emitter frames simply replaces the
+// one before it.
+class LatestPacket
+{
+    static const uint8_t NEW = 0x80; // set on _middle when it holds a packet the reader has not taken
+    static const uint8_t INDEX = 0x03;
+
+    PacketData _buffers[3];
+    std::atomic<uint8_t> _middle;
+    uint8_t _write = 0; // only touched by the receiver
+    uint8_t _read = 1; // only touched by the emitter
+    std::atomic_flag _writing = ATOMIC_FLAG_INIT; // E1.31 and ArtNET receivers could both feed the same side
+    std::atomic<int> _sequenceNum;
+
+public:
+
+    LatestPacket() : _middle(2), _sequenceNum(-1) {}
+
+    // receiver side ... returns false if the packet is invalid
+    bool Update(long type, uint8_t packet[], int len)
+    {
+        while (_writing.test_and_set(std::memory_order_acquire)) {}
+        bool copied = false;
+        bool res = _buffers[_write].Update(type, packet, len, &copied);
+        if (copied)
+        {
+            _sequenceNum = _buffers[_write].GetSequenceNum();
+            _write = _middle.exchange(_write | NEW, std::memory_order_acq_rel) & INDEX;
+        }
+        _writing.clear(std::memory_order_release);
+        return res;
+    }
+
+    // sequence number of the last packet received
+    int GetSequenceNum() const { return _sequenceNum; }
+
+    // emitter side ... the packet returned stays put until the next call
+    PacketData& Get()
+    {
+        if (_middle.load(std::memory_order_relaxed) & NEW)
+        {
+            _read = _middle.exchange(_read, std::memory_order_acq_rel) & INDEX;
+        }
+        return _buffers[_read];
+    }
 };
 
 #endif 
@@ -1,13 +1,27 @@
 #include "UniverseData.h"
 
+#ifdef XFADE_SIMD
+#include <emmintrin.h>
+#endif
+
 std::string UniverseData::__leftTag = "";
 std::string UniverseData::__rightTag = "";
 
 UniverseData::UniverseData(int universe, const std::string& targetIP, const std::string& targetProtocol, std::list<int> excludedChannels) :
     _universe(universe),
-    _targetIP(targetIP),
-    _excludedChannels(excludedChannels)
+    _targetIP(targetIP)
 {
+    // turn the list into a per channel mask once rather than searching it for every channel every frame
+    memset(_excluded, 0x00, sizeof(_excluded));
+    for (const auto& it : excludedChannels)
+    {
+        if (it >= 1 && it <= (int)sizeof(_excluded))
+        {
+            _excluded[it - 1] = 0xFF;
+            _hasExcluded = true;
+        }
+    }
+
     if (targetProtocol == "As per input")
     {
         _targetProtocol = 0;
@@ -28,85 +42,108 @@ UniverseData::UniverseData(int universe, const std::string& targetIP, const std:
 
 int UniverseData::GetLeftSequenceNum()
 {
-    std::unique_lock<std::mutex> lock(_lock);
     return _left.GetSequenceNum();
 }
 
 int UniverseData::GetRightSequenceNum()
 {
-    std::unique_lock<std::mutex> lock(_lock);
     return _right.GetSequenceNum();
 }
 
 bool UniverseData::UpdateLeft(int type, uint8_t* buffer, int size)
 {
-    std::unique_lock<std::mutex> lock(_lock);
     return _left.Update(type, buffer, size);
 }
 
 bool UniverseData::UpdateRight(int type, uint8_t* buffer, int size)
 {
-    std::unique_lock<std::mutex> lock(_lock);
     return _right.Update(type, buffer, size);
 }
 
+// only ever called from the emitter thread
 PacketData* UniverseData::GetOutput(PacketData* output, int leftBrightness, int rightBrightness, float pos)
 {
-    std::unique_lock<std::mutex> lock(_lock);
+    PacketData& left = _left.Get();
+    PacketData& right = _right.Get();
 
-    if (_left._length == 0 && _right._length > 0)
+    if (left._length == 0 && right._length > 0)
     {
-        _left.InitialiseLength(_right._type, _right._length, _universe);
+        left.InitialiseLength(right._type, right._length, _universe);
     }
-    else if (_right._length == 0 && _left._length > 0)
+    else if (right._length == 0 && left._length > 0)
     {
-        _right.InitialiseLength(_left._type, _left._length, _universe);
+        right.InitialiseLength(left._type, left._length, _universe);
     }
 
     if (pos == 0.0)
     {
-        PrepareData(output, &_left, _targetProtocol);
-        output->ApplyBrightness(leftBrightness, _excludedChannels);
+        PrepareData(output, &left, _targetProtocol);
+        output->ApplyBrightness(leftBrightness, GetExcluded());
     }
     else if (pos == 1.0)
     {
-        PrepareData(output, &_right, _targetProtocol);
-        output->ApplyBrightness(rightBrightness, _excludedChannels);
+        PrepareData(output, &right, _targetProtocol);
+        output->ApplyBrightness(rightBrightness, GetExcluded());
     }
     else
     {
-        int sz = std::min(_left.GetDataLength(), _right.GetDataLength());
+        int sz = std::min(left.GetDataLength(), right.GetDataLength());
 
-        PacketData l = _left;
-        PacketData r = _right;
-        l.ApplyBrightness(leftBrightness, _excludedChannels);
-        r.ApplyBrightness(rightBrightness, _excludedChannels);
+        _blendLeft.CopyFrame(left);
+        _blendRight.CopyFrame(right);
+        _blendLeft.ApplyBrightness(leftBrightness, GetExcluded());
+        _blendRight.ApplyBrightness(rightBrightness, GetExcluded());
 
-        Blend(l.GetDataPtr(), r.GetDataPtr(), sz, pos, _excludedChannels);
-        PrepareData(output, &l, _targetProtocol);
+        Blend(_blendLeft.GetDataPtr(), _blendRight.GetDataPtr(), sz, pos);
+        PrepareData(output, &_blendLeft, _targetProtocol);
     }
     return output;
 }
 
-void UniverseData::Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos, std::list<int> excludeChannels)
+// Crossfades in 8 bit fixed point: buffer * (256 - w) + blendBuffer * w over 256 where w is pos
+// scaled to 0-256. Excluded channels dont fade, they switch from one side to the other half way.
+void UniverseData::Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos) const
 {
-    float inv = 1.0 - pos;
-    for (size_t i = 0; i < channels; ++i)
+    uint16_t w = (uint16_t)(pos * 256.0f + 0.5f);
+    uint16_t inv = 256 - w;
+    bool takeRight = pos >= 0.5;
+
+    size_t i = 0;
+#ifdef XFADE_SIMD
+    __m128i zero = _mm_setzero_si128();
+    __m128i vw = _mm_set1_epi16((short)w);
+    __m128i vinv = _mm_set1_epi16((short)inv);
+    for (; i + XFADE_SIMD_WIDTH <= channels; i += XFADE_SIMD_WIDTH)
+    {
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
+
+        // the sum is at most 255 * 256 so it fits in 16 bits unsigned
+        __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), vinv), _mm_mullo_epi16(_mm_unpacklo_epi8(bb, zero), vw)), 8);
+        __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), vinv), _mm_mullo_epi16(_mm_unpackhi_epi8(bb, zero), vw)), 8);
+        __m128i r = _mm_packus_epi16(lo, hi);
+
+        if (_hasExcluded)
+        {
+            __m128i mask = _mm_loadu_si128((__m128i*)(_excluded + i));
+            r = _mm_or_si128(_mm_and_si128(mask, takeRight ? bb : b), _mm_andnot_si128(mask, r));
+        }
+
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
+    }
+#endif
+    for (; i < channels; ++i)
     {
-        if (std::find(excludeChannels.begin(), excludeChannels.end(), i + 1) != excludeChannels.end())
+        if (_excluded[i] != 0)
         {
-            if (pos < 0.5)
-            {
-                // dont change anything
-            }
-            else
+            if (takeRight)
             {
                 *(buffer + i) = *(blendBuffer + i);
             }
         }
         else
         {
-            *(buffer + i) = (uint8_t)((float) * (buffer + i) * inv + (float) * (blendBuffer + i) * pos);
+            *(buffer + i) = (uint8_t)(((uint16_t)*(buffer + i) * inv + (uint16_t)*(blendBuffer + i) * w) >> 8);
         }
     }
 }
@@ -116,11 +153,11 @@ void UniverseData::PrepareData(PacketData* target, PacketData* source, int proto
     if (protocol == 0 || source->_type == protocol)
     {
         // no conversion required
-        target->CopyFrom(source, source->_type);
+        target->CopyFrom(source, source->_type, ++_sequenceNum);
     }
     else
     {
         // conversion required
-        target->CopyFrom(source, protocol);
+        target->CopyFrom(source, protocol, ++_sequenceNum);
     }
 }
\ No newline at end of file
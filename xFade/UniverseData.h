@@ -1,6 +1,6 @@
 #pragma once
 
-#include <mutex>
+#include <list>
 
 #include "PacketData.h"
 
@@ -8,14 +8,18 @@ class UniverseData
 {
     int _universe = 0;
     int _targetProtocol = 0;
-    std::mutex _lock;
-    PacketData _left;
-    PacketData _right;
+    LatestPacket _left; // written by the receivers and read by the emitter without locking
+    LatestPacket _right;
+    PacketData _blendLeft; // working copies used while crossfading so nothing is allocated each frame
+    PacketData _blendRight;
     std::string _targetIP;
-    std::list<int> _excludedChannels;
+    uint8_t _excluded[512]; // 0xFF for each channel excluded from fading and brightness
+    bool _hasExcluded = false;
+    uint8_t _sequenceNum = 0;
 
     void PrepareData(PacketData* target, PacketData* source, int protocol);
-    void Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos, std::list<int> excludeChannels);
+    void Blend(uint8_t* buffer, uint8_t* blendBuffer, size_t channels, float pos) const;
+    const uint8_t* GetExcluded() const { return _hasExcluded ? _excluded : nullptr; }
 
 public:
 
@@ -26,7 +30,6 @@ public:
     static void SetLeftTag(const std::string& left) { __leftTag = left; }
     static void SetRightTag(const std::string& right) { __rightTag = right; }
     int GetUniverse() const { return _universe; }
-    std::mutex& GetLock() { return _lock; }
     std::string GetTargetIP() const { return _targetIP; }
     bool UpdateLeft(int type, uint8_t* buffer, int size);
     bool UpdateRight(int type, uint8_t* buffer, int size);
@@ -547,34 +547,26 @@ void CustomModelDialog::Setup(CustomModel* m)
         }
     }
     else {
-        wxArrayString layers = wxSplit(data, '|');
-        for (auto layer = 0; layer < layers.size(); layer++) {
+        CustomModelData cmd;
+        cmd.ParseDense(data);
+        for (auto layer = 0; layer < cmd.depth; layer++) {
             AddPage();
             //ResizeCustomGrid();
             auto grid = GetLayerGrid(layer);
             wxFont font = grid->GetDefaultCellFont();
             grid->SetDefaultRowSize(int(1.5 * (float)font.GetPixelSize().y));
             grid->SetDefaultColSize(2 * font.GetPixelSize().y);
-            wxArrayString rows = wxSplit(layers[layer], ';');
-            //grid->AppendRows(rows.size() - 1);
-
-            for (auto row = 0; row < rows.size(); row++) {
-                wxArrayString cols = wxSplit(rows[row], ',');
-                //if (row == 0) {
-                //    grid->AppendCols(cols.size() - 1);
-                //}
-                for (auto col = 0; col < cols.size(); col++) {
-                    wxString value = cols[col];
-                    if (!value.IsEmpty() && value != "0") {
-                        grid->SetCellValue(row, col, value);
-                    }
-                }
-            }
-
             grid->SetRowMinimalAcceptableHeight(5); //don't need to read text, just see the shape
             grid->SetColMinimalAcceptableWidth(5); //don't need to read text, just see the shape
             grid->SetColLabelSize(int(1.5 * (float)font.GetPixelSize().y));
         }
+
+        for (const auto& it : cmd.cells) {
+            auto grid = GetLayerGrid(it.layer);
+            if (it.row < grid->GetNumberRows() && it.col < grid->GetNumberCols()) {
+                grid->SetCellValue(it.row, it.col, wxString::Format("%d", it.node));
+            }
+        }
     }
 
     UpdateBackground();
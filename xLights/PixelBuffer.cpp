@@ -19,7 +19,9 @@
 #include "xLightsMain.h"
 #include <log4cpp/Category.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <random>
 #include "Parallel.h"
 #include "UtilFunctions.h"
@@ -707,6 +709,7 @@ void PixelBufferClass::reset(int nlayers, int timing, bool isNode)
         delete layers[x];
     }
     layers.clear();
+    colorBlocks.clear();
     frameTimeInMs = timing;
 
     numLayers = nlayers;
@@ -722,6 +725,10 @@ void PixelBufferClass::reset(int nlayers, int timing, bool isNode)
         layers[x]->bufferTransform = "None";
         layers[x]->outTransitionType = "Fade";
         layers[x]->inTransitionType = "Fade";
+        layers[x]->outTransitionMask = 0;
+        layers[x]->inTransitionMask = 0;
+        layers[x]->outTransitionNonMask = false;
+        layers[x]->inTransitionNonMask = false;
         layers[x]->subBuffer = "";
         layers[x]->isChromaKey = false;
         layers[x]->chromaSensitivity = 1;
@@ -1526,37 +1533,38 @@ void PixelBufferClass::GetMixedColor(int x, int y, xlColor& c, const std::vector
 }
 
 //http://blog.ivank.net/fastest-gaussian-blur.html
-static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard deviation, number of boxes
+// returns the radius of each of the 3 box passes that approximate a gaussian of the given size
+static void boxesForGauss(int d, int radii[3])
 {
+    int b = 0;
     switch (d) {
         case 2:
         case 3:
-            boxes.push_back(1.0);
+            b = 1;
             break;
         case 4:
         case 5:
         case 6:
-            boxes.push_back(3.0);
+            b = 3;
             break;
         case 7:
         case 8:
         case 9:
-            boxes.push_back(5.0);
+            b = 5;
             break;
         case 10:
         case 11:
         case 12:
-            boxes.push_back(7.0);
+            b = 7;
             break;
         case 13:
         case 14:
         case 15:
-            boxes.push_back(9.0);
-            break;
         default:
+            b = 9;
             break;
     }
-    float b = boxes.back();
+    radii[0] = (b - 1) / 2;
     switch (d) {
         case 2:
         case 4:
@@ -1567,10 +1575,10 @@ static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard
         case 11:
         case 13:
         case 14:
-            boxes.push_back(b);
+            radii[1] = (b - 1) / 2;
             break;
         default:
-            boxes.push_back(b + 2.0);
+            radii[1] = (b + 1) / 2;
             break;
     }
     switch (d) {
@@ -1578,186 +1586,94 @@ static void boxesForGauss(int d, int n, std::vector<float> &boxes)  // standard
         case 7:
         case 10:
         case 13:
-            boxes.push_back(b);
+            radii[2] = (b - 1) / 2;
             break;
         default:
-            boxes.push_back(b + 2.0);
-    }
-}
-
-#define RED(a, b) a[(b)*4]
-#define GREEN(a, b) a[(b)*4 + 1]
-#define BLUE(a, b) a[(b)*4 + 2]
-#define ALPHA(a, b) a[(b)*4 + 3]
-static inline void SET(std::vector<float>& ar, int idx, float r, float g, float b, float a) {
-    idx *= 4;
-    ar[idx++] = r;
-    ar[idx++] = g;
-    ar[idx++] = b;
-    ar[idx] = a;
-}
-
-static void boxBlurH_4 (const std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r) {
-    float iarr = 1.0f / (r+r+1.0f);
-    for(int i=0; i<h; i++) {
-        int ti = i*w;
-        int li = ti;
-        int ri = ti+r;
-        int maxri = ti + w - 1;
-        int fvIdx = ti;
-        int lvIdx = ti+w-1;
-
-        float valr = (r+1.0) * RED(scl,fvIdx);
-        float valg = (r+1.0) * GREEN(scl,fvIdx);
-        float valb = (r+1.0) * BLUE(scl,fvIdx);
-        float vala = (r+1.0) * ALPHA(scl,fvIdx);
-
-        float fvRed = RED(scl, fvIdx);
-        float fvGreen = GREEN(scl, fvIdx);
-        float fvBlue = BLUE(scl, fvIdx);
-        float fvAlpha = ALPHA(scl, fvIdx);
-        float lvRed = RED(scl, lvIdx);
-        float lvGreen = GREEN(scl, lvIdx);
-        float lvBlue = BLUE(scl, lvIdx);
-        float lvAlpha = ALPHA(scl, lvIdx);
-
-        for (int j=0; j<r; j++) {
-            int idx = j < w ? ti+j : lvIdx;
-            valr += RED(scl, idx);
-            valg += GREEN(scl, idx);
-            valb += BLUE(scl, idx);
-            vala += ALPHA(scl, idx);
-        }
-        for (int j=0  ; j<=r ; j++) {
-            int idx = ri <= maxri ? ri++ : lvIdx;
-            valr += RED(scl, idx) - fvRed;
-            valg += GREEN(scl, idx) - fvGreen;
-            valb += BLUE(scl, idx) - fvBlue;
-            vala += ALPHA(scl, idx) - fvAlpha;
-
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-                ti++;
-            }
+            radii[2] = (b + 1) / 2;
+    }
+}
+
+// The blur planes hold RGBA interleaved as 8.8 fixed point so the three box passes do not lose precision
+// between passes. Each box pass is a clamp to edge sliding window with the 4 channels handled together so
+// the inner loops vectorise.
+#define BLUR_FIXED_SHIFT 8
+#define BLUR_RECIP_SHIFT 16
+#define BLUR_COLUMN_BLOCK 64
+
+static inline uint16_t BlurScale(uint32_t sum, uint64_t recip) {
+    return (uint16_t)((sum * recip + (1 << (BLUR_RECIP_SHIFT - 1))) >> BLUR_RECIP_SHIFT);
+}
+
+static void BoxBlurRow(const uint16_t* src, uint16_t* dst, int w, int r, uint64_t recip) {
+    uint32_t acc[4];
+    for (int c = 0; c < 4; c++) {
+        acc[c] = (r + 1) * src[c];
+    }
+    for (int k = 1; k <= r; k++) {
+        const uint16_t* p = src + std::min(k, w - 1) * 4;
+        for (int c = 0; c < 4; c++) {
+            acc[c] += p[c];
         }
-        for (int j=r+1; j<w-r; j++) {
-            int c = ri <= maxri ? ri++ : lvIdx;
-            int c2 = li <= maxri ? li++ : lvIdx;
-            valr += RED(scl, c) - RED(scl, c2);
-            valg += GREEN(scl, c) - GREEN(scl, c2);
-            valb += BLUE(scl, c) - BLUE(scl, c2);
-            vala += ALPHA(scl, c) - ALPHA(scl, c2);
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-                ti++;
-            }
+    }
+    for (int x = 0; x < w; x++) {
+        for (int c = 0; c < 4; c++) {
+            dst[x * 4 + c] = BlurScale(acc[c], recip);
         }
-
-        for (int j=w-r; j<w  ; j++) {
-            int c2 = li <= maxri ? li++: lvIdx;
-            valr += lvRed - RED(scl, c2);
-            valg += lvGreen - GREEN(scl, c2);
-            valb += lvBlue - BLUE(scl, c2);
-            vala += lvAlpha - ALPHA(scl, c2);
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-                ti++;
-            }
+        const uint16_t* add = src + std::min(x + r + 1, w - 1) * 4;
+        const uint16_t* sub = src + std::max(x - r, 0) * 4;
+        for (int c = 0; c < 4; c++) {
+            acc[c] += add[c] - sub[c];
         }
     }
 }
 
-static void boxBlurT_4 (const std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r) {
-    float iarr = 1.0f / (r+r+1.0f);
-    for(int i=0; i<w; i++) {
-        int ti = i;
-        int li = ti;
-        int ri = ti+r*w;
-
-        int maxri = ti+w*(h-1);
-
-        int fvIdx = ti;
-        int lvIdx = ti+w*(h-1);
-
-        float fvRed = RED(scl, fvIdx);
-        float fvGreen = GREEN(scl, fvIdx);
-        float fvBlue = BLUE(scl, fvIdx);
-        float fvAlpha = ALPHA(scl, fvIdx);
-        float lvRed = RED(scl, lvIdx);
-        float lvGreen = GREEN(scl, lvIdx);
-        float lvBlue = BLUE(scl, lvIdx);
-        float lvAlpha = ALPHA(scl, lvIdx);
-
-        float valr = (r+1)*fvRed;
-        float valg = (r+1)*fvGreen;
-        float valb = (r+1)*fvBlue;
-        float vala = (r+1)*fvAlpha;
-
-        for(int j=0; j<r; j++) {
-            int idx = j < w ? ti+j*w : lvIdx;
-            valr += RED(scl, idx);
-            valg += GREEN(scl, idx);
-            valb += BLUE(scl, idx);
-            vala += ALPHA(scl, idx);
-        }
-        for(int j=0  ; j<=r ; j++) {
-            int idx = ri <= maxri ? ri : lvIdx;
-            valr += RED(scl, idx) - fvRed;
-            valg += GREEN(scl, idx) - fvGreen;
-            valb += BLUE(scl, idx) - fvBlue;
-            vala += ALPHA(scl, idx) - fvAlpha;
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-            }
-            ri+=w;
-            ti+=w;
-        }
-        for(int j=r+1; j<h-r; j++) {
-            int c = ri <= maxri ? ri : lvIdx;
-            int c2 = li <= maxri ? li : lvIdx;
-            valr += RED(scl, c) - RED(scl, c2);
-            valg += GREEN(scl, c) - GREEN(scl, c2);
-            valb += BLUE(scl, c) - BLUE(scl, c2);
-            vala += ALPHA(scl, c) - ALPHA(scl, c2);
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-            }
-            li+=w; ri+=w; ti+=w;
-        }
-        for(int j=h-r; j<h  ; j++) {
-            int c2 = li <= maxri ? li : lvIdx;
-            valr += lvRed - RED(scl, c2);
-            valg += lvGreen - GREEN(scl, c2);
-            valb += lvBlue - BLUE(scl, c2);
-            vala += lvAlpha - ALPHA(scl, c2);
-            if (ti <= maxri) {
-                SET(tcl, ti, valr*iarr, valg*iarr, valb*iarr, vala*iarr);
-            }
-            li += w;
-            ti += w;
+// blurs columns [x0, x1) sweeping down the rows so memory is read a row at a time
+static void BoxBlurColumns(const uint16_t* src, uint16_t* dst, int w, int h, int x0, int x1, int r, uint64_t recip) {
+    uint32_t acc[BLUR_COLUMN_BLOCK * 4];
+    const int stride = w * 4;
+    const int n = (x1 - x0) * 4;
+    const uint16_t* first = src + x0 * 4;
+
+    for (int i = 0; i < n; i++) {
+        acc[i] = (r + 1) * first[i];
+    }
+    for (int k = 1; k <= r; k++) {
+        const uint16_t* p = first + std::min(k, h - 1) * stride;
+        for (int i = 0; i < n; i++) {
+            acc[i] += p[i];
+        }
+    }
+    for (int y = 0; y < h; y++) {
+        uint16_t* out = dst + y * stride + x0 * 4;
+        for (int i = 0; i < n; i++) {
+            out[i] = BlurScale(acc[i], recip);
+        }
+        const uint16_t* add = first + std::min(y + r + 1, h - 1) * stride;
+        const uint16_t* sub = first + std::max(y - r, 0) * stride;
+        for (int i = 0; i < n; i++) {
+            acc[i] += add[i] - sub[i];
         }
     }
 }
 
-static void boxBlur_4(std::vector<float>& scl, std::vector<float>& tcl, int w, int h, float r, int size) {
-    tcl = scl;
-    //memcpy(tcl, scl, sizeof(float)*4*size);
-    boxBlurH_4(tcl, scl, w, h, r);
-    boxBlurT_4(scl, tcl, w, h, r);
-}
+// one horizontal then one vertical box pass. Result ends up back in a, b is scratch
+static void BoxBlur(std::vector<uint16_t>& a, std::vector<uint16_t>& b, int w, int h, int r) {
+    if (r <= 0) {
+        return;
+    }
+    const uint64_t recip = ((1 << BLUR_RECIP_SHIFT) + r) / (2 * r + 1);
+    uint16_t* pa = &a[0];
+    uint16_t* pb = &b[0];
 
-static void gaussBlur_4(std::vector<float>& scl, std::vector<float>& tcl, int w, int h, int r, int size) {
-    std::vector<float> bxs;
-    boxesForGauss(r - 1, 3, bxs);
-    boxBlur_4 (scl, tcl, w, h, (bxs[0]-1)/2, size);
-    boxBlur_4 (tcl, scl, w, h, (bxs[1]-1)/2, size);
-    boxBlur_4 (scl, tcl, w, h, (bxs[2]-1)/2, size);
-}
+    parallel_for(0, h, [pa, pb, w, r, recip](int y) {
+        BoxBlurRow(pa + y * w * 4, pb + y * w * 4, w, r, recip);
+    }, std::max(1, 4096 / w));
 
-static inline int roundInt(float r) {
-    int tmp = static_cast<int> (r);
-    tmp += (r-tmp>=.5) - (r-tmp<=-.5);
-    return tmp;
+    int blocks = (w + BLUR_COLUMN_BLOCK - 1) / BLUR_COLUMN_BLOCK;
+    parallel_for(0, blocks, [pa, pb, w, h, r, recip](int blk) {
+        int x0 = blk * BLUR_COLUMN_BLOCK;
+        BoxBlurColumns(pb, pa, w, h, x0, std::min(x0 + BLUR_COLUMN_BLOCK, w), r, recip);
+    }, std::max(1, 4096 / (h * BLUR_COLUMN_BLOCK)));
 }
 
 void PixelBufferClass::Blur(LayerInfo* layer, float offset)
@@ -1775,34 +1691,47 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
     if (layer->BufferWi == 1 && layer->BufferHt == 1) {
         return;
     }
+
+    // scratch reused across frames by each render thread so blurring does not allocate once warmed up
+    static thread_local std::vector<uint16_t> planeA;
+    static thread_local std::vector<uint16_t> planeB;
+    static thread_local std::vector<xlColor> orig;
+
     if (b < 2) {
         return;
     } else if (b > 2 && layer->BufferWi > 6 && layer->BufferHt > 6) {
-        int os = std::max((int)layer->buffer.pixels.size(), layer->BufferWi * layer->BufferHt);
-        int pixCount = layer->buffer.pixels.size();
-        std::vector<float> input;
-        input.resize(os * 4);
-        std::vector<float> tmp;
-        tmp.resize(os * 4);
-        //float * input = new float[pixCount * 4];
-        //float * tmp = new float[pixCount * 4];
+        const int w = layer->BufferWi;
+        const int h = layer->BufferHt;
+        const int pixCount = std::min((int)layer->buffer.pixels.size(), w * h);
+
+        if (planeA.size() < w * h * 4) {
+            planeA.resize(w * h * 4);
+            planeB.resize(w * h * 4);
+        }
+        uint16_t* pa = &planeA[0];
+        const xlColor* px = &layer->buffer.pixels[0];
         for (int x = 0; x < pixCount; x++) {
-            const xlColor &c = layer->buffer.pixels[x];
-            input[x * 4] = c.red;
-            input[x * 4 + 1] = c.green;
-            input[x * 4 + 2] = c.blue;
-            input[x * 4 + 3] = c.alpha;
+            pa[x * 4] = px[x].red << BLUR_FIXED_SHIFT;
+            pa[x * 4 + 1] = px[x].green << BLUR_FIXED_SHIFT;
+            pa[x * 4 + 2] = px[x].blue << BLUR_FIXED_SHIFT;
+            pa[x * 4 + 3] = px[x].alpha << BLUR_FIXED_SHIFT;
         }
-        gaussBlur_4(input, tmp, layer->BufferWi, layer->BufferHt, b, pixCount);
+        // any part of the buffer without pixels blurs as transparent black
+        std::fill(planeA.begin() + pixCount * 4, planeA.begin() + w * h * 4, 0);
 
+        int radii[3];
+        boxesForGauss(std::min(b, 16) - 1, radii);
+        for (int i = 0; i < 3; i++) {
+            BoxBlur(planeA, planeB, w, h, radii[i]);
+        }
+
+        const int half = 1 << (BLUR_FIXED_SHIFT - 1);
         for (int x = 0; x < pixCount; x++) {
-            layer->buffer.pixels[x].Set(roundInt(tmp[x*4]),
-                                        roundInt(tmp[x*4 + 1]),
-                                        roundInt(tmp[x*4 + 2]),
-                                        roundInt(tmp[x*4 + 3]));
+            layer->buffer.pixels[x].Set((pa[x * 4] + half) >> BLUR_FIXED_SHIFT,
+                                        (pa[x * 4 + 1] + half) >> BLUR_FIXED_SHIFT,
+                                        (pa[x * 4 + 2] + half) >> BLUR_FIXED_SHIFT,
+                                        (pa[x * 4 + 3] + half) >> BLUR_FIXED_SHIFT);
         }
-        //delete [] input;
-        //delete [] tmp;
     } else {
         int d;
         int u;
@@ -1816,7 +1745,8 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
             d = (b - 1) / 2;
             u = (b - 1) / 2;
         }
-        RenderBuffer orig(layer->buffer);
+        orig.assign(layer->buffer.pixels.begin(), layer->buffer.pixels.end());
+        const int w = layer->BufferWi;
         for (int x = 0; x < layer->BufferWi; x++)
         {
             for (int y = 0; y < layer->BufferHt; y++)
@@ -1834,7 +1764,7 @@ void PixelBufferClass::Blur(LayerInfo* layer, float offset)
                         {
                             if (j >=0 && j < layer->BufferHt)
                             {
-                                const xlColor &c = orig.GetPixel(i, j);
+                                const xlColor &c = j * w + i < orig.size() ? orig[j * w + i] : xlBLACK;
                                 r += c.red;
                                 g += c.green;
                                 b2 += c.blue;
@@ -2173,6 +2103,59 @@ namespace
    }
 }
 
+static int DecodeType(const std::string &type)
+{
+    if (type == "Wipe")
+    {
+        return 1;
+    }
+    else if (type == "Clock")
+    {
+        return 2;
+    }
+    else if (type == "From Middle")
+    {
+        return 3;
+    }
+    else if (type == "Square Explode")
+    {
+        return 4;
+    }
+    else if (type == "Circle Explode")
+    {
+        return 5;
+    }
+    else if (type == "Blinds")
+    {
+        return 6;
+    }
+    else if (type == "Blend")
+    {
+        return 7;
+    }
+    else if (type == "Slide Checks")
+    {
+        return 8;
+    }
+    else if (type == "Slide Bars")
+    {
+        return 9;
+    }
+
+    return 0;
+}
+
+namespace
+{
+   const std::vector<std::string> transitionNames = {
+       STR_FOLD, STR_DISSOLVE, STR_CIRCULAR_SWIRL, STR_BOW_TIE, STR_ZOOM, STR_DOORWAY, STR_BLOBS, STR_PINWHEEL, STR_STAR
+   };
+   bool nonMaskTransition( const std::string& transitionType )
+   {
+      return std::find( transitionNames.cbegin(), transitionNames.cend(), transitionType ) != transitionNames.cend();
+   }
+}
+
 void PixelBufferClass::SetLayerSettings(int layer, const SettingsMap &settingsMap) {
     LayerInfo *inf = layers[layer];
     inf->persistent = settingsMap.GetBool(CHECKBOX_OverlayBkg);
@@ -2183,6 +2166,10 @@ void PixelBufferClass::SetLayerSettings(int layer, const SettingsMap &settingsMa
 
     inf->inTransitionType = settingsMap.Get(CHOICE_In_Transition_Type, STR_FADE);
     inf->outTransitionType = settingsMap.Get(CHOICE_Out_Transition_Type, STR_FADE);
+    inf->inTransitionMask = DecodeType(inf->inTransitionType);
+    inf->outTransitionMask = DecodeType(inf->outTransitionType);
+    inf->inTransitionNonMask = nonMaskTransition(inf->inTransitionType);
+    inf->outTransitionNonMask = nonMaskTransition(inf->outTransitionType);
     inf->inTransitionAdjust = settingsMap.GetInt(SLIDER_In_Transition_Adjust, 0);
     inf->outTransitionAdjust = settingsMap.GetInt(SLIDER_Out_Transition_Adjust, 0);
     inf->InTransitionAdjustValueCurve = valueCurveFromSettingsMap( settingsMap, "In_Transition_Adjust" );
@@ -2441,6 +2428,12 @@ void PixelBufferClass::SetLayer(int layer, int period, bool resetState)
             }
         }
     }
+    if (resetState) {
+        layers[layer]->buffer.SeedRandom(layer);
+        for (const auto& it : layers[layer]->modelBuffers) {
+            it->SeedRandom(layer);
+        }
+    }
 }
 
 void PixelBufferClass::SetTimes(int layer, int startTime, int endTime)
@@ -2463,35 +2456,163 @@ static inline bool IsInRange(const std::vector<bool> &restrictRange, size_t star
     return restrictRange[start];
 }
 
+// nodes are grouped into blocks of this size when working out what changed between frames
+#define COLOR_BLOCK_NODES 512
+
+void PixelBufferClass::InitColorBlocks() {
+    const auto &nodes = layers[0]->buffer.Nodes;
+
+    colorBlocks.clear();
+    colorModels.clear();
+    colorCurves.clear();
+    colorOutputOffsets.resize(nodes.size());
+
+    // the key is the node's raw colour as everything GetColors produces for a node comes from it
+    size_t outputSize = 0;
+    for (size_t x = 0; x < nodes.size(); x++) {
+        colorOutputOffsets[x] = outputSize;
+        outputSize += nodes[x]->GetChanCount();
+        if (nodes[x]->model != nullptr && std::find(colorModels.begin(), colorModels.end(), nodes[x]->model) == colorModels.end()) {
+            colorModels.push_back(nodes[x]->model);
+            colorCurves.push_back(nullptr);
+        }
+    }
+    colorKeys.assign(nodes.size() * 3, 0);
+    colorOutput.assign(outputSize, 0);
+
+    for (size_t first = 0; first < nodes.size(); first += COLOR_BLOCK_NODES) {
+        ColorBlock block;
+        block.firstNode = first;
+        block.endNode = std::min(nodes.size(), first + COLOR_BLOCK_NODES);
+        block.startChannel = nodes[first]->ActChan;
+        block.contiguous = true;
+        size_t next = block.startChannel;
+        for (size_t x = block.firstNode; x < block.endNode; x++) {
+            if (nodes[x]->ActChan != next) {
+                block.contiguous = false;
+            }
+            next = nodes[x]->ActChan + nodes[x]->GetChanCount();
+            block.channels += nodes[x]->GetChanCount();
+        }
+        colorBlocks.push_back(block);
+    }
+}
+
+// Returns true if the block had to be recomputed
+bool PixelBufferClass::UpdateColorBlock(ColorBlock &block) {
+    const auto &nodes = layers[0]->buffer.Nodes;
+
+    bool changed = !block.valid;
+    for (size_t x = block.firstNode; x < block.endNode; x++) {
+        const uint8_t *c = nodes[x]->GetRawColor();
+        uint8_t *last = &colorKeys[x * 3];
+        if (c[0] != last[0] || c[1] != last[1] || c[2] != last[2]) {
+            last[0] = c[0];
+            last[1] = c[1];
+            last[2] = c[2];
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+
+    for (size_t x = block.firstNode; x < block.endNode; x++) {
+        auto &n = nodes[x];
+        if (n->model != nullptr) { // I dont like this ... it should never be null
+            DimmingCurve *curve = n->model->modelDimmingCurve;
+            if (curve != nullptr) {
+                if (n->GetChanCount() == 1) {
+                    uint8_t buf[3];
+                    n->GetForChannels(buf);
+                    xlColor color(buf[0], buf[0], buf[0]);
+                    curve->apply(color);
+
+                    n->SetColor(color);
+                } else {
+                    xlColor color;
+                    n->GetColor(color);
+                    curve->apply(color);
+                    n->SetColor(color);
+                }
+            }
+        }
+        n->GetForChannels(&colorOutput[colorOutputOffsets[x]]);
+    }
+    block.valid = true;
+    return true;
+}
+
 void PixelBufferClass::GetColors(unsigned char *fdata, const std::vector<bool> &restrictRange) {
 
-    // KW ... I think this needs to be optimised
+    if (layers[0] == nullptr) { // I dont like this ... it should never be null
+        return;
+    }
+    const auto &nodes = layers[0]->buffer.Nodes;
+    if (colorOutputOffsets.size() != nodes.size() || (colorBlocks.empty() && !nodes.empty())) {
+        InitColorBlocks();
+    }
 
-    if (layers[0] != nullptr) { // I dont like this ... it should never be null
-        for (auto &n : layers[0]->buffer.Nodes) {
+    bool hasCurve = false;
+    bool curveChanged = false;
+    for (size_t i = 0; i < colorModels.size(); i++) {
+        DimmingCurve *curve = colorModels[i]->modelDimmingCurve;
+        hasCurve |= curve != nullptr;
+        if (curve != colorCurves[i]) {
+            colorCurves[i] = curve;
+            curveChanged = true;
+        }
+    }
+
+    if (!hasCurve) {
+        // without a dimming curve writing the channels is cheaper than working out whether they changed
+        for (const auto &n : nodes) {
             size_t start = n->ActChan;
             if (IsInRange(restrictRange, start)) {
-                if (n->model != nullptr) { // nor this
-                    DimmingCurve *curve = n->model->modelDimmingCurve;
-                    if (curve != nullptr) {
-                        if (n->GetChanCount() == 1) {
-                            uint8_t buf[3];
-                            n->GetForChannels(buf);
-                            xlColor color(buf[0], buf[0], buf[0]);
-                            curve->apply(color);
-
-                            n->SetColor(color);
-                        } else {
-                            xlColor color;
-                            n->GetColor(color);
-                            curve->apply(color);
-                            n->SetColor(color);
-                        }
-                    }
-                }
                 n->GetForChannels(&fdata[start]);
             }
         }
+        colorNodesWritten += nodes.size();
+        return;
+    }
+
+    for (auto &block : colorBlocks) {
+        if (curveChanged) {
+            block.valid = false;
+        }
+        size_t count = block.endNode - block.firstNode;
+        if (UpdateColorBlock(block)) {
+            colorNodesWritten += count;
+        } else {
+            colorNodesReused += count;
+        }
+
+        if (restrictRange.empty() && block.contiguous) {
+            memcpy(&fdata[block.startChannel], &colorOutput[colorOutputOffsets[block.firstNode]], block.channels);
+        } else {
+            for (size_t x = block.firstNode; x < block.endNode; x++) {
+                size_t start = nodes[x]->ActChan;
+                if (IsInRange(restrictRange, start)) {
+                    memcpy(&fdata[start], &colorOutput[colorOutputOffsets[x]], nodes[x]->GetChanCount());
+                }
+            }
+        }
+    }
+}
+
+void PixelBufferClass::AddColorsStats(PixelBufferClass &other) {
+    colorNodesWritten += other.colorNodesWritten.exchange(0);
+    colorNodesReused += other.colorNodesReused.exchange(0);
+}
+
+void PixelBufferClass::LogColorsStats(const std::string &name) {
+    static log4cpp::Category& logger_render = log4cpp::Category::getInstance(std::string("log_render"));
+    size_t written = colorNodesWritten.exchange(0);
+    size_t reused = colorNodesReused.exchange(0);
+    if (written + reused > 0) {
+        logger_render.debug("%s output: %llu nodes recomputed, %llu nodes unchanged from the previous frame (%d%% skipped).",
+                            (const char *)name.c_str(), (unsigned long long)written, (unsigned long long)reused,
+                            (int)(reused * 100 / (written + reused)));
     }
 }
 
@@ -2516,10 +2637,140 @@ void PixelBufferClass::SetColors(int layer, const unsigned char *fdata)
     }
 }
 
-void PixelBufferClass::RotateX(LayerInfo* layer, float offset)
+// Affine transform in buffer coordinates mapping where a source pixel position is drawn.
+// x' = a * x + b * y + c
+// y' = d * x + e * y + f
+struct RotoZoomMatrix
 {
-    // Now do the rotation around a point on the x axis
+    float a = 1.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    float d = 0.0f;
+    float e = 1.0f;
+    float f = 0.0f;
+
+    // apply m after this transform
+    void Then(const RotoZoomMatrix& m)
+    {
+        RotoZoomMatrix r;
+        r.a = m.a * a + m.b * d;
+        r.b = m.a * b + m.b * e;
+        r.c = m.a * c + m.b * f + m.c;
+        r.d = m.d * a + m.e * d;
+        r.e = m.d * b + m.e * e;
+        r.f = m.d * c + m.e * f + m.f;
+        *this = r;
+    }
+
+    bool Invert(RotoZoomMatrix& inv) const
+    {
+        float det = a * e - b * d;
+        if (std::abs(det) < 1e-9f) return false;
+        inv.a = e / det;
+        inv.b = -b / det;
+        inv.c = (b * f - c * e) / det;
+        inv.d = -d / det;
+        inv.e = a / det;
+        inv.f = (c * d - a * f) / det;
+        return true;
+    }
+};
+
+// keeps an edge on rotation or zero zoom invertible ... it collapses to a line/point rather than vanishing
+static inline float RotoZoomNonZero(float s)
+{
+    if (std::abs(s) < 0.001f) {
+        return s < 0 ? -0.001f : 0.001f;
+    }
+    return s;
+}
+
+// Redraws the buffer through the forward transform by sampling the source at the inverse of every
+// destination pixel. Quality > 1 checks quality x quality samples per destination pixel but like the old forward
+// drawing it does not blend them ... the pixel takes the colour of the covering source pixel the old code would have
+// drawn last (highest x then highest y) so edges stay hard rather than fading into the background.
+static void RotoZoomResample(RenderBuffer& buffer, const RotoZoomMatrix& forward, int quality)
+{
+    const int w = buffer.BufferWi;
+    const int h = buffer.BufferHt;
+    if (w == 0 || h == 0 || buffer.pixels.empty()) return;
+
+    RotoZoomMatrix inv;
+    if (!forward.Invert(inv)) {
+        buffer.Clear();
+        return;
+    }
+
+    // pixel only scratch reused by each render thread
+    static thread_local std::vector<xlColor> scratch;
+    scratch.assign(buffer.pixels.begin(), buffer.pixels.end());
+    const xlColor* src = &scratch[0];
+    const int srcCount = scratch.size();
+
+    const bool dmx = buffer.IsDmxBuffer();
+    if (dmx) {
+        buffer.Clear();
+    }
+    xlColor* dst = &buffer.pixels[0];
+    const int dstCount = buffer.pixels.size();
+    const int q = std::max(quality, 1);
+    const float inc = 1.0f / (float)q;
+
+    auto sample = [src, srcCount, w, h](float sx, float sy, const xlColor*& out) {
+        if (sx >= 0 && sy >= 0 && sx < w && sy < h) {
+            int idx = (int)sy * w + (int)sx;
+            if (idx < srcCount) {
+                out = &src[idx];
+                return true;
+            }
+        }
+        return false;
+    };
+
+    parallel_for(0, h, [&](int y) {
+        for (int x = 0; x < w; x++) {
+            xlColor c(0, 0, 0, 0);
+            if (q == 1) {
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                const xlColor* s;
+                if (sample(inv.a * px + inv.b * py + inv.c, inv.d * px + inv.e * py + inv.f, s)) {
+                    c = *s;
+                }
+            } else {
+                const xlColor* best = nullptr;
+                int bestOrder = -1;
+                for (int j = 0; j < q; j++) {
+                    float py = y + (j + 0.5f) * inc;
+                    for (int i = 0; i < q; i++) {
+                        float px = x + (i + 0.5f) * inc;
+                        const xlColor* s;
+                        if (sample(inv.a * px + inv.b * py + inv.c, inv.d * px + inv.e * py + inv.f, s)) {
+                            int idx = s - src;
+                            int order = (idx % w) * h + idx / w;
+                            if (order > bestOrder) {
+                                bestOrder = order;
+                                best = s;
+                            }
+                        }
+                    }
+                }
+                if (best != nullptr) {
+                    c = *best;
+                }
+            }
+            if (dmx) {
+                if (c.alpha != 0) buffer.SetPixel(x, y, c);
+            } else if (y * w + x < dstCount) {
+                dst[y * w + x] = c;
+            }
+        }
+    }, dmx ? h : std::max(1, 2048 / (w * q * q)));
+}
 
+bool PixelBufferClass::RotateX(LayerInfo* layer, float offset, RotoZoomMatrix& m)
+{
+    // rotation around a point on the x axis is a scale of x about the pivot
     float xrotation = layer->xrotation;
     if (layer->XRotationValueCurve.IsActive())
     {
@@ -2534,35 +2785,20 @@ void PixelBufferClass::RotateX(LayerInfo* layer, float offset)
             xpivot = layer->XPivotValueCurve.GetOutputValueAt(offset, layer->buffer.GetStartTimeMS(), layer->buffer.GetEndTimeMS());
         }
 
-        RenderBuffer orig(layer->buffer);
-        layer->buffer.Clear();
-
-        float sine = sin((xrotation + 90) * M_PI / 180);
+        float sine = RotoZoomNonZero(sin((xrotation + 90) * M_PI / 180));
         float pivot = xpivot * layer->buffer.BufferWi / 100;
 
-        for (int x = pivot; x < layer->buffer.BufferWi; ++x)
-        {
-            float tox = sine * (x - pivot) + pivot;
-            for (int y = 0; y < layer->buffer.BufferHt; ++y)
-            {
-                layer->buffer.SetPixel(tox, y, orig.GetPixel(x, y));
-            }
-        }
-
-        for (int x = pivot - 1; x >= 0; --x)
-        {
-            float tox = -1 * sine * (pivot - x) + pivot;
-            for (int y = 0; y < layer->buffer.BufferHt; ++y)
-            {
-                layer->buffer.SetPixel(tox, y, orig.GetPixel(x, y));
-            }
-        }
+        m = RotoZoomMatrix();
+        m.a = sine;
+        m.c = pivot - sine * pivot;
+        return true;
     }
+    return false;
 }
 
-void PixelBufferClass::RotateY(LayerInfo* layer, float offset)
+bool PixelBufferClass::RotateY(LayerInfo* layer, float offset, RotoZoomMatrix& m)
 {
-    // Now do the rotation around a point on the y axis
+    // rotation around a point on the y axis is a scale of y about the pivot
     float yrotation = layer->yrotation;
     if (layer->YRotationValueCurve.IsActive())
     {
@@ -2577,33 +2813,18 @@ void PixelBufferClass::RotateY(LayerInfo* layer, float offset)
             ypivot = layer->YPivotValueCurve.GetOutputValueAt(offset, layer->buffer.GetStartTimeMS(), layer->buffer.GetEndTimeMS());
         }
 
-        RenderBuffer orig(layer->buffer);
-        layer->buffer.Clear();
-
-        float sine = sin((yrotation + 90) * M_PI / 180);
+        float sine = RotoZoomNonZero(sin((yrotation + 90) * M_PI / 180));
         float pivot = ypivot * layer->buffer.BufferHt / 100;
 
-        for (int y = pivot; y < layer->buffer.BufferHt; ++y)
-        {
-            float toy = sine * (y - pivot) + pivot;
-            for (int x = 0; x < layer->buffer.BufferWi; ++x)
-            {
-                layer->buffer.SetPixel(x, toy, orig.GetPixel(x, y));
-            }
-        }
-
-        for (int y = pivot - 1; y >= 0; --y)
-        {
-            float toy = -1 * sine * (pivot - y) + pivot;
-            for (int x = 0; x < layer->buffer.BufferWi; ++x)
-            {
-                layer->buffer.SetPixel(x, toy, orig.GetPixel(x, y));
-            }
-        }
+        m = RotoZoomMatrix();
+        m.e = sine;
+        m.f = pivot - sine * pivot;
+        return true;
     }
+    return false;
 }
 
-void PixelBufferClass::RotateZAndZoom(LayerInfo* layer, float offset)
+bool PixelBufferClass::RotateZAndZoom(LayerInfo* layer, float offset, RotoZoomMatrix& m)
 {
     // Do the Z axis rotate and zoom first
     float zoom = layer->zoom;
@@ -2639,9 +2860,6 @@ void PixelBufferClass::RotateZAndZoom(LayerInfo* layer, float offset)
     if (rotation != 0.0 || zoom != 1.0)
     {
         static const float PI_2 = 6.283185307f;
-        xlColor c;
-        RenderBuffer orig(layer->buffer);
-        int q = layer->zoomquality;
         int cx = layer->pivotpointx;
         if (layer->PivotPointXValueCurve.IsActive())
         {
@@ -2652,65 +2870,68 @@ void PixelBufferClass::RotateZAndZoom(LayerInfo* layer, float offset)
         {
             cy = layer->PivotPointYValueCurve.GetOutputValueAt(offset, layer->buffer.GetStartTimeMS(), layer->buffer.GetEndTimeMS());
         }
-        float inc = 1.0 / (float)q;
 
         float angle = PI_2 * -rotation;
         float xoff = (cx * layer->buffer.BufferWi) / 100.0;
         float yoff = (cy * layer->BufferHt) / 100.0;
-        float anglecos = cos(-angle);
-        float anglesin = sin(-angle);
-
-        layer->buffer.Clear();
-        for (int x = 0; x < layer->BufferWi; x++)
-        {
-            for (int i = 0; i < q; i++)
-            {
-                for (int y = 0; y < layer->BufferHt; y++)
-                {
-                    orig.GetPixel(x, y, c);
-                    for (int j = 0; j < q; j++)
-                    {
-                        float xx = (float)x + ((float)i * inc) - xoff;
-                        float yy = (float)y + ((float)j * inc) - yoff;
-                        float u = xoff + anglecos * xx * zoom + anglesin * yy * zoom;
-                        if (u >= 0 && u < layer->BufferWi)
-                        {
-                            float v = yoff + -anglesin * xx * zoom + anglecos * yy * zoom;
-
-                            if (v >= 0 && v < layer->BufferHt)
-                            {
-                                layer->buffer.SetPixel(u, v, c);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        zoom = RotoZoomNonZero(zoom);
+        float anglecos = cos(-angle) * zoom;
+        float anglesin = sin(-angle) * zoom;
+
+        // rotate and zoom about the pivot point
+        m.a = anglecos;
+        m.b = anglesin;
+        m.c = xoff - anglecos * xoff - anglesin * yoff;
+        m.d = -anglesin;
+        m.e = anglecos;
+        m.f = yoff + anglesin * xoff - anglecos * yoff;
+        return true;
     }
+    return false;
 }
 
 void PixelBufferClass::RotoZoom(LayerInfo* layer, float offset)
 {
     if (std::isinf(offset)) offset = 1.0;
 
-    wxArrayString order = wxSplit(layer->rotationorder, ',');
-
-    for (auto it = order.begin(); it != order.end(); ++it)
+    // compose the steps in the requested order into one transform so the buffer is only resampled once
+    RotoZoomMatrix transform;
+    bool active = false;
+    bool zoomed = false;
+    const std::string& order = layer->rotationorder;
+    for (size_t i = 0; i < order.size(); i++)
     {
-        char c = it->Trim(false).ToStdString()[0];
-        switch(c)
+        RotoZoomMatrix m;
+        switch (order[i])
         {
         case 'X':
-            RotateX(layer, offset);
+            if (RotateX(layer, offset, m)) {
+                transform.Then(m);
+                active = true;
+            }
             break;
         case 'Y':
-            RotateY(layer, offset);
+            if (RotateY(layer, offset, m)) {
+                transform.Then(m);
+                active = true;
+            }
             break;
         case 'Z':
-            RotateZAndZoom(layer, offset);
+            if (RotateZAndZoom(layer, offset, m)) {
+                transform.Then(m);
+                active = true;
+                zoomed = true;
+            }
+            break;
+        default:
             break;
         }
     }
+
+    if (active)
+    {
+        RotoZoomResample(layer->buffer, transform, zoomed ? layer->zoomquality : 1);
+    }
 }
 
 bool PixelBufferClass::IsVariableSubBuffer(int layer) const
@@ -2898,47 +3119,6 @@ void PixelBufferClass::CalcOutput(int EffectPeriod, const std::vector<bool> & va
     }, blockSize);
 }
 
-static int DecodeType(const std::string &type)
-{
-    if (type == "Wipe")
-    {
-        return 1;
-    }
-    else if (type == "Clock")
-    {
-        return 2;
-    }
-    else if (type == "From Middle")
-    {
-        return 3;
-    }
-    else if (type == "Square Explode")
-    {
-        return 4;
-    }
-    else if (type == "Circle Explode")
-    {
-        return 5;
-    }
-    else if (type == "Blinds")
-    {
-        return 6;
-    }
-    else if (type == "Blend")
-    {
-        return 7;
-    }
-    else if (type == "Slide Checks")
-    {
-        return 8;
-    }
-    else if (type == "Slide Bars")
-    {
-        return 9;
-    }
-
-    return 0;
-}
 void PixelBufferClass::LayerInfo::clear() {
     buffer.Clear();
     if (usingModelBuffers) {
@@ -2949,6 +3129,24 @@ void PixelBufferClass::LayerInfo::clear() {
 }
 
 
+std::vector<double>& PixelBufferClass::LayerInfo::prepareThresholds(bool out, int type, int adjust, bool& rebuild) {
+    MaskThresholds& t = out ? outThresholds : inThresholds;
+    rebuild = t.type != type || t.adjust != adjust ||
+        t.width != BufferWi || t.height != BufferHt ||
+        t.bufferWi != buffer.BufferWi || t.bufferHt != buffer.BufferHt ||
+        t.values.size() != mask.size();
+    if (rebuild) {
+        t.type = type;
+        t.adjust = adjust;
+        t.width = BufferWi;
+        t.height = BufferHt;
+        t.bufferWi = buffer.BufferWi;
+        t.bufferHt = buffer.BufferHt;
+        t.values.resize(mask.size());
+    }
+    return t.values;
+}
+
 void PixelBufferClass::LayerInfo::createFromMiddleMask(bool out) {
     bool reverse = inTransitionReverse;
     float factor = inMaskFactor;
@@ -2985,20 +3183,25 @@ void PixelBufferClass::LayerInfo::createFromMiddleMask(bool out) {
     double y2_less_y1 = p2.y - p1.y;
     double x2_less_x1 = p2.x - p1.x;
     double offset = p2.x * p1.y - p2.y * p1.x;
-    uint8_t c = 0;
 
     double len = ::sqrt( buffer.BufferWi * buffer.BufferWi + buffer.BufferHt * buffer.BufferHt );
     double step = len / 2.0 * factor;
 
-   for (int x = 0; x < BufferWi; ++x )
-   {
-      for ( int y = 0; y < BufferHt; ++y )
-      {
-         double dist = std::abs( y2_less_y1 * x - x2_less_x1 * y + offset ) / p1_p2_len;
-         c = (dist > step) ? m1 : m2;
-         mask[x * BufferHt + y] = c;
-      }
-   }
+    bool rebuild;
+    std::vector<double>& dist = prepareThresholds(out, 3, adjust, rebuild);
+    if (rebuild) {
+        for (int x = 0; x < BufferWi; ++x) {
+            for (int y = 0; y < BufferHt; ++y) {
+                dist[x * BufferHt + y] = std::abs( y2_less_y1 * x - x2_less_x1 * y + offset ) / p1_p2_len;
+            }
+        }
+    }
+
+    const double* d = dist.data();
+    uint8_t* m = mask.data();
+    for (size_t i = 0; i < dist.size(); i++) {
+        m[i] = (d[i] > step) ? m1 : m2;
+    }
 }
 
 void PixelBufferClass::LayerInfo::createCircleExplodeMask(bool out) {
@@ -3024,14 +3227,22 @@ void PixelBufferClass::LayerInfo::createCircleExplodeMask(bool out) {
 
     float rad = maxradius * factor;
 
-    for (int x = 0; x < BufferWi; x++)
-    {
-        for (int y = 0; y < BufferHt; y++)
-        {
-            float radius = sqrt((x - (BufferWi / 2)) * (x - (BufferWi / 2)) + (y - (BufferHt / 2)) * (y - (BufferHt / 2)));
-            mask[x * BufferHt + y] = radius < rad ? m2 : m1;
+    bool rebuild;
+    std::vector<double>& radius = prepareThresholds(out, 5, 0, rebuild);
+    if (rebuild) {
+        for (int x = 0; x < BufferWi; x++) {
+            for (int y = 0; y < BufferHt; y++) {
+                // rounded to float as the radius always was so pixels on the boundary are masked the same way
+                radius[x * BufferHt + y] = (float)sqrt((x - (BufferWi / 2)) * (x - (BufferWi / 2)) + (y - (BufferHt / 2)) * (y - (BufferHt / 2)));
+            }
         }
     }
+
+    const double* r = radius.data();
+    uint8_t* m = mask.data();
+    for (size_t i = 0; i < radius.size(); i++) {
+        m[i] = (float)r[i] < rad ? m2 : m1;
+    }
 }
 void PixelBufferClass::LayerInfo::createSquareExplodeMask(bool out)
 {
@@ -3171,34 +3382,36 @@ void PixelBufferClass::LayerInfo::createClockMask(bool out) {
         currentradians = startradians + currentradians;
     }
 
-    for (int x = 0; x < BufferWi; x++)
-    {
-        for (int y = 0; y < BufferHt; y++)
-        {
-            float radianspixel;
-            if (x - BufferWi / 2 == 0 && y - BufferHt / 2 == 0)
-            {
-                radianspixel = 0.0;
-            }
-            else
-            {
-                radianspixel = atan2(x - BufferWi / 2,
-                                     y - BufferHt / 2);
-            }
-            if (radianspixel < 0)
-            {
-                radianspixel += 2.0f * (float)M_PI;
-            }
-            if (currentradians > 2.0f * (float)M_PI && radianspixel < startradians) {
-                radianspixel += 2.0f * (float)M_PI;
+    bool rebuild;
+    std::vector<double>& angles = prepareThresholds(out, 2, 0, rebuild);
+    if (rebuild) {
+        for (int x = 0; x < BufferWi; x++) {
+            for (int y = 0; y < BufferHt; y++) {
+                float radianspixel;
+                if (x - BufferWi / 2 == 0 && y - BufferHt / 2 == 0) {
+                    radianspixel = 0.0;
+                } else {
+                    radianspixel = atan2(x - BufferWi / 2,
+                                         y - BufferHt / 2);
+                }
+                if (radianspixel < 0) {
+                    radianspixel += 2.0f * (float)M_PI;
+                }
+                angles[x * BufferHt + y] = radianspixel;
             }
-
-            bool s_lt_p = radianspixel > startradians;
-            bool c_gt_p = radianspixel < currentradians;
-            mask[x * BufferHt + y] = (s_lt_p && c_gt_p) ? m2 : m1;
         }
     }
 
+    const bool wraps = currentradians > 2.0f * (float)M_PI;
+    const double* a = angles.data();
+    uint8_t* m = mask.data();
+    for (size_t i = 0; i < angles.size(); i++) {
+        float radianspixel = a[i];
+        if (wraps && radianspixel < startradians) {
+            radianspixel += 2.0f * (float)M_PI;
+        }
+        m[i] = (radianspixel > startradians && radianspixel < currentradians) ? m2 : m1;
+    }
 }
 
 
@@ -3437,22 +3650,11 @@ void PixelBufferClass::LayerInfo::createSlideBarsMask(bool out) {
     }
 }
 
-namespace
-{
-   const std::vector<std::string> transitionNames = {
-       STR_FOLD, STR_DISSOLVE, STR_CIRCULAR_SWIRL, STR_BOW_TIE, STR_ZOOM, STR_DOORWAY, STR_BLOBS, STR_PINWHEEL, STR_STAR
-   };
-   bool nonMaskTransition( const std::string& transitionType )
-   {
-      return std::find( transitionNames.cbegin(), transitionNames.cend(), transitionType ) != transitionNames.cend();
-   }
-}
-
 void PixelBufferClass::LayerInfo::renderTransitions(bool isFirstFrame, const RenderBuffer* prevRB) {
     bool hasMask = false;
     if (inMaskFactor < 1.0) {
         mask.resize(BufferHt * BufferWi);
-        if ( nonMaskTransition( inTransitionType ) ) {
+        if ( inTransitionNonMask ) {
             ColorBuffer cb( buffer.pixels, buffer.BufferWi, buffer.BufferHt );
 
             if ( inTransitionType == STR_FOLD ) {
@@ -3495,7 +3697,7 @@ void PixelBufferClass::LayerInfo::renderTransitions(bool isFirstFrame, const Ren
     }
     if (outMaskFactor < 1.0) {
         mask.resize(BufferHt * BufferWi);
-        if ( nonMaskTransition( outTransitionType ) ) {
+        if ( outTransitionNonMask ) {
             ColorBuffer cb( buffer.pixels, buffer.BufferWi, buffer.BufferHt );
             if ( outTransitionType == STR_FOLD ) {
                foldOut( buffer, cb, prevRB, outMaskFactor, outTransitionReverse );
@@ -3542,7 +3744,7 @@ void PixelBufferClass::LayerInfo::renderTransitions(bool isFirstFrame, const Ren
 
 void PixelBufferClass::LayerInfo::calculateMask(const std::string &type, bool mode, bool isFirstFrame) {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
-    switch (DecodeType(type)) {
+    switch (mode ? outTransitionMask : inTransitionMask) {
         case 1:
             createWipeMask(mode);
             break;
@@ -12,6 +12,8 @@
 
 #include <wx/xml/xml.h>
 
+#include <atomic>
+
 #include "models/Model.h"
 #include "models/SingleLineModel.h"
 #include "RenderBuffer.h"
@@ -76,6 +78,7 @@ class SequenceElements;
 class SettingsMap;
 class DimmingCurve;
 class ModelGroup;
+struct RotoZoomMatrix;
 
 class PixelBufferClass
 {
@@ -193,6 +196,10 @@ private:
         int fadeOutSteps;
         std::string inTransitionType;
         std::string outTransitionType;
+        int inTransitionMask = 0;
+        int outTransitionMask = 0;
+        bool inTransitionNonMask = false;
+        bool outTransitionNonMask = false;
         std::string type;
         std::string transform;
         int inTransitionAdjust;
@@ -218,6 +225,20 @@ private:
         void clear();
 
     private:
+        // per pixel geometry for the mask transitions that threshold it against the transition progress
+        struct MaskThresholds {
+            int type = 0;
+            int adjust = 0;
+            int width = 0;
+            int height = 0;
+            int bufferWi = 0;
+            int bufferHt = 0;
+            std::vector<double> values;
+        };
+        MaskThresholds inThresholds;
+        MaskThresholds outThresholds;
+        std::vector<double>& prepareThresholds(bool out, int type, int adjust, bool& rebuild);
+
         void createSquareExplodeMask(bool end);
         void createCircleExplodeMask(bool end);
         void createWipeMask(bool end);
@@ -240,11 +261,32 @@ private:
     void reset(int layers, int timing, bool isNode = false);
 	void Blur(LayerInfo* layer, float offset);
     void RotoZoom(LayerInfo* layer, float offset);
-    void RotateX(LayerInfo* layer, float offset);
-    void RotateY(LayerInfo* layer, float offset);
-    void RotateZAndZoom(LayerInfo* layer, float offset);
+    bool RotateX(LayerInfo* layer, float offset, RotoZoomMatrix& m);
+    bool RotateY(LayerInfo* layer, float offset, RotoZoomMatrix& m);
+    bool RotateZAndZoom(LayerInfo* layer, float offset, RotoZoomMatrix& m);
     void GetMixedColor(int node, xlColor& c, const std::vector<bool> & validLayers, int EffectPeriod);
 
+    // When a model has a dimming curve GetColors keeps the raw colours and channel output of the
+    // last frame for each block of nodes so blocks that did not change can skip the curve
+    struct ColorBlock {
+        size_t firstNode = 0;
+        size_t endNode = 0;
+        size_t startChannel = 0;
+        size_t channels = 0;
+        bool contiguous = false;
+        bool valid = false;
+    };
+    std::vector<ColorBlock> colorBlocks;
+    std::vector<size_t> colorOutputOffsets;
+    std::vector<uint8_t> colorKeys;
+    std::vector<uint8_t> colorOutput;
+    std::vector<const Model*> colorModels;   // each model the nodes belong to
+    std::vector<DimmingCurve*> colorCurves;  // and the dimming curve it had last frame
+    std::atomic<size_t> colorNodesWritten{ 0 };
+    std::atomic<size_t> colorNodesReused{ 0 };
+    void InitColorBlocks();
+    bool UpdateColorBlock(ColorBlock &block);
+
     std::string modelName;
     std::string lastBufferType;
     std::string lastCamera;
@@ -301,6 +343,8 @@ public:
     void CalcOutput(int EffectPeriod, const std::vector<bool> &validLayers, int saveLayer = 0);
     void SetColors(int layer, const unsigned char *fdata);
     void GetColors(unsigned char *fdata, const std::vector<bool> &restrictRange);
+    void AddColorsStats(PixelBufferClass &other);
+    void LogColorsStats(const std::string &name);
 };
 
 typedef std::unique_ptr<PixelBufferClass> PixelBufferClassPtr;
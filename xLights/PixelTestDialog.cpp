@@ -1514,19 +1514,10 @@ std::list<std::string> PixelTestDialog::GetModelsOnChannels(int start, int end)
 {
 	std::list<std::string> res;
 
-	for (auto it = _modelManager->begin(); it != _modelManager->end(); ++it)
-	{
-		Model* m = it->second;
-        if (m->GetDisplayAs() != "ModelGroup")
-        {
-            int st = m->GetFirstChannel() + 1;
-            int en = m->GetLastChannel() + 1;
-            if (start <= en && end >= st)
-            {
-                res.push_back(it->first);
-            }
-        }
-	}
+    for (const auto& it : _modelManager->GetModelsInChannelRange(start, end))
+    {
+        res.push_back(it->GetName());
+    }
 
 	return res;
 }
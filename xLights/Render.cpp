@@ -12,6 +12,7 @@
 #include <condition_variable>
 #include <map>
 #include <memory>
+#include <thread>
 
 #include "xLightsMain.h"
 #include "xLightsXmlFile.h"
@@ -29,6 +30,9 @@
 #include <log4cpp/Category.hh>
 
 #define END_OF_RENDER_FRAME INT_MAX
+// each chunk of a frame parallel render restarts its effects so dont split below this
+#define MIN_FRAMES_PER_RENDER_CHUNK 100
+// uncomment to render chunked models a second time in order and log any frames that differ
 
 //other common strings
 static const std::string STR_EMPTY("");
@@ -224,8 +228,8 @@ class RenderJob: public Job, public NextRenderer {
 public:
     RenderJob(ModelElement *row, SequenceData &data, xLightsFrame *xframe, bool zeroBased = false)
         : Job(), NextRenderer(), rowToRender(row), seqData(&data), xLights(xframe),
-            gauge(nullptr), currentFrame(0), renderLog(log4cpp::Category::getInstance(std::string("log_render"))),
-            supportsModelBlending(false), abort(false), statusMap(nullptr)
+            gauge(nullptr), currentFrame(0), chunkFramesDone(-1), renderLog(log4cpp::Category::getInstance(std::string("log_render"))),
+            supportsModelBlending(false), abort(false), statusMap(nullptr), zeroBased(zeroBased)
     {
         name = "";
         if (row != nullptr) {
@@ -235,26 +239,7 @@ public:
 
             if (xframe->InitPixelBuffer(name, *mainBuffer, numLayers, zeroBased)) {
                 const Model *model = mainBuffer->GetModel();
-                if ("ModelGroup" == model->GetDisplayAs()) {
-                    //for (int l = 0; l < numLayers; ++l) {
-                    for (int l = numLayers - 1; l >= 0; --l) {
-                        EffectLayer *layer = row->GetEffectLayer(l);
-                        bool perModelEffects = false;
-                        for (int e = 0; e < layer->GetEffectCount() && !perModelEffects; ++e) {
-                            static const std::string CHOICE_BufferStyle("B_CHOICE_BufferStyle");
-                            static const std::string DEFAULT("Default");
-                            static const std::string PER_MODEL("Per Model");
-                            const std::string &bt = layer->GetEffect(e)->GetSettings().Get(CHOICE_BufferStyle, DEFAULT);
-                            if (bt.compare(0, 9, PER_MODEL) == 0) {
-                                perModelEffects = true;
-                            }
-                        }
-                        if (perModelEffects) {
-                            const ModelGroup *grp = dynamic_cast<const ModelGroup*>(model);
-                            mainBuffer->InitPerModelBuffers(*grp, l, data.FrameTime());
-                        }
-                    }
-                }
+                InitPerModelBuffers(mainBuffer);
                 for (int x = 0; x < row->GetSubModelAndStrandCount(); ++x) {
                     SubModelElement *se = row->GetSubModel(x);
                     if (se->HasEffects()) {
@@ -316,6 +301,11 @@ public:
     wxGauge *GetGauge() const { return gauge;}
     void SetGauge(wxGauge *g) { gauge = g;}
     int GetCurrentFrame() const { return currentFrame;}
+    // chunked renders finish frames out of order so report how many are done rather than the current frame
+    int GetProgressFrame() const {
+        int done = chunkFramesDone;
+        return done < 0 ? (int)currentFrame : startFrame + done - 1;
+    }
     int GetEndFrame() const { return endFrame;}
     int GetStartFrame() const { return startFrame;}
 
@@ -516,7 +506,8 @@ public:
         return frame - (ef->GetStartTimeMS() / frameTime);
     }
 
-    bool ProcessFrame(int frame, Element *el, EffectLayerInfo &info, PixelBufferClass *buffer, int strand = -1, bool blend = false) {
+    // updateStatus is false on the extra chunk threads of a chunked render as only the job thread may touch the status
+    bool ProcessFrame(int frame, Element *el, EffectLayerInfo &info, PixelBufferClass *buffer, int strand = -1, bool blend = false, RenderEvent *event = nullptr, bool updateStatus = true) {
 
         wxStopWatch sw;
         bool effectsToUpdate = false;
@@ -534,7 +525,9 @@ public:
             Effect* ef = findEffectForFrame(elayer, frame, info.currentEffectIdxs[layer]);
             if (ef != info.currentEffects[layer]) {
                 info.currentEffects[layer] = ef;
-                SetInializingStatus(frame, layer, strand);
+                if (updateStatus) {
+                    SetInializingStatus(frame, layer, strand);
+                }
                 initialize(layer, frame, ef, info.settingsMaps[layer], buffer);
                 info.effectStates[layer] = true;
             }
@@ -561,7 +554,9 @@ public:
                 suppress = buffer->GetSuppressUntil(layer) > GetEffectFrame(ef, frame, mainBuffer->GetFrameTimeInMS());
             }
 
-            SetRenderingStatus(frame, &info.settingsMaps[layer], layer, strand, -1, true);
+            if (updateStatus) {
+                SetRenderingStatus(frame, &info.settingsMaps[layer], layer, strand, -1, true);
+            }
             bool b = info.effectStates[layer];
 
             if (!freeze)
@@ -614,7 +609,7 @@ public:
                         });
                 }
 
-                info.validLayers[layer] = xLights->RenderEffectFromMap(suppress, ef, layer, frame, info.settingsMaps[layer], *buffer, b, true, &renderEvent);
+                info.validLayers[layer] = xLights->RenderEffectFromMap(suppress, ef, layer, frame, info.settingsMaps[layer], *buffer, b, true, event == nullptr ? &renderEvent : event);
                 effectsToUpdate |= info.validLayers[layer];
                 info.effectStates[layer] = b;
 
@@ -632,7 +627,9 @@ public:
         }
 
         if (effectsToUpdate) {
-            SetCalOutputStatus(frame, strand);
+            if (updateStatus) {
+                SetCalOutputStatus(frame, strand);
+            }
             if (blend) {
                 buffer->SetColors(numLayers, &((*seqData)[frame][0]));
                 info.validLayers[numLayers] = true;
@@ -651,12 +648,10 @@ public:
     }
 
     virtual void Process() override {
-        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
         static log4cpp::Category& logger_jobpool = log4cpp::Category::getInstance(std::string("log_jobpool"));
         logger_jobpool.debug("Render job thread id 0x%x or %d", wxThread::GetCurrentId(), wxThread::GetCurrentId());
 
         SetGenericStatus("Initializing rendering thread for %s", 0);
-        int maxFrameBeforeCheck = -1;
         int origChangeCount;
         int ss, es;
 
@@ -686,6 +681,48 @@ public:
         if (startFrame < 0) startFrame = 0;
         if (endFrame > seqData->NumFrames()) endFrame = seqData->NumFrames() - 1;
 
+        if (CanRenderFramesInParallel()) {
+            RenderFramesInParallel(origChangeCount);
+        } else {
+            RenderFrames(origChangeCount);
+        }
+        if (mainBuffer != nullptr) {
+            mainBuffer->LogColorsStats(name);
+        }
+
+        if (HasNext()) {
+            //make sure the previous has told us we're at the end.  If we return before waiting, the previous
+            //may try sending the END_OF_RENDER_FRAME to us and we'll have been deleted
+            SetGenericStatus("%s: Waiting on previous renderer for final frame", 0);
+            waitForFrame(END_OF_RENDER_FRAME);
+
+            //let the next know we're done
+            SetGenericStatus("%s: Notifying next renderer of final frame", 0);
+            FrameDone(END_OF_RENDER_FRAME);
+            xLights->CallAfter(&xLightsFrame::SetStatusText, wxString("Done Rendering \"" + rowToRender->GetModelName() + "\""), 0);
+        } else {
+            xLights->CallAfter(&xLightsFrame::RenderDone);
+        }
+        rowToRender->CleanupAfterRender();
+        // this pool thread may sit idle for a long time, it should not keep any sequence data pages resident
+        seqData->ReleaseThreadPins();
+        currentFrame = END_OF_RENDER_FRAME;
+        //printf("Done rendering %lx (next %lx)\n", (unsigned long)this, (unsigned long)next);
+		renderLog.debug("Rendering thread exiting.");
+	}
+
+    void AbortRender() {
+        abort = true;
+    }
+
+    ModelElement* GetModelElement() const { return rowToRender; }
+
+private:
+
+    void RenderFrames(int origChangeCount) {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+        int maxFrameBeforeCheck = -1;
+
         EffectLayerInfo mainModelInfo(numLayers);
         std::map<SNPair, Effect*> nodeEffects;
         std::map<SNPair, SettingsMap> nodeSettingsMaps;
@@ -709,6 +746,7 @@ public:
 
             for (int frame = startFrame; frame <= endFrame; ++frame) {
                 currentFrame = frame;
+                SequenceData::FramePin pin(*seqData, frame);
                 SetGenericStatus("%s: Starting frame %d " + PrintStatusMap(), frame, true);
 
                 if (abort) {
@@ -803,32 +841,203 @@ public:
 			renderLog.error("Caught an unknown exception on rendering thread.");
             logger_base.error("Caught an unknown exception on rendering thread.");
         }
-        if (HasNext()) {
-            //make sure the previous has told us we're at the end.  If we return before waiting, the previous
-            //may try sending the END_OF_RENDER_FRAME to us and we'll have been deleted
-            SetGenericStatus("%s: Waiting on previous renderer for final frame", 0);
-            waitForFrame(END_OF_RENDER_FRAME);
+    }
 
-            //let the next know we're done
-            SetGenericStatus("%s: Notifying next renderer of final frame", 0);
-            FrameDone(END_OF_RENDER_FRAME);
-            xLights->CallAfter(&xLightsFrame::SetStatusText, wxString("Done Rendering \"" + rowToRender->GetModelName() + "\""), 0);
-        } else {
-            xLights->CallAfter(&xLightsFrame::RenderDone);
+    void InitPerModelBuffers(PixelBufferClass *buffer) {
+        const Model *model = buffer->GetModel();
+        if ("ModelGroup" == model->GetDisplayAs()) {
+            //for (int l = 0; l < numLayers; ++l) {
+            for (int l = numLayers - 1; l >= 0; --l) {
+                EffectLayer *layer = rowToRender->GetEffectLayer(l);
+                bool perModelEffects = false;
+                for (int e = 0; e < layer->GetEffectCount() && !perModelEffects; ++e) {
+                    static const std::string CHOICE_BufferStyle("B_CHOICE_BufferStyle");
+                    static const std::string DEFAULT("Default");
+                    static const std::string PER_MODEL("Per Model");
+                    const std::string &bt = layer->GetEffect(e)->GetSettings().Get(CHOICE_BufferStyle, DEFAULT);
+                    if (bt.compare(0, 9, PER_MODEL) == 0) {
+                        perModelEffects = true;
+                    }
+                }
+                if (perModelEffects) {
+                    const ModelGroup *grp = dynamic_cast<const ModelGroup*>(model);
+                    buffer->InitPerModelBuffers(*grp, l, seqData->FrameTime());
+                }
+            }
         }
-        rowToRender->CleanupAfterRender();
-        currentFrame = END_OF_RENDER_FRAME;
-        //printf("Done rendering %lx (next %lx)\n", (unsigned long)this, (unsigned long)next);
-		renderLog.debug("Rendering thread exiting.");
-	}
+    }
 
-    void AbortRender() {
-        abort = true;
+    int GetRenderChunkCount() const {
+        int chunks = (endFrame - startFrame + 1) / MIN_FRAMES_PER_RENDER_CHUNK;
+        return std::min(chunks, (int)std::thread::hardware_concurrency());
     }
 
-    ModelElement* GetModelElement() const { return rowToRender; }
+    // A model can have its frames rendered out of order when nothing else writes to its channels first and every
+    // effect in the range can render any frame without having rendered the ones before it
+    bool CanRenderFramesInParallel() {
+        static const std::string CHECKBOX_OverlayBkg("CHECKBOX_OverlayBkg");
+        static const std::string SPINCTRL_FreezeEffectAtFrame("SPINCTRL_FreezeEffectAtFrame");
 
-private:
+        if (GetRenderChunkCount() < 2 || supportsModelBlending || !subModelInfos.empty() || !nodeBuffers.empty()
+            || GetPreviousFrameDone() != END_OF_RENDER_FRAME) {
+            return false;
+        }
+
+        int startMS = startFrame * seqData->FrameTime();
+        int endMS = (endFrame + 1) * seqData->FrameTime();
+        for (int layer = 0; layer < numLayers; ++layer) {
+            EffectLayer *elayer = rowToRender->GetEffectLayer(layer);
+            std::unique_lock<std::recursive_mutex> elock(elayer->GetLock());
+            for (int e = 0; e < elayer->GetEffectCount(); ++e) {
+                Effect *ef = elayer->GetEffect(e);
+                if (ef->GetEndTimeMS() <= startMS || ef->GetStartTimeMS() >= endMS || ef->GetEffectIndex() == -1) {
+                    continue;
+                }
+                RenderableEffect *reff = xLights->GetEffectManager().GetEffect(ef->GetEffectIndex());
+                if (reff == nullptr || !reff->CanRenderPartialTimeInterval()) {
+                    return false;
+                }
+                // persistent and frozen layers carry the previous frame forward
+                SettingsMap settingsMap;
+                ef->CopySettingsMap(settingsMap, true);
+                if (settingsMap.GetBool(CHECKBOX_OverlayBkg) || settingsMap.GetInt(SPINCTRL_FreezeEffectAtFrame, 99999) != 99999) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Split the frame range into chunks, each with its own PixelBufferClass, and render the chunks concurrently.
+    // The buffers are set up here on the job thread. The chunks run on their own threads rather than the
+    // parallel_for pool as rendering a frame uses parallel_for itself and a pool worker waiting on jobs queued
+    // behind it on the same pool can deadlock.
+    void RenderFramesInParallel(int origChangeCount) {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        int chunks = GetRenderChunkCount();
+        int first = startFrame;
+        int last = endFrame;
+        int perChunk = (last - first + chunks) / chunks;
+        renderLog.debug("Rendering %s frames %d to %d in %d chunks.", (const char *)name.c_str(), first, last, chunks);
+
+        std::vector<std::unique_ptr<EffectLayerInfo>> infos;
+        for (int c = 0; c < chunks; ++c) {
+            EffectLayerInfo *info = new EffectLayerInfo(numLayers);
+            info->element = rowToRender;
+            infos.emplace_back(info);
+            PixelBufferClass *buffer = mainBuffer;
+            if (c != 0) {
+                info->buffer.reset(new PixelBufferClass(xLights));
+                if (!xLights->InitPixelBuffer(name, *info->buffer, numLayers, zeroBased)) {
+                    logger_base.warn("Unable to create render buffers for %s, rendering frames in order.", (const char *)name.c_str());
+                    RenderFrames(origChangeCount);
+                    return;
+                }
+                InitPerModelBuffers(info->buffer.get());
+                buffer = info->buffer.get();
+            }
+            int chunkStart = first + c * perChunk;
+            for (int layer = numLayers - 1; layer >= 0; --layer) {
+                EffectLayer *elayer = rowToRender->GetEffectLayer(layer);
+                std::unique_lock<std::recursive_mutex> elock(elayer->GetLock());
+                info->currentEffects[layer] = findEffectForFrame(elayer, chunkStart, info->currentEffectIdxs[layer]);
+                initialize(layer, chunkStart, info->currentEffects[layer], info->settingsMaps[layer], buffer);
+                info->effectStates[layer] = true;
+            }
+        }
+
+        std::atomic_bool bailed(false);
+        chunkFramesDone = 0;
+        auto renderChunk = [&](int c) {
+            EffectLayerInfo &info = *infos[c];
+            PixelBufferClass *buffer = c == 0 ? mainBuffer : info.buffer.get();
+            int chunkEnd = std::min(last, first + (c + 1) * perChunk - 1);
+            RenderEvent event;
+            try {
+                for (int frame = first + c * perChunk; frame <= chunkEnd; ++frame) {
+                    if (abort || bailed) {
+                        break;
+                    }
+                    if (!HasNext() && (origChangeCount != rowToRender->getChangeCount() || rowToRender->GetWaitCount())) {
+                        bailed = true;
+                        break;
+                    }
+                    SequenceData::FramePin pin(*seqData, frame);
+                    ProcessFrame(frame, rowToRender, info, buffer, -1, false, &event, c == 0);
+                    chunkFramesDone++;
+                }
+            } catch (std::exception &ex) {
+                wxASSERT(false); // so when we debug we catch them
+                renderLog.error("Caught an exception on rendering thread: " + std::string(ex.what()));
+                logger_base.error("Caught an exception on rendering thread: %s", ex.what());
+            } catch (...) {
+                wxASSERT(false); // so when we debug we catch them
+                renderLog.error("Caught an unknown exception on rendering thread.");
+                logger_base.error("Caught an unknown exception on rendering thread.");
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int c = 1; c < chunks; ++c) {
+            threads.emplace_back(renderChunk, c);
+        }
+        renderChunk(0);
+        for (auto &t : threads) {
+            t.join();
+        }
+        currentFrame = last;
+        chunkFramesDone = -1;
+        // the status map points into the chunk infos which are about to go away
+        statusMap = nullptr;
+        for (int c = 1; c < chunks; ++c) {
+            mainBuffer->AddColorsStats(*infos[c]->buffer);
+        }
+
+        if (bailed && !abort) {
+            //we're bailing out but make sure this range is reconsidered
+            rowToRender->SetDirtyRange(first * seqData->FrameTime(), last * seqData->FrameTime());
+        }
+        else if (!abort && xLights->_verifyChunkedRender) {
+            VerifyParallelRender(origChangeCount);
+        }
+        if (HasNext()) {
+            FrameDone(last);
+        }
+        SetGenericStatus("%s: All done - Completed frame %d " + PrintStatusMap(), last, true);
+    }
+
+    // Keep the chunked output for this model, render the range again in order and log every frame that differs.
+    // The in order output is what is left in the sequence data.
+    void VerifyParallelRender(int origChangeCount) {
+        static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        const Model *model = mainBuffer->GetModel();
+        uint32_t firstChannel = model->GetFirstChannel();
+        uint32_t channels = model->GetLastChannel() - firstChannel + 1;
+        if (firstChannel + channels > seqData->NumChannels()) {
+            return;
+        }
+
+        std::vector<unsigned char> chunked((endFrame - startFrame + 1) * channels);
+        for (int frame = startFrame; frame <= endFrame; ++frame) {
+            SequenceData::FramePin pin(*seqData, frame);
+            memcpy(&chunked[(frame - startFrame) * channels], &(*seqData)[frame][firstChannel], channels);
+        }
+
+        RenderFrames(origChangeCount);
+
+        int differences = 0;
+        for (int frame = startFrame; frame <= endFrame; ++frame) {
+            SequenceData::FramePin pin(*seqData, frame);
+            if (memcmp(&chunked[(frame - startFrame) * channels], &(*seqData)[frame][firstChannel], channels) != 0) {
+                if (differences == 0) {
+                    logger_base.warn("Chunked render of %s differs from in order render at frame %d.", (const char *)name.c_str(), frame);
+                }
+                differences++;
+            }
+        }
+        logger_base.info("Verified chunked render of %s frames %d to %d, %d frames differ.", (const char *)name.c_str(), (int)startFrame, (int)endFrame, differences);
+    }
 
     void initialize(int layer, int frame, Effect *el, SettingsMap &settingsMap, PixelBufferClass *buffer) {
         if (el == nullptr || el->GetEffectIndex() == -1) {
@@ -900,11 +1109,13 @@ private:
 
     wxGauge *gauge;
     std::atomic_int currentFrame;
+    std::atomic_int chunkFramesDone;
     std::atomic_bool abort;
 
     std::vector<EffectLayerInfo *> subModelInfos;
 
     std::map<SNPair, PixelBufferClassPtr> nodeBuffers;
+    bool zeroBased;
 };
 
 
@@ -993,7 +1204,7 @@ void xLightsFrame::LogRenderStatus()
         for (int i = 0; i < it->numRows; i++) {
             if (it->jobs[i] != nullptr) {
                 auto job = it->jobs[i];
-                int curFrame = job->GetCurrentFrame();
+                int curFrame = job->GetProgressFrame();
                 if (curFrame > it->endFrame || curFrame == END_OF_RENDER_FRAME) {
                     curFrame = it->endFrame;
                 }
@@ -1068,7 +1279,7 @@ void xLightsFrame::UpdateRenderStatus() {
         for (size_t row = 0; row < rpi->numRows; ++row) {
 
             if (rpi->jobs[row]) {
-                int i = rpi->jobs[row]->GetCurrentFrame();
+                int i = rpi->jobs[row]->GetProgressFrame();
                 if (i > rpi->jobs[row]->GetEndFrame()) {
                     i = END_OF_RENDER_FRAME;
                 }
@@ -1143,6 +1354,9 @@ void xLightsFrame::UpdateRenderStatus() {
 void xLightsFrame::RenderDone()
 {
     mainSequencer->PanelEffectGrid->Refresh();
+    if (SeqData.IsPaged()) {
+        SeqData.LogPagingStats();
+    }
 }
 
 class RenderTreeData {
@@ -796,7 +796,28 @@ double RenderBuffer::RandomRange(double num1, double num2) const
         lo = num2;
         hi = num1;
     }
-    return rand01()*(hi-lo)+ lo;
+    return Rand01()*(hi-lo)+ lo;
+}
+
+// Seed from the model, effect times and the caller supplied salt (the layer) so the
+// same effect always gets the same random stream no matter which thread renders it
+void RenderBuffer::SeedRandom(uint32_t salt)
+{
+    uint64_t h = 14695981039346656037ULL;
+    auto mix = [&h](uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            h ^= (v >> (i * 8)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+    };
+    for (const auto c : cur_model) {
+        h ^= (uint8_t)c;
+        h *= 1099511628211ULL;
+    }
+    mix(curEffStartPer);
+    mix(curEffEndPer);
+    mix(salt);
+    _random.Seed(h);
 }
 
 void RenderBuffer::Color2HSV(const xlColor& color, HSVValue& hsv) const
@@ -1433,6 +1454,7 @@ RenderBuffer::RenderBuffer(RenderBuffer& buffer)
     ModelBufferHt = buffer.ModelBufferHt;
     ModelBufferWi = buffer.ModelBufferWi;
     infoCache = buffer.infoCache;
+    _random = buffer._random;
 
     pixels = buffer.pixels;
     _textDrawingContext = buffer._textDrawingContext;
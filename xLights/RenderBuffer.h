@@ -11,6 +11,7 @@
  **************************************************************/
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <map>
 #include <list>
 #include <vector>
@@ -390,6 +391,42 @@ public:
 	virtual ~EffectRenderCache();
 };
 
+// Small fast PRNG (xoshiro128**). Each RenderBuffer owns one so effects draw from
+// their own stream instead of the shared global rand() and renders come out the
+// same regardless of how many render threads are running.
+class RenderRandom {
+public:
+    void Seed(uint64_t seed)
+    {
+        // splitmix64 to spread the seed over the whole state
+        for (int i = 0; i < 4; i += 2) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            s[i] = (uint32_t)z;
+            s[i + 1] = (uint32_t)(z >> 32);
+        }
+    }
+    uint32_t Next()
+    {
+        const uint32_t result = rotl(s[1] * 5, 7) * 9;
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+private:
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+    uint32_t s[4] = { 0x9E3779B9, 0x243F6A88, 0xB7E15162, 0x6A09E667 };
+};
+
 class /*NCCDLLEXPORT*/ RenderBuffer {
 public:
     RenderBuffer(xLightsFrame *frame);
@@ -458,6 +495,11 @@ public:
     void GetMultiColorBlend(float n, bool circular, xlColor &color, int reserveColors = 0);
     void SetRangeColor(const HSVValue& hsv1, const HSVValue& hsv2, HSVValue& newhsv);
     double RandomRange(double num1, double num2) const;
+
+    // drop in replacements for rand() and rand01(), reseeded at the start of each effect
+    int Rand() const { return (int)(_random.Next() % ((uint32_t)RAND_MAX + 1)); }
+    double Rand01() const { return (double)Rand() / (double)RAND_MAX; }
+    void SeedRandom(uint32_t salt);
     void Color2HSV(const xlColor& color, HSVValue& hsv) const;
     const PaletteClass& GetPalette() const { return palette; }
 
@@ -515,6 +557,7 @@ private:
     std::vector<NodeBaseClassPtr> Nodes;
     PathDrawingContext *_pathDrawingContext = nullptr;
     TextDrawingContext *_textDrawingContext = nullptr;
+    mutable RenderRandom _random;
 
     void SetPixelDMXModel(int x, int y, const xlColor& color);
     void Forget();
@@ -14,6 +14,8 @@
 #include "UtilFunctions.h"
 
 #include <log4cpp/Category.hh>
+#include <zstd.h>
+#include <set>
 
 #ifdef __WXOSX__
 #include <sys/mman.h>
@@ -28,6 +30,57 @@
 
 const unsigned char FrameData::_constzero = 0;
 
+// paging is off unless it is turned on in the settings
+size_t SequenceData::PAGED_MEMORY_LIMIT = 0;
+// pages are roughly this size, at least one frame
+#define PAGE_TARGET_SIZE (16 * 1024 * 1024)
+// never squeeze the resident pages below this many regardless of the limit
+#define MIN_RESIDENT_PAGES 8
+
+// Paged sequences by their paged id so a thread that exits can drop the pages it had pinned
+// through operator[] on any sequence still alive
+static std::mutex __pagedSequencesLock;
+static std::map<uint64_t, SequenceData*> __pagedSequences;
+static std::atomic_uint64_t __nextPagedId(1);
+
+namespace
+{
+    struct ThreadPages
+    {
+        uint64_t lastId = 0;        // the sequence and page this thread used last, it is pinned so
+        unsigned int lastPage = 0;  // using it again needs no lock
+        std::set<uint64_t> used;
+
+        ~ThreadPages()
+        {
+            std::unique_lock<std::mutex> lock(__pagedSequencesLock);
+            for (const auto& it : used) {
+                auto s = __pagedSequences.find(it);
+                if (s != __pagedSequences.end()) {
+                    s->second->ReleaseImplicitPins(std::this_thread::get_id());
+                }
+            }
+        }
+    };
+    thread_local ThreadPages __threadPages;
+}
+
+static uint64_t HashPage(const unsigned char* data, size_t size)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    size_t words = size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        memcpy(&w, data + i * sizeof(uint64_t), sizeof(uint64_t));
+        h = (h ^ w) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < size; ++i) {
+        h = (h ^ data[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
 SequenceData::SequenceData() : _invalidFrame()
 {
     _numFrames = 0;
@@ -56,6 +109,21 @@ SequenceData::DataBlock::~DataBlock()
 
 void SequenceData::Cleanup()
 {
+    if (!_pages.empty()) {
+        LogPagingStats();
+    }
+    if (_pagedId != 0) {
+        std::unique_lock<std::mutex> lock(__pagedSequencesLock);
+        __pagedSequences.erase(_pagedId);
+        _pagedId = 0;
+    }
+    _implicitPins.clear();
+    _lru.clear();
+    _overLimitLogged = false;
+    _pages.clear();
+    _residentBytes = 0;
+    _framesPerPage = 0;
+    _pageSize = 0;
     _frames.clear();
     for (auto& p : _dataBlocks) {
         if (p.get() && p.get()->type == BlockType::HUGE_PAGE) {
@@ -212,7 +280,10 @@ void SequenceData::init(unsigned int numChannels, unsigned int numFrames, unsign
     _frameTime = frameTime;
     _bytesPerFrame = roundTo4(numChannels);
 
-    if (numFrames > 0 && numChannels > 0) {
+    if (numFrames > 0 && numChannels > 0 && PAGED_MEMORY_LIMIT != 0 && (size_t)_bytesPerFrame * (size_t)_numFrames > PAGED_MEMORY_LIMIT) {
+        InitPages();
+    }
+    else if (numFrames > 0 && numChannels > 0) {
         _frames.reserve(numFrames);
         size_t sizeRemaining = (size_t)_bytesPerFrame * (size_t)_numFrames;
         size_t blockSize = 0;
@@ -235,6 +306,244 @@ void SequenceData::init(unsigned int numChannels, unsigned int numFrames, unsign
     _invalidFrame._numChannels = _numChannels;
 }
 
+void SequenceData::InitPages()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    _framesPerPage = std::max(1u, (unsigned int)(PAGE_TARGET_SIZE / _bytesPerFrame));
+    _pageSize = (size_t)_framesPerPage * (size_t)_bytesPerFrame;
+    unsigned int numPages = (_numFrames + _framesPerPage - 1) / _framesPerPage;
+    _pages.reserve(numPages);
+    for (unsigned int page = 0; page < numPages; ++page) {
+        _pages.push_back(std::make_unique<Page>());
+    }
+    // pages that have never been written need no memory at all, frames get their pointers when their page is loaded
+    _frames.reserve(_numFrames);
+    for (unsigned int frame = 0; frame < _numFrames; ++frame) {
+        _frames.push_back(FrameData(_numChannels, nullptr));
+    }
+    _pageLoads = 0;
+    _pageEvictions = 0;
+    _pageLoadMicros = 0;
+    _pageEvictMicros = 0;
+    _pagedId = __nextPagedId++;
+    {
+        std::unique_lock<std::mutex> lock(__pagedSequencesLock);
+        __pagedSequences[_pagedId] = this;
+    }
+    logger_base.debug("Sequence data is paged. Frames=%d, Channels=%d, Pages=%d of %d frames, Resident limit=%ld.",
+        _numFrames, _numChannels, numPages, _framesPerPage, std::max(PAGED_MEMORY_LIMIT, _pageSize * MIN_RESIDENT_PAGES));
+}
+
+// must hold _pageLock
+void SequenceData::MakeResident(unsigned int page)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    Page& p = *_pages[page];
+    if (p.resident) {
+        if (!p.unevictable) {
+            _lru.splice(_lru.begin(), _lru, p.lru);
+        }
+        return;
+    }
+    wxStopWatch sw;
+
+    // make room by dropping the least recently used unpinned pages
+    size_t limit = std::max(PAGED_MEMORY_LIMIT, _pageSize * MIN_RESIDENT_PAGES);
+    while (_residentBytes + _pageSize > limit) {
+        auto victim = _lru.rbegin();
+        while (victim != _lru.rend() && _pages[*victim]->pins != 0) {
+            ++victim;
+        }
+        if (victim == _lru.rend()) {
+            // every resident page is in use by a frame being worked on right now, better to go over the limit than fail
+            if (!_overLimitLogged) {
+                _overLimitLogged = true;
+                logger_base.warn("Sequence data paging went over its memory limit as all %d resident pages are pinned.", (int)(_residentBytes / _pageSize));
+            }
+            break;
+        }
+        unsigned int v = *victim;
+        if (!EvictPage(v)) {
+            // it stays resident but is no longer a candidate
+            _pages[v]->unevictable = true;
+            _lru.erase(_pages[v]->lru);
+        }
+    }
+
+    p.data.reset(new unsigned char[_pageSize]);
+    if (p.compressed.empty()) {
+        memset(p.data.get(), 0, _pageSize);
+    }
+    else {
+        size_t sz = ZSTD_decompress(p.data.get(), _pageSize, p.compressed.data(), p.compressed.size());
+        if (ZSTD_isError(sz) || sz != _pageSize) {
+            logger_base.error("Sequence data page %d could not be decompressed: %s", page, ZSTD_isError(sz) ? ZSTD_getErrorName(sz) : "short page");
+            memset(p.data.get(), 0, _pageSize);
+        }
+    }
+    unsigned int first = page * _framesPerPage;
+    unsigned int last = std::min(_numFrames, first + _framesPerPage);
+    for (unsigned int frame = first; frame < last; ++frame) {
+        _frames[frame]._data = p.data.get() + (size_t)(frame - first) * (size_t)_bytesPerFrame;
+    }
+    _residentBytes += _pageSize;
+    p.hash = HashPage(p.data.get(), _pageSize);
+    p.resident = true;
+    _lru.push_front(page);
+    p.lru = _lru.begin();
+
+    ++_pageLoads;
+    _pageLoadMicros += sw.TimeInMicro().GetValue();
+}
+
+// must hold _pageLock, returns false if the page could not be compressed and is still resident
+bool SequenceData::EvictPage(unsigned int page)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    Page& p = *_pages[page];
+    wxStopWatch sw;
+
+    // pages that were only read still have a good compressed copy
+    if (HashPage(p.data.get(), _pageSize) != p.hash) {
+        std::vector<unsigned char> buf(ZSTD_compressBound(_pageSize));
+        size_t sz = ZSTD_compress(buf.data(), buf.size(), p.data.get(), _pageSize, 1);
+        if (ZSTD_isError(sz)) {
+            logger_base.error("Sequence data page %d could not be compressed so it will be kept in memory: %s", page, ZSTD_getErrorName(sz));
+            return false;
+        }
+        buf.resize(sz);
+        buf.shrink_to_fit();
+        p.compressed.swap(buf);
+    }
+
+    p.resident = false;
+    _lru.erase(p.lru);
+    unsigned int first = page * _framesPerPage;
+    unsigned int last = std::min(_numFrames, first + _framesPerPage);
+    for (unsigned int frame = first; frame < last; ++frame) {
+        _frames[frame]._data = nullptr;
+    }
+    p.data.reset();
+    _residentBytes -= _pageSize;
+
+    ++_pageEvictions;
+    _pageEvictMicros += sw.TimeInMicro().GetValue();
+    return true;
+}
+
+// must hold _pageLock
+void SequenceData::ImplicitPin(unsigned int page)
+{
+    auto it = _implicitPins.find(std::this_thread::get_id());
+    if (it == _implicitPins.end()) {
+        std::array<int, IMPLICIT_PINS> none;
+        none.fill(-1);
+        it = _implicitPins.emplace(std::this_thread::get_id(), none).first;
+    }
+    auto& pins = it->second;
+
+    // most recently used first, dropping the oldest if the page is not there already
+    int i = 0;
+    while (i < IMPLICIT_PINS - 1 && pins[i] != (int)page) {
+        ++i;
+    }
+    if (pins[i] != (int)page) {
+        if (pins[i] >= 0) {
+            --_pages[pins[i]]->pins;
+        }
+        ++_pages[page]->pins;
+    }
+    for (; i > 0; --i) {
+        pins[i] = pins[i - 1];
+    }
+    pins[0] = page;
+}
+
+void SequenceData::ReleaseImplicitPins(std::thread::id thread)
+{
+    std::unique_lock<std::mutex> lock(_pageLock);
+    auto it = _implicitPins.find(thread);
+    if (it == _implicitPins.end()) {
+        return;
+    }
+    for (const auto& page : it->second) {
+        if (page >= 0) {
+            --_pages[page]->pins;
+        }
+    }
+    _implicitPins.erase(it);
+}
+
+void SequenceData::ReleaseThreadPins()
+{
+    if (_pagedId == 0) {
+        return;
+    }
+    // the fast path in PagedFrame relies on the last page being pinned
+    ThreadPages& tp = __threadPages;
+    if (tp.lastId == _pagedId) {
+        tp.lastId = 0;
+    }
+    ReleaseImplicitPins(std::this_thread::get_id());
+}
+
+FrameData& SequenceData::PagedFrame(unsigned int frame)
+{
+    unsigned int page = frame / _framesPerPage;
+    ThreadPages& tp = __threadPages;
+    if (tp.lastId != _pagedId || tp.lastPage != page) {
+        {
+            std::unique_lock<std::mutex> lock(_pageLock);
+            ImplicitPin(page);
+            MakeResident(page);
+        }
+        tp.lastId = _pagedId;
+        tp.lastPage = page;
+        tp.used.insert(_pagedId);
+    }
+    return _frames[frame];
+}
+
+SequenceData::FramePin::FramePin(SequenceData& data, unsigned int frame)
+{
+    if (data.IsPaged() && frame < data._numFrames) {
+        _data = &data;
+        _page = data._pages[frame / data._framesPerPage].get();
+        std::unique_lock<std::mutex> lock(data._pageLock);
+        ++_page->pins;
+        data.MakeResident(frame / data._framesPerPage);
+    }
+}
+
+SequenceData::FramePin::~FramePin()
+{
+    if (_page != nullptr) {
+        --_page->pins;
+        // the frame is done with so anything this thread pinned while working on it can go too
+        _data->ReleaseThreadPins();
+    }
+}
+
+void SequenceData::LogPagingStats()
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    std::unique_lock<std::mutex> lock(_pageLock);
+    size_t compressed = 0;
+    for (const auto& it : _pages) {
+        compressed += it->compressed.size();
+    }
+    uint64_t loads = _pageLoads;
+    uint64_t evictions = _pageEvictions;
+    logger_base.debug("Sequence data paging: Resident=%ldMB, Compressed=%ldMB, Uncompressed size=%ldMB, Loads=%llu (avg %lluus), Evictions=%llu (avg %lluus).",
+        _residentBytes / (1024 * 1024), compressed / (1024 * 1024), ((size_t)_bytesPerFrame * _numFrames) / (1024 * 1024),
+        (unsigned long long)loads, (unsigned long long)(loads == 0 ? 0 : _pageLoadMicros / loads),
+        (unsigned long long)evictions, (unsigned long long)(evictions == 0 ? 0 : _pageEvictMicros / evictions));
+}
+
 // This encodes the sequence data grouped by channel
 wxString SequenceData::base64_encode()
 {
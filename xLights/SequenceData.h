@@ -11,7 +11,13 @@
  **************************************************************/
 
 #include <wx/wx.h>
+#include <array>
+#include <atomic>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 class FrameData {
     FrameData(const FrameData&) = delete;
@@ -68,6 +74,38 @@ class SequenceData {
         BlockType type;
     };
     static std::list<std::unique_ptr<DataBlock>> HUGE_BLOCK_CACHE;
+
+    // In paged mode frames are grouped into pages which are zstd compressed when they
+    // have not been used recently and decompressed again when a frame on them is accessed
+    class Page {
+    public:
+        std::unique_ptr<unsigned char[]> data;  // uncompressed frames while resident
+        std::vector<unsigned char> compressed;  // empty if the page has never been written
+        uint64_t hash = 0;                      // of the data when it was loaded, a page with the same hash is not recompressed
+        std::atomic_bool resident{ false };
+        std::atomic_bool unevictable{ false };  // compressing it failed so it has to stay resident
+        std::atomic_int pins{ 0 };
+        std::list<unsigned int>::iterator lru;  // position in _lru while resident and evictable
+    };
+    static size_t PAGED_MEMORY_LIMIT;
+    std::vector<std::unique_ptr<Page>> _pages;
+    unsigned int _framesPerPage = 0;
+    size_t _pageSize = 0;
+    size_t _residentBytes = 0;
+    std::list<unsigned int> _lru; // resident pages that can be evicted, most recently used first
+    bool _overLimitLogged = false;
+    std::mutex _pageLock;
+    // Each thread using operator[] keeps the last few pages it used that way pinned. A pointer it got from
+    // operator[] stays valid until it has moved on to IMPLICIT_PINS other pages, a FramePin it holds goes
+    // away or it calls ReleaseThreadPins.
+    static const int IMPLICIT_PINS = 4;
+    std::map<std::thread::id, std::array<int, IMPLICIT_PINS>> _implicitPins;
+    uint64_t _pagedId = 0; // unique for each paged init so a thread never confuses it with an earlier sequence
+    // paging statistics
+    std::atomic_uint64_t _pageLoads{ 0 };
+    std::atomic_uint64_t _pageEvictions{ 0 };
+    std::atomic_uint64_t _pageLoadMicros{ 0 };
+    std::atomic_uint64_t _pageEvictMicros{ 0 };
     
     FrameData _invalidFrame;
     std::vector<FrameData> _frames;
@@ -84,7 +122,34 @@ class SequenceData {
 
     void Cleanup();
     unsigned char *AllocBlock(size_t requested, size_t &szAllocated);
+    void InitPages();
+    void MakeResident(unsigned int page);
+    bool EvictPage(unsigned int page);
+    void ImplicitPin(unsigned int page);
+    FrameData &PagedFrame(unsigned int frame);
 public:
+    // Keeps a frame's page resident while it exists. In paged mode anything that holds on to
+    // frame data rather than using it immediately (a render job working on a frame) should pin it.
+    class FramePin {
+        FramePin(const FramePin&) = delete;
+        FramePin &operator=(const FramePin&) = delete;
+        SequenceData *_data = nullptr;
+        Page *_page = nullptr;
+    public:
+        FramePin(SequenceData &data, unsigned int frame);
+        ~FramePin();
+    };
+
+    // Sequences needing more than this many bytes of frame data are paged, 0 turns paging off
+    static void SetPagedMemoryLimit(size_t bytes) { PAGED_MEMORY_LIMIT = bytes; }
+    bool IsPaged() const { return !_pages.empty(); }
+    // drops the pages a thread pinned through operator[], called as the thread exits
+    void ReleaseImplicitPins(std::thread::id thread);
+    // drops the pages the calling thread pinned through operator[], for when it has finished with a frame
+    // or a job and is not holding on to any frame data
+    void ReleaseThreadPins();
+    void LogPagingStats();
+
     SequenceData();
     virtual ~SequenceData();
     
@@ -96,19 +161,25 @@ public:
         if (frame >= _numFrames) {
             return _invalidFrame;
         }
+        if (!_pages.empty()) {
+            return PagedFrame(frame);
+        }
         return _frames[frame];
     }
     const FrameData &operator[](unsigned int frame) const {
         if (frame >= _numFrames) {
             return _invalidFrame;
         }
+        if (!_pages.empty()) {
+            return const_cast<SequenceData*>(this)->PagedFrame(frame);
+        }
         return _frames[frame];
     }
     
     unsigned int NumChannels() const { return _numChannels;}
     unsigned int NumFrames() const { return _numFrames;}
     unsigned int FrameTime() const { return _frameTime;}
-    bool IsValidData() const { return !_dataBlocks.empty(); }
+    bool IsValidData() const { return !_dataBlocks.empty() || !_pages.empty(); }
 
     // encodes contents of SeqData in channel order
     wxString base64_encode();
@@ -19,6 +19,7 @@
 #include <wx/imaggif.h>
 #include <wx/anidecod.h>
 #include <wx/quantize.h>
+#include <wx/thread.h>
 
 extern "C"
 {
@@ -46,6 +47,11 @@ extern "C"
 
 void xLightsFrame::ConversionError(const wxString& msg)
 {
+    // batch renders write fseq files on the job pool so errors can arrive off the main thread
+    if (!wxThread::IsMain()) {
+        CallAfter(&xLightsFrame::ConversionError, msg);
+        return;
+    }
     DisplayError(msg.ToStdString());
 }
 
@@ -1332,15 +1338,20 @@ void xLightsFrame:: ReadXlightsFile(const wxString& FileName, wxString *mediaFil
 }
 
 void xLightsFrame:: WriteFalconPiFile(const wxString& filename)
+{
+    WriteFalconPiFile(filename, SeqData, mediaFilename);
+}
+
+void xLightsFrame::WriteFalconPiFile(const wxString& filename, SequenceData& data, wxString& media)
 {
     ConvertParameters write_params(filename,                                     // filename
-                                   SeqData,                                      // sequence data object
+                                   data,                                         // sequence data object
                                    &_outputManager,                               // global network info
                                    ConvertParameters::READ_MODE_LOAD_MAIN,       // file read mode
                                    this,                                         // xLights main frame
                                    nullptr,
                                    nullptr,
-                                   &mediaFilename, // media filename
+                                   &media,         // media filename
                                    nullptr,
                                    filename);
     
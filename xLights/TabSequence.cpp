@@ -13,6 +13,9 @@
 #include <wx/clipbrd.h>
 #include <wx/xml/xml.h>
 #include <wx/config.h>
+#include <wx/file.h>
+#include <wx/process.h>
+#include <wx/stdpaths.h>
 
 #include "xLightsMain.h"
 #include "SeqSettingsDialog.h"
@@ -919,12 +922,14 @@ static void AddModelsToPreview(ModelGroup *grp, std::vector<Model *> &PreviewMod
 
 void xLightsFrame::UpdateModelsList()
 {
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     static log4cpp::Category& logger_work = log4cpp::Category::getInstance(std::string("log_work"));
     logger_work.debug("        UpdateModelsList.");
 
     if (ModelsNode == nullptr) return; // this happens when xlights is first loaded
     if (ViewObjectsNode == nullptr) return; // this happens when xlights is first loaded
 
+    wxStopWatch sw;
     playModel = nullptr;
     PreviewModels.clear();
     UnselectEffect();
@@ -932,6 +937,7 @@ void xLightsFrame::UpdateModelsList()
     AllModels.LoadModels(ModelsNode,
         modelPreview->GetVirtualCanvasWidth(),
         modelPreview->GetVirtualCanvasHeight());
+    long modelsTime = sw.Time();
 
     AllObjects.LoadViewObjects(ViewObjectsNode);
 
@@ -1018,9 +1024,12 @@ void xLightsFrame::UpdateModelsList()
             }
         }
     }
+    long groupsStart = sw.Time();
     AllModels.LoadGroups(ModelGroupsNode,
         modelPreview->GetVirtualCanvasWidth(),
         modelPreview->GetVirtualCanvasHeight());
+    long groupsTime = sw.Time() - groupsStart;
+    long previewStart = sw.Time();
 
     wxString msg;
 
@@ -1047,12 +1056,257 @@ void xLightsFrame::UpdateModelsList()
 
     layoutPanel->UpdateModelList(true);
     displayElementsPanel->UpdateModelsForSelectedView();
+
+    logger_base.debug("UpdateModelsList took %ldms: models %ldms, groups %ldms, preview setup %ldms.",
+        sw.Time(), modelsTime, groupsTime, sw.Time() - previewStart);
+}
+
+// Writes a rendered copy of a batch sequence to its fseq file on the render job pool so
+// the batch can open and render the next sequence while this one is compressed and saved
+class BatchFseqWriteJob : public Job
+{
+public:
+    BatchFseqWriteJob(xLightsFrame* frame, SequenceData* data, const wxString& filename, const wxString& media, size_t statIndex)
+        : _frame(frame), _data(data), _filename(filename), _media(media), _statIndex(statIndex)
+    {
+    }
+    virtual ~BatchFseqWriteJob()
+    {
+        delete _data;
+    }
+
+    virtual void Process() override
+    {
+        wxStopWatch sw;
+        size_t bytes = (size_t)_data->NumChannels() * (size_t)_data->NumFrames();
+        _frame->WriteFalconPiFile(_filename, *_data, _media);
+        delete _data;
+        _data = nullptr;
+        _frame->BatchFseqWriteDone(_statIndex, bytes, sw.Time());
+    }
+    virtual bool DeleteWhenComplete() override { return true; }
+    virtual const std::string GetName() const override { return "FSEQ Write"; }
+
+private:
+    xLightsFrame* _frame;
+    SequenceData* _data;
+    wxString _filename;
+    wxString _media;
+    size_t _statIndex;
+};
+
+void xLightsFrame::BatchFseqWriteDone(size_t statIndex, size_t bytes, long writeMS)
+{
+    std::unique_lock<std::mutex> lock(_batchWriteLock);
+    if (statIndex < _batchRenderStats.size()) {
+        _batchRenderStats[statIndex].writeMS = writeMS;
+    }
+    _batchWriteBytes -= bytes;
+    _batchWritesPending--;
+    _batchWriteSignal.notify_all();
+}
+
+void xLightsFrame::WaitForBatchFseqWrites(size_t bytesNeeded, size_t budget)
+{
+    std::unique_lock<std::mutex> lock(_batchWriteLock);
+    _batchWriteSignal.wait(lock, [this, bytesNeeded, budget] {
+        return _batchWritesPending == 0 || _batchWriteBytes + bytesNeeded <= budget;
+    });
+}
+
+void xLightsFrame::SaveBatchRenderedSequence(size_t statIndex)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    // sequences that fit in the memory budget are copied and written in the background,
+    // anything bigger is written here once the earlier writes have released their memory
+    size_t budget = (size_t)wxConfigBase::Get()->ReadLong("BatchRenderWriteMemoryMB", 1024) * 1024 * 1024;
+    size_t bytes = (size_t)SeqData.NumChannels() * (size_t)SeqData.NumFrames();
+    WaitForBatchFseqWrites(bytes, budget);
+
+    if (bytes > budget || bytes == 0) {
+        wxStopWatch sw;
+        WriteFalconPiFile(xlightsFilename);
+        std::unique_lock<std::mutex> lock(_batchWriteLock);
+        _batchRenderStats[statIndex].writeMS = sw.Time();
+        return;
+    }
+
+    SequenceData* data = new SequenceData();
+    data->init(SeqData.NumChannels(), SeqData.NumFrames(), SeqData.FrameTime(), false);
+    for (unsigned int f = 0; f < SeqData.NumFrames(); f++) {
+        memcpy(&(*data)[f][0], &SeqData[f][0], SeqData.NumChannels());
+    }
+    {
+        std::unique_lock<std::mutex> lock(_batchWriteLock);
+        _batchWriteBytes += bytes;
+        _batchWritesPending++;
+        _batchRenderStats[statIndex].backgroundWrite = true;
+    }
+    logger_base.info("Writing fseq file %s in the background.", (const char *)xlightsFilename.c_str());
+    jobPool.PushJob(new BatchFseqWriteJob(this, data, xlightsFilename, mediaFilename, statIndex));
+}
+
+void xLightsFrame::FinishBatchRender()
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    WaitForBatchFseqWrites(0, 0);
+
+    if (_batchRenderStats.empty()) return;
+
+    wxString report = "Sequence,Frames,Channels,Open ms,Render ms,Write ms,Background Write\n";
+    logger_base.info("Batch render report:");
+    for (const auto& it : _batchRenderStats) {
+        wxString line = wxString::Format("\"%s\",%u,%u,%ld,%ld,%ld,%s",
+            it.sequence, it.frames, it.channels, it.openMS, it.renderMS, it.writeMS, it.backgroundWrite ? "Y" : "N");
+        logger_base.info("    %s", (const char *)line.c_str());
+        report += line + "\n";
+    }
+    _batchRenderStats.clear();
+
+    // add the sequences the other render processes did
+    for (const auto& it : _batchRenderProcessReports) {
+        wxFile f;
+        wxString content;
+        if (wxFile::Exists(it) && f.Open(it) && f.ReadAll(&content)) {
+            f.Close();
+            content = content.AfterFirst('\n');
+            if (!content.empty()) {
+                logger_base.info("    %s", (const char *)content.Trim().c_str());
+                report += content;
+            }
+        }
+        else {
+            logger_base.warn("Render report %s from another render process is missing.", (const char *)it.c_str());
+        }
+        wxRemoveFile(it);
+    }
+    _batchRenderProcessReports.clear();
+
+    if (_renderReportFile != "") {
+        wxFile f;
+        if (f.Create(_renderReportFile, true) && f.IsOpened()) {
+            f.Write(report);
+            f.Close();
+            logger_base.info("Batch render report written to %s.", (const char *)_renderReportFile.c_str());
+        }
+        else {
+            logger_base.error("Unable to write batch render report %s.", (const char *)_renderReportFile.c_str());
+        }
+    }
+}
+
+class BatchRenderProcess : public wxProcess
+{
+    xLightsFrame* _frame;
+
+public:
+    BatchRenderProcess(xLightsFrame* frame) : wxProcess(), _frame(frame) {}
+
+    virtual void OnTerminate(int pid, int status) override
+    {
+        _frame->BatchRenderProcessEnded(pid, status);
+        delete this;
+    }
+};
+
+// The render pipeline works on the one SequenceElements/SequenceData the frame owns so
+// sequences are rendered at the same time by handing groups of them to other xLights
+// processes. This process keeps the first group. Each process has its own render thread
+// pool so this helps most when single sequences do not keep every core busy.
+void xLightsFrame::StartBatchRenderProcesses(wxArrayString& fileNames, int processes, const wxString& showDir, const wxString& mediaDir)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    processes = std::min(processes, (int)fileNames.size());
+    if (processes < 2) return;
+
+    std::vector<wxArrayString> groups(processes);
+    for (size_t i = 0; i < fileNames.size(); i++) {
+        groups[i % processes].Add(fileNames[i]);
+    }
+    fileNames = groups[0];
+
+    wxString exe = wxStandardPaths::Get().GetExecutablePath();
+    for (int p = 1; p < processes; p++) {
+        wxString cmd = "\"" + exe + "\" -r";
+        if (showDir != "") {
+            cmd += " -s \"" + showDir + "\"";
+        }
+        if (mediaDir != "" && mediaDir != showDir) {
+            cmd += " -m \"" + mediaDir + "\"";
+        }
+        if (_verifyChunkedRender) {
+            cmd += " --verifyrender";
+        }
+        if (_renderReportFile != "") {
+            wxString report = wxString::Format("%s.%d", _renderReportFile, p);
+            cmd += " --report \"" + report + "\"";
+            _batchRenderProcessReports.Add(report);
+        }
+        for (const auto& it : groups[p]) {
+            cmd += " \"" + it + "\"";
+        }
+
+        long pid = wxExecute(cmd, wxEXEC_ASYNC, new BatchRenderProcess(this));
+        if (pid <= 0) {
+            // render them here instead
+            logger_base.error("Unable to start render process: %s", (const char *)cmd.c_str());
+            for (const auto& it : groups[p]) {
+                fileNames.Add(it);
+            }
+            if (_renderReportFile != "") {
+                _batchRenderProcessReports.RemoveAt(_batchRenderProcessReports.size() - 1);
+            }
+        }
+        else {
+            logger_base.info("Render process %ld started for %d sequences: %s", pid, (int)groups[p].size(), (const char *)cmd.c_str());
+            _batchRenderProcesses.push_back(pid);
+        }
+    }
+}
+
+void xLightsFrame::BatchRenderProcessEnded(int pid, int status)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (status == 0) {
+        logger_base.info("Render process %d finished.", pid);
+    }
+    else {
+        logger_base.error("Render process %d exited with status %d.", pid, status);
+    }
+    _batchRenderProcesses.remove(pid);
+}
+
+void xLightsFrame::WaitForBatchRenderProcesses(bool cancel)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (cancel) {
+        for (const auto& it : _batchRenderProcesses) {
+            logger_base.info("Stopping render process %ld.", it);
+            wxProcess::Kill(it, wxSIGTERM, wxKILL_CHILDREN);
+        }
+    }
+    if (!_batchRenderProcesses.empty()) {
+        logger_base.info("Waiting for %d other render processes.", (int)_batchRenderProcesses.size());
+        SetStatusText(_("Waiting for the other render processes."));
+    }
+    // the processes are reaped from the event loop
+    while (!_batchRenderProcesses.empty()) {
+        wxMilliSleep(100);
+        wxYield();
+    }
 }
 
 void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames, bool exitOnDone) {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
     if (origFilenames.IsEmpty()) {
+        WaitForBatchRenderProcesses(false);
+        FinishBatchRender();
         EnableSequenceControls(true);
         logger_base.debug("Batch render done.");
         printf("Done All Files\n");
@@ -1066,6 +1320,8 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
 
     if (wxGetKeyState(WXK_ESCAPE))
     {
+        WaitForBatchRenderProcesses(true);
+        FinishBatchRender();
         logger_base.debug("Batch render cancelled.");
         EnableSequenceControls(true);
         printf("Batch render cancelled.\n");
@@ -1090,6 +1346,17 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
     OpenSequence(seq, nullptr);
     EnableSequenceControls(false);
 
+    size_t statIndex;
+    {
+        std::unique_lock<std::mutex> lock(_batchWriteLock);
+        statIndex = _batchRenderStats.size();
+        _batchRenderStats.push_back(BatchRenderStat());
+        _batchRenderStats.back().sequence = seq;
+        _batchRenderStats.back().frames = SeqData.NumFrames();
+        _batchRenderStats.back().channels = SeqData.NumChannels();
+        _batchRenderStats.back().openMS = sw.Time();
+    }
+
     // if the fseq directory is not the show directory then ensure the fseq folder is set right
     if (fseqDirectory != showDirectory)
     {
@@ -1105,7 +1372,7 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
     RenderIseqData(true, nullptr); // render ISEQ layers below the Nutcracker layer
     logger_base.info("   iseq below effects done.");
     ProgressBar->SetValue(10);
-    RenderGridToSeqData([this, sw, fileNames, exitOnDone] {
+    RenderGridToSeqData([this, sw, fileNames, exitOnDone, statIndex] {
         static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
         logger_base.info("   Effects done.");
         ProgressBar->SetValue(90);
@@ -1114,10 +1381,14 @@ void xLightsFrame::OpenRenderAndSaveSequences(const wxArrayString &origFilenames
         ProgressBar->SetValue(100);
         ProgressBar->Hide();
         GaugeSizer->Layout();
+        {
+            std::unique_lock<std::mutex> lock(_batchWriteLock);
+            _batchRenderStats[statIndex].renderMS = sw.Time() - _batchRenderStats[statIndex].openMS;
+        }
 
         logger_base.info("Saving fseq file.");
         SetStatusText(_("Saving ") + xlightsFilename + _(" ... Writing fseq."));
-        WriteFalconPiFile(xlightsFilename);
+        SaveBatchRenderedSequence(statIndex);
         logger_base.info("fseq file done.");
         DisplayXlightsFilename(xlightsFilename);
         float elapsedTime = sw.Time()/1000.0; // now stop stopwatch timer and get elapsed time. change into seconds from ms
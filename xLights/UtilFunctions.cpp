@@ -27,6 +27,11 @@
 #include <sys/socket.h>
 #include <ifaddrs.h>
 #include <arpa/inet.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#ifdef __WXOSX__
+#include <mach/mach.h>
 #endif
 
 #include <log4cpp/Category.hh>
@@ -1226,6 +1231,55 @@ void CheckMemoryUsage(const std::string& reason, bool onchangeOnly)
 #endif
 }
 
+void GetProcessUsage(double& cpuSeconds, long& residentKB)
+{
+    cpuSeconds = 0;
+    residentKB = 0;
+#ifdef __WXMSW__
+    FILETIME created, exited, kernel, user;
+    if (::GetProcessTimes(::GetCurrentProcess(), &created, &exited, &kernel, &user))
+    {
+        ULARGE_INTEGER k, u;
+        k.LowPart = kernel.dwLowDateTime;
+        k.HighPart = kernel.dwHighDateTime;
+        u.LowPart = user.dwLowDateTime;
+        u.HighPart = user.dwHighDateTime;
+        cpuSeconds = (double)(k.QuadPart + u.QuadPart) / 10000000.0;
+    }
+    PROCESS_MEMORY_COUNTERS memoryCounters;
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+    {
+        residentKB = (long)(memoryCounters.WorkingSetSize / 1024);
+    }
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        cpuSeconds = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+    }
+#ifdef __WXOSX__
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+    {
+        residentKB = (long)(info.resident_size / 1024);
+    }
+#else
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f != nullptr)
+    {
+        long size = 0;
+        long resident = 0;
+        if (fscanf(f, "%ld %ld", &size, &resident) == 2)
+        {
+            residentKB = resident * (sysconf(_SC_PAGESIZE) / 1024);
+        }
+        fclose(f);
+    }
+#endif
+#endif
+}
+
 bool IsxLights()
 {
     // Allows functions common to multiple xLights programs to know if they are running in xLights itself
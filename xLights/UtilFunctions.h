@@ -237,4 +237,6 @@ std::list<std::string> GetLocalIPs();
 
 void ViewTempFile(const wxString& content, const wxString& name = "temp", const wxString& type = "txt");
 void CheckMemoryUsage(const std::string& reason, bool onchangeOnly = false);
+// cpu time the process has used in seconds and its resident memory in KB
+void GetProcessUsage(double& cpuSeconds, long& residentKB);
 bool IsxLights();
\ No newline at end of file
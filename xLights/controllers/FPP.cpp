@@ -216,6 +216,10 @@ public:
     size_t totalWritten;
     size_t lastDone;
     bool cancelled;
+
+    // set when uploading from a worker thread instead of updating progress
+    std::atomic<size_t> *sharedWritten = nullptr;
+    std::atomic_bool *abort = nullptr;
     
     size_t readData(void *ptr, size_t buffer_size) {
         if (data != nullptr) {
@@ -246,6 +250,12 @@ public:
         if (file != nullptr) {
             size_t t = file->Read(ptr, buffer_size);
             totalWritten += t;
+            if (sharedWritten != nullptr) {
+                *sharedWritten += t;
+            }
+            if (abort != nullptr && *abort) {
+                cancelled = true;
+            }
             
             if (progress) {
                 size_t donePct = totalWritten;
@@ -654,7 +664,7 @@ int FPP::PostToURL(const std::string& url, const std::string &val, const std::st
 
 
 
-bool FPP::uploadFile(const std::string &filename, const std::string &file)  {
+bool FPP::uploadFile(const std::string &filename, const std::string &file, std::atomic<size_t> *written, std::atomic_bool *abort)  {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
     wxString fn;
@@ -669,10 +679,14 @@ bool FPP::uploadFile(const std::string &filename, const std::string &file)  {
         }
     }
 
+    // when written is passed we are on a worker thread and the caller reports the progress
+    bool background = written != nullptr;
     bool cancelled = false;
-    progressDialog->SetTitle("FPP Upload");
     logger_base.debug("FPP upload via http of %s.", (const char*)filename.c_str());
-    progressDialog->Update(0, "Transferring " + filename + " to " + ipAddress, &cancelled);
+    if (!background) {
+        progressDialog->SetTitle("FPP Upload");
+        progressDialog->Update(0, "Transferring " + filename + " to " + ipAddress, &cancelled);
+    }
     int lastDone = 0;
 
     std::string ct = "Content-Type: application/octet-stream";
@@ -729,16 +743,17 @@ bool FPP::uploadFile(const std::string &filename, const std::string &file)  {
     fileobj.Seek(0);
     data.data = (uint8_t*)memBuffPre.GetData();
     data.dataSize = memBuffPre.GetDataLen();
-    data.progress = progressDialog;
     data.file = &fileobj;
     data.postData =  (uint8_t*)memBuffPost.GetData();
     data.postDataSize = memBuffPost.GetDataLen();
     curl_easy_setopt(curl, CURLOPT_READFUNCTION, read_callback);
     curl_easy_setopt(curl, CURLOPT_READDATA, &data);
     
-    data.progress = progressDialog;
+    data.progress = background ? nullptr : progressDialog;
     data.progressString = "Transferring " + filename + " to " + ipAddress;
     data.lastDone = lastDone;
+    data.sharedWritten = written;
+    data.abort = abort;
 
     int i = curl_easy_perform(curl);
     curl_slist_free_all(chunk);
@@ -763,7 +778,9 @@ bool FPP::uploadFile(const std::string &filename, const std::string &file)  {
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
         logger_base.warn("Curl did not upload file:  %d   %s", response_code, error);
     }
-    progressDialog->Update(1000, wxEmptyString, &cancelled);
+    if (!background) {
+        progressDialog->Update(1000, wxEmptyString, &cancelled);
+    }
     logger_base.info("FPPConnect Upload file %s  - Return: %d - RC: %d - File: %s", fullUrl.c_str(), i, response_code, filename.c_str());
 
     return data.cancelled;
@@ -914,16 +931,33 @@ bool FPP::AddFrameToUpload(uint32_t frame, uint8_t *data) {
 }
 bool FPP::FinalizeUploadSequence() {
     bool cancelled = false;
-    if (outputFile) {
-        outputFile->finalize();
+    if (CloseUploadSequence()) {
+        cancelled = uploadOrCopyFile(baseSeqName, tempFileName, "sequences");
+        ::wxRemoveFile(tempFileName);
+        tempFileName = "";
+    }
+    return cancelled;
+}
+bool FPP::CloseUploadSequence() {
+    if (outputFile == nullptr) return false;
 
-        delete outputFile;
-        outputFile = nullptr;
-        if (tempFileName != "") {
-            cancelled = uploadOrCopyFile(baseSeqName, tempFileName, "sequences");
-            ::wxRemoveFile(tempFileName);
-            tempFileName = "";
-        }
+    outputFile->finalize();
+    delete outputFile;
+    outputFile = nullptr;
+    return tempFileName != "";
+}
+size_t FPP::GetUploadSequenceSize() const {
+    if (tempFileName == "") return 0;
+    return wxFileName::GetSize(tempFileName).GetValue();
+}
+// Uploads the file CloseUploadSequence finished without touching the progress dialog so it can run on a worker thread.
+// written is increased as the bytes are sent and setting abort stops the upload.
+bool FPP::UploadSequenceInBackground(std::atomic<size_t> &written, std::atomic_bool &abort) {
+    bool cancelled = false;
+    if (tempFileName != "") {
+        cancelled = uploadFile(baseSeqName, tempFileName, &written, &abort);
+        ::wxRemoveFile(tempFileName);
+        tempFileName = "";
     }
     return cancelled;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
@@ -65,6 +66,12 @@ class FPP : public BaseController
     bool AddFrameToUpload(uint32_t frame, uint8_t *data);
     bool FinalizeUploadSequence();
 
+    // FinalizeUploadSequence split in two so the uploads to several instances can run at the same time.
+    // CloseUploadSequence returns true if there is a generated file that still needs uploading.
+    bool CloseUploadSequence();
+    size_t GetUploadSequenceSize() const;
+    bool UploadSequenceInBackground(std::atomic<size_t> &written, std::atomic_bool &abort);
+
 
     bool UploadUDPOutputsForProxy(OutputManager* outputManager);
     
@@ -118,7 +125,9 @@ private:
                           const std::string &file,
                           const std::string &dir);
     bool uploadFile(const std::string &filename,
-                    const std::string &file);
+                    const std::string &file,
+                    std::atomic<size_t> *written = nullptr,
+                    std::atomic_bool *abort = nullptr);
     bool copyFile(const std::string &filename,
                   const std::string &file,
                   const std::string &dir);
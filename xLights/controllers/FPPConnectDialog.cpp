@@ -19,6 +19,8 @@
 #include "../outputs/ControllerEthernet.h"
 #include "ControllerCaps.h"
 
+#include <future>
+
 #include <log4cpp/Category.hh>
 #include "../xSchedule/wxJSON/jsonreader.h"
 
@@ -751,12 +753,18 @@ void FPPConnectDialog::OnButton_UploadClick(wxCommandEvent& event)
                         parallel_for(instances, func);
                     }
                 }
-                row = 0;
-                for (const auto &inst : instances) {
-                    if (!cancelled && doUpload[row]) {
-                        cancelled |= inst->FinalizeUploadSequence();
-                    }
-                    row++;
+                if (!cancelled) {
+                    // finish each instances file in parallel and then upload them all at once rather than one after the other
+                    std::list<FPP*> uploads;
+                    std::mutex uploadsLock;
+                    std::function<void(FPP * &, int)> closeFunc = [&doUpload, &uploads, &uploadsLock](FPP* &inst, int row) {
+                        if (doUpload[row] && inst->CloseUploadSequence()) {
+                            std::unique_lock<std::mutex> lock(uploadsLock);
+                            uploads.push_back(inst);
+                        }
+                    };
+                    parallel_for(instances, closeFunc);
+                    cancelled |= UploadSequencesInParallel(uploads, fseq, prgs);
                 }
             }
             delete seq;
@@ -790,6 +798,64 @@ void FPPConnectDialog::OnButton_UploadClick(wxCommandEvent& event)
     }
 }
 
+bool FPPConnectDialog::UploadSequencesInParallel(std::list<FPP*> &uploads, const std::string &fseq, wxProgressDialog &prgs)
+{
+    static log4cpp::Category& logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    static const int MAX_PARALLEL_UPLOADS = 8;
+
+    if (uploads.empty()) return false;
+
+    size_t total = 0;
+    for (const auto& inst : uploads) {
+        total += inst->GetUploadSequenceSize();
+    }
+    logger_base.debug("FPPConnect uploading %s to %d instances, %llu bytes.", (const char*)fseq.c_str(), (int)uploads.size(), (unsigned long long)total);
+
+    std::atomic<size_t> written(0);
+    std::atomic_bool abort(false);
+    std::mutex lock;
+    auto next = uploads.begin();
+
+    // the workers only touch their own FPP instance, the progress dialog is updated out here
+    std::list<std::future<void>> workers;
+    int count = std::min((int)uploads.size(), MAX_PARALLEL_UPLOADS);
+    for (int i = 0; i < count; i++) {
+        workers.push_back(std::async(std::launch::async, [&uploads, &next, &lock, &written, &abort]() {
+            while (true) {
+                FPP* inst = nullptr;
+                {
+                    std::unique_lock<std::mutex> l(lock);
+                    if (next == uploads.end()) return;
+                    inst = *next;
+                    ++next;
+                }
+                if (inst->UploadSequenceInBackground(written, abort)) {
+                    abort = true;
+                }
+            }
+        }));
+    }
+
+    prgs.SetTitle("FPP Upload");
+    std::string msg = "Transferring " + fseq + wxString::Format(" to %d instances", (int)uploads.size()).ToStdString();
+    int lastDone = -1;
+    for (auto& it : workers) {
+        while (it.wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+            int donePct = total == 0 ? 0 : (int)std::min((uint64_t)1000, (uint64_t)written * 1000 / total);
+            if (donePct != lastDone) {
+                lastDone = donePct;
+                bool skip = false;
+                if (!prgs.Update(donePct, msg, &skip)) {
+                    abort = true;
+                }
+            }
+            wxYield();
+        }
+    }
+    prgs.Update(1000, wxEmptyString);
+    return abort;
+}
+
 void FPPConnectDialog::CreateDriveList()
 {
     wxArrayString drives;
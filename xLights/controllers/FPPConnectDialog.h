@@ -103,6 +103,7 @@ class FPPConnectDialog: public wxDialog
         void SetCheckValue(const std::string &col, bool b);
 
 		void DisplayDateModified(std::string const& filePath, wxTreeListItem &index) const;
+        bool UploadSequencesInParallel(std::list<FPP*> &uploads, const std::string &fseq, wxProgressDialog &prgs);
 
 		DECLARE_EVENT_TABLE()
 };
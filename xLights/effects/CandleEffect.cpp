@@ -107,11 +107,11 @@ void CandleEffect::SetDefaultParameters() {
     SetCheckBoxValue(fp->CheckBox_PerNode, false);
 }
 
-void CandleEffect::Update(wxByte& flameprime, wxByte& flame, wxByte& wind, size_t windVariability, size_t flameAgility, size_t windCalmness, size_t windBaseline)
+void CandleEffect::Update(RenderBuffer& buffer, wxByte& flameprime, wxByte& flame, wxByte& wind, size_t windVariability, size_t flameAgility, size_t windCalmness, size_t windBaseline)
 {
     //We simulate a gust of wind by setting the wind var to a random value
-    if (wxByte(rand01() * 255.0) < windVariability) {
-        wind = wxByte(rand01() * 255.0);
+    if (wxByte(buffer.Rand01() * 255.0) < windVariability) {
+        wind = wxByte(buffer.Rand01() * 255.0);
     }
 
     //The wind constantly settles towards its baseline value
@@ -126,8 +126,8 @@ void CandleEffect::Update(wxByte& flameprime, wxByte& flame, wxByte& wind, size_
 
     //Depending on the wind strength and the calmnes modifer we calcuate the odds
     //of the wind knocking down the flame by setting it to random values
-    if (wxByte(rand01() * 255) < (wind >> windCalmness)) {
-        flame = wxByte(rand01() * 255);
+    if (wxByte(buffer.Rand01() * 255) < (wind >> windCalmness)) {
+        flame = wxByte(buffer.Rand01() * 255);
     }
 
     //Real flames ook like they have inertia so we use this constant-aproach-rate filter
@@ -147,7 +147,7 @@ void CandleEffect::Update(wxByte& flameprime, wxByte& flame, wxByte& wind, size_
     //We don't. It adds to the realism.
 }
 
-void InitialiseState(int node, std::map<int, CandleState*>& states)
+void InitialiseState(RenderBuffer& buffer, int node, std::map<int, CandleState*>& states)
 {
     if (states.find(node) == states.end())
     {
@@ -155,13 +155,13 @@ void InitialiseState(int node, std::map<int, CandleState*>& states)
         states[node] = state;
     }
 
-    states[node]->flamer = rand01() * 255;
-    states[node]->flameprimer = rand01() * 255;
+    states[node]->flamer = buffer.Rand01() * 255;
+    states[node]->flameprimer = buffer.Rand01() * 255;
 
-    states[node]->flameg = rand01() * states[node]->flamer;
-    states[node]->flameprimeg = rand01() * states[node]->flameprimer;
+    states[node]->flameg = buffer.Rand01() * states[node]->flamer;
+    states[node]->flameprimeg = buffer.Rand01() * states[node]->flameprimer;
 
-    states[node]->wind = rand01() * 255;
+    states[node]->wind = buffer.Rand01() * 255;
 }
 
 // 10 <= HeightPct <= 100
@@ -188,13 +188,13 @@ void CandleEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 for (size_t y = 0; y < buffer.ModelBufferHt; ++y)
                 {
                     size_t index = y * buffer.ModelBufferWi + x;
-                    InitialiseState(index, states);
+                    InitialiseState(buffer, index, states);
                 }
             }
         }
         else
         {
-            InitialiseState(0, states);
+            InitialiseState(buffer, 0, states);
         }
     }
 
@@ -214,8 +214,8 @@ void CandleEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 {
                     CandleState* state = states[index];
 
-                    Update(state->flameprimer, state->flamer, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
-                    Update(state->flameprimeg, state->flameg, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
+                    Update(buffer, state->flameprimer, state->flamer, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
+                    Update(buffer, state->flameprimeg, state->flameg, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
 
                     if (state->flameprimeg > state->flameprimer) state->flameprimeg = state->flameprimer;
                     if (state->flameg > state->flamer) state->flameprimeg = state->flameprimer;
@@ -231,8 +231,8 @@ void CandleEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
     {
         CandleState* state = states[0];
 
-        Update(state->flameprimer, state->flamer, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
-        Update(state->flameprimeg, state->flameg, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
+        Update(buffer, state->flameprimer, state->flamer, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
+        Update(buffer, state->flameprimeg, state->flameg, state->wind, windVariability, flameAgility, windCalmness, windBaseline);
 
         if (state->flameprimeg > state->flameprimer) state->flameprimeg = state->flameprimer;
         if (state->flameg > state->flamer) state->flameprimeg = state->flameprimer;
@@ -24,7 +24,8 @@ public:
     virtual std::string GetEffectString() override;
     virtual bool needToAdjustSettings(const std::string& version) override;
     virtual void adjustSettings(const std::string& version, Effect* effect, bool removeDefaults = true) override;
-    virtual bool CanRenderPartialTimeInterval() const override { return true; }
+    // the background display list is built up frame by frame and shared by every buffer rendering the effect
+    //virtual bool CanRenderPartialTimeInterval() const override { return true; }
 
 protected:
     virtual void RemoveDefaults(const std::string& version, Effect* effect) override;
@@ -542,7 +542,7 @@ void FacesEffect::drawoutline(RenderBuffer &buffer, int Phoneme, bool outline, c
         {
             if ((buffer.curPeriod * buffer.frameTimeInMs) >= cache->nextBlinkTime) {
                 //roughly every 5 seconds we'll blink
-                cache->nextBlinkTime += (4500 + (rand() % 1000));
+                cache->nextBlinkTime += (4500 + (buffer.Rand() % 1000));
                 cache->blinkEndTime = buffer.curPeriod * buffer.frameTimeInMs + 101; //100ms blink
                 eye = "Closed";
             }
@@ -844,7 +844,7 @@ void FacesEffect::RenderFaces(RenderBuffer &buffer,
             if ("Auto" == eyes) {
                 if ((buffer.curPeriod * buffer.frameTimeInMs) >= cache->nextBlinkTime) {
                     //roughly every 5 seconds we'll blink
-                    cache->nextBlinkTime += (4500 + (rand() % 1000));
+                    cache->nextBlinkTime += (4500 + (buffer.Rand() % 1000));
                     cache->blinkEndTime = buffer.curPeriod * buffer.frameTimeInMs + 101; //100ms blink
                     eyes = "Closed";
                 }
@@ -897,7 +897,7 @@ void FacesEffect::RenderFaces(RenderBuffer &buffer,
                 if ((buffer.curPeriod * buffer.frameTimeInMs) >= cache->nextBlinkTime) {
                     if ((startms + 150) >= (buffer.curPeriod * buffer.frameTimeInMs)) {
                         //don't want to blink RIGHT at the start of the rest, delay a little bie
-                        int tmp = (buffer.curPeriod * buffer.frameTimeInMs) + 150 + rand() % 400;
+                        int tmp = (buffer.curPeriod * buffer.frameTimeInMs) + 150 + buffer.Rand() % 400;
 
                         //also don't want it right at the end
                         if ((tmp + 130) > endms) {
@@ -909,7 +909,7 @@ void FacesEffect::RenderFaces(RenderBuffer &buffer,
                     }
                     else {
                         //roughly every 5 seconds we'll blink
-                        cache->nextBlinkTime += (4500 + (rand() % 1000));
+                        cache->nextBlinkTime += (4500 + (buffer.Rand() % 1000));
                         cache->blinkEndTime = buffer.curPeriod * buffer.frameTimeInMs + 101; //100ms blink
                         eyes = "Closed";
                     }
@@ -928,7 +928,7 @@ void FacesEffect::RenderFaces(RenderBuffer &buffer,
         if ("Auto" == eyes) {
             if ((buffer.curPeriod * buffer.frameTimeInMs) >= cache->nextBlinkTime) {
                 //roughly every 5 seconds we'll blink
-                cache->nextBlinkTime += (4500 + (rand() % 1000));
+                cache->nextBlinkTime += (4500 + (buffer.Rand() % 1000));
                 cache->blinkEndTime = buffer.curPeriod * buffer.frameTimeInMs + 101; //100ms blink
                 eyes = "Closed";
             }
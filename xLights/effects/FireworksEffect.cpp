@@ -18,6 +18,7 @@
 #include "../models/Model.h"
 #include "../UtilFunctions.h"
 #include "../sequencer/SequenceElements.h"
+#include "ParticlePool.h"
 
 #include "../../include/fireworks-16.xpm"
 #include "../../include/fireworks-24.xpm"
@@ -56,13 +57,13 @@ wxPanel *FireworksEffect::CreatePanel(wxWindow *parent) {
     return new FireworksPanel(parent);
 }
 
-class FireworkParticle
+// per particle position, velocity, age and the firework it came from
+enum { PARTICLE_X, PARTICLE_Y, PARTICLE_VX, PARTICLE_VY, PARTICLE_AGE, PARTICLE_FIREWORK };
+typedef ParticlePool<double, double, double, double, int, int> FireworkParticles;
+
+class Firework
 {
-    const int _maxFade = 100;
-    double _x;
-    double _y;
-    double _vx;
-    double _vy;
+    static const int _maxCycles = 500;
     int _fade;
     bool _gravity;
     HSVValue _startColour;
@@ -71,15 +72,15 @@ class FireworkParticle
     int _width;
     int _height;
     double _fps;
-    int _age = 0;
 
 public:
-    FireworkParticle(int x, int y, double vx, double vy, int fade, bool gravity, int colourIndex, bool holdColour, double velocity, int width, int height, int frameMS, const PaletteClass& palette)
+    int _cycles = 0;
+    bool _done = false;
+
+    Firework(FireworkParticles& particles, int index, int count, int x, int y, double vx, double vy, int fade, bool gravity, int colourIndex, bool holdColour, double velocity, int width, int height, int frameMS, const PaletteClass& palette, const RenderBuffer& buffer)
     {
         _width = width;
         _height = height;
-        _x = x;
-        _y = y;
         _fade = fade;
         _gravity = gravity;
         _colourIndex = colourIndex;
@@ -92,36 +93,45 @@ public:
 
         _fps = 1000.0 / frameMS;
 
-        double explosionVelocity = (rand() - RAND_MAX / 2)*velocity / (RAND_MAX / 2);
-        double angle = 2 * M_PI*rand() / RAND_MAX;
-        _vx = 3.0 * vx / 100 + explosionVelocity * cos(angle);
-        _vy = 3.0 * -vy / 100 + explosionVelocity * sin(angle);
+        for (int i = 0; i < count; i++)
+        {
+            size_t p = particles.Add();
+            double explosionVelocity = (buffer.Rand() - RAND_MAX / 2)*velocity / (RAND_MAX / 2);
+            double angle = 2 * M_PI*buffer.Rand() / RAND_MAX;
+            particles.Get<PARTICLE_X>(p) = x;
+            particles.Get<PARTICLE_Y>(p) = y;
+            particles.Get<PARTICLE_VX>(p) = 3.0 * vx / 100 + explosionVelocity * cos(angle);
+            particles.Get<PARTICLE_VY>(p) = 3.0 * -vy / 100 + explosionVelocity * sin(angle);
+            particles.Get<PARTICLE_FIREWORK>(p) = index;
+        }
     }
 
-    virtual ~FireworkParticle() {}
-
-    bool Done() const
+    bool ParticleDone(const FireworkParticles& particles, size_t p) const
     {
-        return (_fade < _age * 2 || _x < 0 || _y < 0 || _x > _width || (!_gravity && _y > _height));
+        double x = particles.Get<PARTICLE_X>(p);
+        double y = particles.Get<PARTICLE_Y>(p);
+        return (_fade < particles.Get<PARTICLE_AGE>(p) * 2 || x < 0 || y < 0 || x > _width || (!_gravity && y > _height));
     }
 
-    void Advance()
+    void AdvanceParticle(FireworkParticles& particles, size_t p) const
     {
-        _x += _vx;
+        particles.Get<PARTICLE_X>(p) += particles.Get<PARTICLE_VX>(p);
         if (_gravity)
         {
-            _vy += 0.98 / _fps;
+            particles.Get<PARTICLE_VY>(p) += 0.98 / _fps;
         }
-        _y += -_vy;
-        _age++;
+        particles.Get<PARTICLE_Y>(p) += -particles.Get<PARTICLE_VY>(p);
+        particles.Get<PARTICLE_AGE>(p)++;
     }
 
-    int GetX() const { return _x; }
-    int GetY() const { return _y; }
+    bool OutOfCycles() const
+    {
+        return _cycles >= _maxCycles;
+    }
 
-    xlColor GetColour(const PaletteClass& palette, bool alpha) const
+    xlColor GetColour(const PaletteClass& palette, bool alpha, int age) const
     {
-        double v = ((10.0*_fade) - _age * 20.0) / (10.0*_fade);
+        double v = ((10.0*_fade) - age * 20.0) / (10.0*_fade);
         if (v < 0.0) v = 0.0;
 
         HSVValue cv = _startColour;
@@ -157,62 +167,13 @@ public:
     }
 };
 
-class Firework
-{
-    const int _maxCycles = 500;
-    int _cycles = 0;
-    mutable bool _done = false;
-    std::vector<FireworkParticle> _particles;
-
-public:
-    Firework(int particles, int x, int y, double vx, double vy, int fade, bool gravity, int colourIndex, bool holdColour, double velocity, int width, int height, int frameMS, const PaletteClass& palette)
-    {
-        _cycles = 0;
-        for (int i = 0; i < particles; i++)
-        {
-            _particles.push_back(FireworkParticle(x, y, vx, vy, fade, gravity, colourIndex, holdColour, velocity, width, height, frameMS, palette));
-        }
-    }
-
-    const std::vector<FireworkParticle>& GetParticles() const {
-        return _particles;
-    }
-
-    void Advance()
-    {
-        _cycles++;
-
-        for (auto& it : _particles)
-        {
-            it.Advance();
-        }
-
-        if (Done()) _particles.clear();
-    }
-
-    bool AllGone() const
-    {
-        for (const auto& it : _particles)
-        {
-            if (!it.Done()) return false;
-        }
-
-        _done = true;
-        return true;
-    }
-
-    bool Done() const
-    {
-        return _done || _cycles >= _maxCycles || AllGone();
-    }
-};
-
 class FireworksRenderCache : public EffectRenderCache {
 public:
     FireworksRenderCache() {};
     virtual ~FireworksRenderCache() {};
     int _sinceLastTriggered = 0;
-    std::list<Firework> _fireworks;
+    std::vector<Firework> _fireworks;
+    FireworkParticles _particles;
     std::vector<int> _firePeriods;
 };
 
@@ -305,7 +266,7 @@ void FireworksEffect::SetPanelTimingTracks() const
     wxPostEvent(fp, event);
 }
 
-std::pair<int,int> FireworksEffect::GetFireworkLocation(int width, int height, int overridex, int overridey)
+std::pair<int,int> FireworksEffect::GetFireworkLocation(const RenderBuffer& buffer, int width, int height, int overridex, int overridey)
 {
     int startX;
     int startY;
@@ -317,7 +278,7 @@ std::pair<int,int> FireworksEffect::GetFireworkLocation(int width, int height, i
     {
         int x25 = static_cast<int>(0.25f * width);
         int x75 = static_cast<int>(0.75f * width);
-        if ((x75 - x25) > 0) startX = x25 + rand() % (x75 - x25); else startX = 0;
+        if ((x75 - x25) > 0) startX = x25 + buffer.Rand() % (x75 - x25); else startX = 0;
     }
 
     if (overridey >= 0)
@@ -328,7 +289,7 @@ std::pair<int,int> FireworksEffect::GetFireworkLocation(int width, int height, i
     {
         int y25 = static_cast<int>(0.25f * height);
         int y75 = static_cast<int>(0.75f * height);
-        if ((y75 - y25) > 0) startY = y25 + rand() % (y75 - y25); else startY = 0;
+        if ((y75 - y25) > 0) startY = y25 + buffer.Rand() % (y75 - y25); else startY = 0;
     }
     return { startX, startY };
 }
@@ -375,6 +336,7 @@ void FireworksEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuf
     
     auto& sinceLastTriggered = cache->_sinceLastTriggered;
     auto& fireworks = cache->_fireworks;
+    auto& particles = cache->_particles;
     auto& firePeriods = cache->_firePeriods;
 
     size_t colorcnt = buffer.GetColorCount();
@@ -386,7 +348,7 @@ void FireworksEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuf
         if (!useMusic && !useTiming)
         {
             for (int i = 0; i < numberOfExplosions; i++) {
-                firePeriods.push_back(buffer.curEffStartPer + rand01() * (buffer.curEffEndPer - buffer.curEffStartPer));
+                firePeriods.push_back(buffer.curEffStartPer + buffer.Rand01() * (buffer.curEffEndPer - buffer.curEffStartPer));
             }
         }
 
@@ -404,16 +366,16 @@ void FireworksEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuf
             // trigger if it was not previously triggered or has been triggered for REPEATTRIGGER frames
             if (sinceLastTriggered == 0 || sinceLastTriggered > REPEATTRIGGER)
             {
-                auto location = GetFireworkLocation(buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
-                int colourIndex = rand() % colorcnt; 
-                fireworks.push_back(Firework(particleCount,
+                auto location = GetFireworkLocation(buffer, buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
+                int colourIndex = buffer.Rand() % colorcnt; 
+                fireworks.push_back(Firework(particles, fireworks.size(), particleCount,
                     location.first, location.second,
                     xVelocity, yVelocity,
                     fade, gravity,
                     colourIndex, holdColour,
                     particleVelocity,
                     buffer.BufferWi, buffer.BufferHt,
-                    buffer.frameTimeInMs, buffer.palette));
+                    buffer.frameTimeInMs, buffer.palette, buffer));
             }
 
             // if music is over the trigger level for REPEATTRIGGER frames then we will trigger another firework
@@ -453,16 +415,16 @@ void FireworksEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuf
                     if (buffer.curPeriod == el->GetEffect(j)->GetStartTimeMS() / buffer.frameTimeInMs ||
                         buffer.curPeriod == el->GetEffect(j)->GetEndTimeMS() / buffer.frameTimeInMs)
                     {
-                        auto location = GetFireworkLocation(buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
-                        int colourIndex = rand() % colorcnt;
-                        fireworks.push_back(Firework(particleCount,
+                        auto location = GetFireworkLocation(buffer, buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
+                        int colourIndex = buffer.Rand() % colorcnt;
+                        fireworks.push_back(Firework(particles, fireworks.size(), particleCount,
                             location.first, location.second,
                             xVelocity, yVelocity,
                             fade, gravity,
                             colourIndex, holdColour,
                             particleVelocity,
                             buffer.BufferWi, buffer.BufferHt,
-                            buffer.frameTimeInMs, buffer.palette));
+                            buffer.frameTimeInMs, buffer.palette, buffer));
                         break;
                     }
                 }
@@ -476,30 +438,54 @@ void FireworksEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuf
         {
             if (it == buffer.curPeriod)
             {
-                auto location = GetFireworkLocation(buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
-                int colourIndex = rand() % colorcnt;
-                fireworks.push_back(Firework(particleCount,
+                auto location = GetFireworkLocation(buffer, buffer.BufferWi, buffer.BufferHt, xLocation, yLocation);
+                int colourIndex = buffer.Rand() % colorcnt;
+                fireworks.push_back(Firework(particles, fireworks.size(), particleCount,
                     location.first, location.second,
                     xVelocity, yVelocity,
                     fade, gravity,
                     colourIndex, holdColour,
                     particleVelocity,
                     buffer.BufferWi, buffer.BufferHt,
-                    buffer.frameTimeInMs, buffer.palette));
+                    buffer.frameTimeInMs, buffer.palette, buffer));
             }
         }
     }
 
-    for (auto& it: fireworks)
+    // a firework is finished once all its particles have burnt out or it has run for too long
+    std::vector<uint8_t> alive(fireworks.size(), 0);
+    for (size_t p = 0; p < particles.Size(); p++)
     {
-        if (!it.Done())
+        int fw = particles.Get<PARTICLE_FIREWORK>(p);
+        if (!alive[fw] && !fireworks[fw].ParticleDone(particles, p))
         {
-            for (auto p : it.GetParticles())
-            {
-                buffer.SetPixel(p.GetX(), p.GetY(), p.GetColour(buffer.palette, buffer.allowAlpha));
-            }
+            alive[fw] = 1;
+        }
+    }
+    for (size_t fw = 0; fw < fireworks.size(); fw++)
+    {
+        if (!alive[fw] || fireworks[fw].OutOfCycles())
+        {
+            fireworks[fw]._done = true;
+        }
+    }
+    particles.RemoveIf([&particles, &fireworks](size_t p) { return fireworks[particles.Get<PARTICLE_FIREWORK>(p)]._done; });
 
-            it.Advance();
+    for (size_t p = 0; p < particles.Size(); p++)
+    {
+        const Firework& fw = fireworks[particles.Get<PARTICLE_FIREWORK>(p)];
+        buffer.SetPixel((int)particles.Get<PARTICLE_X>(p), (int)particles.Get<PARTICLE_Y>(p), fw.GetColour(buffer.palette, buffer.allowAlpha, particles.Get<PARTICLE_AGE>(p)));
+    }
+
+    particles.ForEach([&particles, &fireworks](int p) {
+        fireworks[particles.Get<PARTICLE_FIREWORK>(p)].AdvanceParticle(particles, p);
+    }, 10000);
+
+    for (auto& it : fireworks)
+    {
+        if (!it._done)
+        {
+            it._cycles++;
         }
     }
 }
\ No newline at end of file
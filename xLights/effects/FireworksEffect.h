@@ -47,7 +47,7 @@ class FireworksEffect : public RenderableEffect
 protected:
         virtual wxPanel *CreatePanel(wxWindow *parent) override;
         void SetPanelTimingTracks() const;
-        static std::pair<int, int> GetFireworkLocation(int width, int height, int overridex = -1, int overridey = -1);
+        static std::pair<int, int> GetFireworkLocation(const RenderBuffer& buffer, int width, int height, int overridex = -1, int overridey = -1);
         virtual bool needToAdjustSettings(const std::string &version) override;
         virtual void adjustSettings(const std::string &version, Effect *effect, bool removeDefaults = true) override;
 };
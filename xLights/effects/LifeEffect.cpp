@@ -105,9 +105,9 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
         buffer.ClearTempBuf();
         for(i=0; i<Count; i++)
         {
-            x=rand() % BufferWi;
-            y=rand() % BufferHt;
-            buffer.GetMultiColorBlend(rand01(),false,color);
+            x=buffer.Rand() % BufferWi;
+            y=buffer.Rand() % BufferHt;
+            buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
             buffer.SetTempPixel(x,y,color);
         }
     }
@@ -146,7 +146,7 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
                     }
                     else if (!isLive && cnt == 3)
                     {
-                        buffer.GetMultiColorBlend(rand01(),false,color);
+                        buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
                         buffer.SetPixel(x,y,color);
                     }
                     break;
@@ -158,7 +158,7 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
                     }
                     else if (!isLive && (cnt == 3 || cnt == 5))
                     {
-                        buffer.GetMultiColorBlend(rand01(),false,color);
+                        buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
                         buffer.SetPixel(x,y,color);
                     }
                     break;
@@ -170,7 +170,7 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
                     }
                     else if (!isLive && (cnt == 3 || cnt == 5 || cnt == 7))
                     {
-                        buffer.GetMultiColorBlend(rand01(),false,color);
+                        buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
                         buffer.SetPixel(x,y,color);
                     }
                     break;
@@ -182,7 +182,7 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
                     }
                     else if (!isLive && (cnt == 3 || cnt == 7 || cnt == 8))
                     {
-                        buffer.GetMultiColorBlend(rand01(),false,color);
+                        buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
                         buffer.SetPixel(x,y,color);
                     }
                     break;
@@ -194,7 +194,7 @@ void LifeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &
                     }
                     else if (!isLive && (cnt == 2 || cnt >= 5))
                     {
-                        buffer.GetMultiColorBlend(rand01(),false,color);
+                        buffer.GetMultiColorBlend(buffer.Rand01(),false,color);
                         buffer.SetPixel(x,y,color);
                     }
                     break;
@@ -34,7 +34,6 @@ public:
     virtual void SetDefaultParameters() override;
     virtual void Render(Effect* effect, SettingsMap& settings, RenderBuffer& buffer) override;
     virtual bool AppropriateOnNodes() const override { return false; }
-    virtual bool CanRenderPartialTimeInterval() const override { return true; }
 protected:
     virtual wxPanel* CreatePanel(wxWindow* parent) override;
 private:
@@ -384,7 +384,7 @@ xlColor LiquidEffect::GetDespeckleColor(RenderBuffer& buffer, size_t x, size_t y
     return xlColor(red / count, green / count, blue / count);
 }
 
-void LiquidEffect::CreateParticles(b2ParticleSystem* ps, int x, int y, int direction, int velocity, int flow, bool flowMusic, int lifetime, int width, int height, const xlColor& c, const std::string& particleType, bool mixcolors, float audioLevel, int sourceSize)
+void LiquidEffect::CreateParticles(RenderBuffer& buffer, b2ParticleSystem* ps, int x, int y, int direction, int velocity, int flow, bool flowMusic, int lifetime, int width, int height, const xlColor& c, const std::string& particleType, bool mixcolors, float audioLevel, int sourceSize)
 {
     static const float pi2 = 6.283185307f;
     float posx = (float)x * (float)width / 100.0;
@@ -393,7 +393,7 @@ void LiquidEffect::CreateParticles(b2ParticleSystem* ps, int x, int y, int direc
     float velx = (float)velocity * 10.0 * RenderBuffer::cos(pi2 * (float)direction / 360.0);
     float vely = (float)velocity * 10.0 * RenderBuffer::sin(pi2 * (float)direction / 360.0);
 
-    float velVariation = rand01() * 0.1;
+    float velVariation = buffer.Rand01() * 0.1;
     velVariation -= velVariation / 2.0;
 
     velx -= velx * velVariation;
@@ -457,10 +457,10 @@ void LiquidEffect::CreateParticles(b2ParticleSystem* ps, int x, int y, int direc
         if (sourceSize == 0)
         {
             // Randomly pick a position within the emitter's radius.
-            const float32 angle = rand01() * 2.0f * b2_pi;
+            const float32 angle = buffer.Rand01() * 2.0f * b2_pi;
 
             // Distance from the center of the circle.
-            const float32 distance = rand01();
+            const float32 distance = buffer.Rand01();
             b2Vec2 positionOnUnitCircle(RenderBuffer::sin(angle), RenderBuffer::cos(angle));
 
             // Initial position.
@@ -471,7 +471,7 @@ void LiquidEffect::CreateParticles(b2ParticleSystem* ps, int x, int y, int direc
         else
         {
             // Distance from the center of the circle.
-            const float32 distance = rand01() * ((float)sourceSize - (float)sourceSize / 2.0);
+            const float32 distance = buffer.Rand01() * ((float)sourceSize - (float)sourceSize / 2.0);
 
             float offx = distance * RenderBuffer::cos(pi2 * ((float)direction + 90.0) / 360.0);
             float offy = distance * RenderBuffer::sin(pi2 * ((float)direction + 90.0) / 360.0);
@@ -487,7 +487,7 @@ void LiquidEffect::CreateParticles(b2ParticleSystem* ps, int x, int y, int direc
         // give it a lifetime
         if (lifetime > 0)
         {
-            float randomlt = lt + (lt * 0.2 * rand01()) - (lt *.01);
+            float randomlt = lt + (lt * 0.2 * buffer.Rand01()) - (lt *.01);
             pd.lifetime = randomlt;
         }
         ps->CreateParticle(pd);
@@ -545,16 +545,16 @@ void LiquidEffect::Step(b2World* world, RenderBuffer &buffer, bool enabled[], in
                 switch (i)
                 {
                 case 0:
-                    CreateParticles(ps, x1, y1, direction1, velocity1, flow1, flowMusic1, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize1);
+                    CreateParticles(buffer, ps, x1, y1, direction1, velocity1, flow1, flowMusic1, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize1);
                     break;
                 case 1:
-                    CreateParticles(ps, x2, y2, direction2, velocity2, flow2, flowMusic2, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize2);
+                    CreateParticles(buffer, ps, x2, y2, direction2, velocity2, flow2, flowMusic2, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize2);
                     break;
                 case 2:
-                    CreateParticles(ps, x3, y3, direction3, velocity3, flow3, flowMusic3, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize3);
+                    CreateParticles(buffer, ps, x3, y3, direction3, velocity3, flow3, flowMusic3, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize3);
                     break;
                 case 3:
-                    CreateParticles(ps, x4, y4, direction4, velocity4, flow4, flowMusic4, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize4);
+                    CreateParticles(buffer, ps, x4, y4, direction4, velocity4, flow4, flowMusic4, lifetime, buffer.BufferWi, buffer.BufferHt, color, particleType, mixcolors, audioLevel, sourceSize4);
                     break;
                 }
                 j++;
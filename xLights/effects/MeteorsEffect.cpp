@@ -26,6 +26,7 @@
 #include "../UtilFunctions.h"
 
 #include "../Parallel.h"
+#include "ParticlePool.h"
 
 MeteorsEffect::MeteorsEffect(int id) : RenderableEffect(id, "Meteors", meteors_16, meteors_24, meteors_32, meteors_48, meteors_64)
 {
@@ -95,25 +96,14 @@ static inline int GetMeteorColorScheme(const std::string &color) {
     return 0;
 }
 
-class MeteorClass {
-public:
-
-    int x,y;
-    HSVValue hsv;
-    int h; //variable length; only used for icicle drip -DJ
-};
-
-// for radial meteor effect
-class MeteorRadialClass {
-public:
+// position, colour and length of the meteors moving along an axis
+// the length (h) is only used for icicle drip -DJ
+enum { METEOR_X, METEOR_Y, METEOR_HSV, METEOR_H };
+typedef ParticlePool<int, int, HSVValue, int> MeteorList;
 
-    double x,y,dx,dy;
-    int cnt;
-    HSVValue hsv;
-};
-
-typedef std::list<MeteorClass> MeteorList;
-typedef std::list<MeteorRadialClass> MeteorRadialList;
+// position, direction, age and colour for the radial meteor effects
+enum { RADIAL_X, RADIAL_Y, RADIAL_DX, RADIAL_DY, RADIAL_CNT, RADIAL_HSV };
+typedef ParticlePool<double, double, double, double, int, HSVValue> MeteorRadialList;
 
 class MeteorsRenderCache : public EffectRenderCache {
 public:
@@ -123,6 +113,17 @@ public:
     int effectState;
     MeteorList meteors;
     MeteorRadialList meteorsRadial;
+
+    // the random hues for the rainbow colour scheme are drawn before the meteors are rendered in parallel
+    // so the buffer's random numbers always come out in the same order
+    std::vector<double> hues;
+    const double *DrawHues(RenderBuffer &buffer, size_t count) {
+        hues.resize(count);
+        for (auto &h : hues) {
+            h = double(buffer.Rand() % 1000) / 1000.0;
+        }
+        return hues.data();
+    }
 };
 
 
@@ -194,8 +195,8 @@ void MeteorsEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffe
 
     if (buffer.needToInit) {
         buffer.needToInit = false;
-        cache->meteors.clear();
-        cache->meteorsRadial.clear();
+        cache->meteors.Clear();
+        cache->meteorsRadial.Clear();
         cache->effectState = mSpeed * buffer.frameTimeInMs / 50;
     } else {
         cache->effectState += mSpeed * buffer.frameTimeInMs / 50;
@@ -235,23 +236,8 @@ void MeteorsEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffe
  * *************************************************************
  */
 
-class MeteorHasExpiredX
-{
-    int TailLength;
-public:
-    MeteorHasExpiredX(int t)
-    : TailLength(t)
-    {}
-
-    // operator() is what's called when you do MeteorHasExpired()
-    bool operator()(const MeteorClass& obj) {
-        return obj.x + TailLength < 0;
-    }
-};
-
 void MeteorsEffect::RenderMeteorsHorizontal(RenderBuffer &buffer, int ColorScheme, int Count, int Length, int MeteorsEffect, int SwirlIntensity, int mspeed)
 {
-    MeteorClass m;
     HSVValue hsv,hsv0,hsv1;
     buffer.palette.GetHSV(0,hsv0);
     buffer.palette.GetHSV(1,hsv1);
@@ -260,48 +246,53 @@ void MeteorsEffect::RenderMeteorsHorizontal(RenderBuffer &buffer, int ColorSchem
     if (TailLength < 1) TailLength=1;
 
     MeteorsRenderCache *cache = GetCache(buffer, id);
+    MeteorList &meteors = cache->meteors;
 
     // create new meteors
 
     for (int i = 0; i < buffer.BufferHt; i++) {
-        if (rand() % 200 < Count) {
-            m.x=buffer.BufferWi - 1;
-            m.y=i;
+        if (buffer.Rand() % 200 < Count) {
+            size_t m = meteors.Add();
+            meteors.Get<METEOR_X>(m)=buffer.BufferWi - 1;
+            meteors.Get<METEOR_Y>(m)=i;
 
             switch (ColorScheme) {
                 case 1:
-                    buffer.SetRangeColor(hsv0,hsv1,m.hsv);
+                    buffer.SetRangeColor(hsv0,hsv1,meteors.Get<METEOR_HSV>(m));
                     break;
                 case 2:
-                    buffer.palette.GetHSV(rand()%colorcnt, m.hsv);
+                    buffer.palette.GetHSV(buffer.Rand()%colorcnt, meteors.Get<METEOR_HSV>(m));
                     break;
             }
-            cache->meteors.push_back(m);
         }
     }
 
     // render meteors
 
-    std::function<void(MeteorClass &, int)> f = [&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity, ColorScheme] (MeteorClass &meteor, int n) {
+    int *mx = meteors.Data<METEOR_X>();
+    int *my = meteors.Data<METEOR_Y>();
+    HSVValue *mhsv = meteors.Data<METEOR_HSV>();
+    const double *hues = ColorScheme == 0 ? cache->DrawHues(buffer, meteors.Size() * (TailLength + 1)) : nullptr;
+    meteors.ForEach([&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity, ColorScheme, hues, mx, my, mhsv](int n) {
         int x,y,dy;
         HSVValue hsv;
         for (int ph = 0; ph <= TailLength; ph++) {
             switch (ColorScheme) {
                 case 0:
-                    hsv.hue=double(rand() % 1000) / 1000.0;
+                    hsv.hue=hues[n * (TailLength + 1) + ph];
                     hsv.saturation=1.0;
                     hsv.value=1.0;
                     break;
                 default:
-                    hsv=meteor.hsv;
+                    hsv=mhsv[n];
                     break;
             }
 
-            double swirl_phase=double(meteor.x)/5.0+double(n)/100.0;
+            double swirl_phase=double(mx[n])/5.0+double(n)/100.0;
             dy=int(double(SwirlIntensity*buffer.BufferHt)/80.0*buffer.sin(swirl_phase));
 
-            x=meteor.x+ph;
-            y=meteor.y+dy;
+            x=mx[n]+ph;
+            y=my[n]+dy;
             if (MeteorsEffect==3) x=buffer.BufferWi-x;
 
             if (buffer.allowAlpha) {
@@ -314,12 +305,11 @@ void MeteorsEffect::RenderMeteorsHorizontal(RenderBuffer &buffer, int ColorSchem
             }
         }
 
-        meteor.x -= mspeed;
-    };
-    parallel_for(cache->meteors, f, 500);
+        mx[n] -= mspeed;
+    }, 500);
 
     // delete old meteors
-    cache->meteors.remove_if(MeteorHasExpiredX(TailLength));
+    meteors.RemoveIf([&meteors, TailLength](size_t n) { return meteors.Get<METEOR_X>(n) + TailLength < 0; });
 }
 
 /*
@@ -328,32 +318,11 @@ void MeteorsEffect::RenderMeteorsHorizontal(RenderBuffer &buffer, int ColorSchem
  * *************************************************************
  */
 
-class MeteorHasExpiredY
-{
-    int TailLength;
-public:
-    MeteorHasExpiredY(int t)
-    : TailLength(t)
-    {}
-
-    // operator() is what's called when you do MeteorHasExpired()
-    bool operator()(const MeteorClass& obj) {
-        return obj.y + TailLength < 0;
-    }
-};
-
-//predicate to remove variable length meteors (icicles):
-class IcicleHasExpired
-{
-public:
-    bool operator()(const MeteorClass& obj) { return obj.y < -obj.h; }
-};
 //bool end_of_icicle(const MeteorClass& obj) { return obj.y > obj.h; }
 
 
 void MeteorsEffect::RenderMeteorsVertical(RenderBuffer &buffer, int ColorScheme, int Count, int Length, int MeteorsEffect, int SwirlIntensity, int mspeed)
 {
-    MeteorClass m;
     HSVValue hsv,hsv0,hsv1;
     buffer.palette.GetHSV(0,hsv0);
     buffer.palette.GetHSV(1,hsv1);
@@ -361,49 +330,54 @@ void MeteorsEffect::RenderMeteorsVertical(RenderBuffer &buffer, int ColorScheme,
     int TailLength=(buffer.BufferHt < 10) ? Length / 10 : buffer.BufferHt * Length / 100;
     if (TailLength < 1) TailLength=1;
     MeteorsRenderCache *cache = GetCache(buffer, id);
+    MeteorList &meteors = cache->meteors;
 
     // create new meteors
 
     for (int i = 0; i < buffer.BufferWi; i++) {
-        if (rand() % 200 < Count) {
-            m.x=i;
-            m.y=buffer.BufferHt - 1;
+        if (buffer.Rand() % 200 < Count) {
+            size_t m = meteors.Add();
+            meteors.Get<METEOR_X>(m)=i;
+            meteors.Get<METEOR_Y>(m)=buffer.BufferHt - 1;
 
             switch (ColorScheme) {
                 case 1:
-                    buffer.SetRangeColor(hsv0,hsv1,m.hsv);
+                    buffer.SetRangeColor(hsv0,hsv1,meteors.Get<METEOR_HSV>(m));
                     break;
                 case 2:
-                    buffer.palette.GetHSV(rand()%colorcnt, m.hsv);
+                    buffer.palette.GetHSV(buffer.Rand()%colorcnt, meteors.Get<METEOR_HSV>(m));
                     break;
             }
-            cache->meteors.push_back(m);
         }
     }
 
     // render meteors
 
-    std::function<void(MeteorClass &, int)> f = [&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity, ColorScheme] (MeteorClass &meteor, int n) {
+    int *mx = meteors.Data<METEOR_X>();
+    int *my = meteors.Data<METEOR_Y>();
+    HSVValue *mhsv = meteors.Data<METEOR_HSV>();
+    const double *hues = ColorScheme == 0 ? cache->DrawHues(buffer, meteors.Size() * (TailLength + 1)) : nullptr;
+    meteors.ForEach([&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity, ColorScheme, hues, mx, my, mhsv](int n) {
         int x,y,dx;
         HSVValue hsv;
         for (int ph = 0; ph <= TailLength; ph++) {
             switch (ColorScheme) {
                 case 0:
-                    hsv.hue=double(rand() % 1000) / 1000.0;
+                    hsv.hue=hues[n * (TailLength + 1) + ph];
                     hsv.saturation=1.0;
                     hsv.value=1.0;
                     break;
                 default:
-                    hsv=meteor.hsv;
+                    hsv=mhsv[n];
                     break;
             }
 
             // we adjust x axis with some sine function if swirl1 or swirl2
             // swirling more than 25% of the buffer width doesn't look good
-            double swirl_phase=double(meteor.y)/5.0+double(n)/100.0;
+            double swirl_phase=double(my[n])/5.0+double(n)/100.0;
             dx=int(double(SwirlIntensity*buffer.BufferWi)/80.0*buffer.sin(swirl_phase));
-            x=meteor.x+dx;
-            y=meteor.y+ph;
+            x=mx[n]+dx;
+            y=my[n]+ph;
             if (MeteorsEffect==1) y=buffer.BufferHt-y;
 
             if (buffer.allowAlpha) {
@@ -416,13 +390,12 @@ void MeteorsEffect::RenderMeteorsVertical(RenderBuffer &buffer, int ColorScheme,
             }
         }
 
-        meteor.y -= mspeed;
-    };
-    parallel_for(cache->meteors, f, 500);
+        my[n] -= mspeed;
+    }, 500);
 
 
     // delete old meteors
-    cache->meteors.remove_if(MeteorHasExpiredY(TailLength));
+    meteors.RemoveIf([&meteors, TailLength](size_t n) { return meteors.Get<METEOR_Y>(n) + TailLength < 0; });
 }
 
 #define numents(thing)  (sizeof(thing) / sizeof(thing[0]))
@@ -440,30 +413,30 @@ void MeteorsEffect::RenderIcicleDrip(RenderBuffer &buffer, int ColorScheme, int
     int TailLength=(buffer.BufferHt < 10) ? Length / 10 : buffer.BufferHt * Length / 100;
     if (TailLength < 1) TailLength=1;
     MeteorsRenderCache *cache = GetCache(buffer, id);
+    MeteorList &meteors = cache->meteors;
     if (buffer.needToInit) {
         buffer.needToInit = false;
-        cache->meteors.clear();
+        meteors.Clear();
     }
 
     // create new meteors
 
-    MeteorClass m;
     for (int i = 0; i < buffer.BufferWi; i++) {
-        if (rand() % 200 < Count) {
-            m.x=i;
-            m.y=buffer.BufferHt - 1;
+        if (buffer.Rand() % 200 < Count) {
+            size_t m = meteors.Add();
+            meteors.Get<METEOR_X>(m)=i;
+            meteors.Get<METEOR_Y>(m)=buffer.BufferHt - 1;
             //            m.h = TailLength;
-            m.h = (rand() % (2 * buffer.BufferHt))/3; //somewhat variable length -DJ
+            meteors.Get<METEOR_H>(m) = (buffer.Rand() % (2 * buffer.BufferHt))/3; //somewhat variable length -DJ
 
             switch (ColorScheme) {
                 case 1:
-                    buffer.SetRangeColor(hsv0,hsv1,m.hsv);
+                    buffer.SetRangeColor(hsv0,hsv1,meteors.Get<METEOR_HSV>(m));
                     break;
                 case 2:
-                    buffer.palette.GetHSV(rand()%colorcnt, m.hsv);
+                    buffer.palette.GetHSV(buffer.Rand()%colorcnt, meteors.Get<METEOR_HSV>(m));
                     break;
             }
-            cache->meteors.push_back(m);
         }
     }
 
@@ -482,31 +455,34 @@ void MeteorsEffect::RenderIcicleDrip(RenderBuffer &buffer, int ColorScheme, int
                 buffer.SetPixel(x, y + ystaggered[(x/3) % numents(ystaggered)], c);
     }
 
-    std::function<void(MeteorClass &, int)> f = [&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity] (MeteorClass &meteor, int n) {
+    int *mx = meteors.Data<METEOR_X>();
+    int *my = meteors.Data<METEOR_Y>();
+    HSVValue *mhsv = meteors.Data<METEOR_HSV>();
+    int *mh = meteors.Data<METEOR_H>();
+    meteors.ForEach([&buffer, MeteorsEffect, TailLength, mspeed, SwirlIntensity, mx, my, mhsv, mh](int n) {
         int x,y,dx;
         HSVValue hsv;
         for (int ph = 0; ph <= TailLength; ph++) {
-            if (!ph || (ph <= meteor.h - meteor.y)) hsv = meteor.hsv; //only make the end of the drip colored
+            if (!ph || (ph <= mh[n] - my[n])) hsv = mhsv[n]; //only make the end of the drip colored
             else { hsv.value = .4; hsv.hue = hsv.saturation = 0; } //white icicle
 
             // we adjust x axis with some sine function if swirl1 or swirl2
             // swirling more than 25% of the buffer width doesn't look good
-            float swirl_phase=float(meteor.y)/5.0f+float(n)/100.0f;
+            float swirl_phase=float(my[n])/5.0f+float(n)/100.0f;
             dx=int(float(SwirlIntensity*buffer.BufferWi)/80.0f*buffer.sin(swirl_phase));
 
-            x=meteor.x+dx;
-            y=meteor.y+ph;
+            x=mx[n]+dx;
+            y=my[n]+ph;
             if (MeteorsEffect==1) y=buffer.BufferHt-y;
-            if (y < meteor.h) continue; //variable length icicle drips -DJ
+            if (y < mh[n]) continue; //variable length icicle drips -DJ
             buffer.SetPixel(x,y,hsv);
         }
-        meteor.y -= mspeed;
-    };
-    parallel_for(cache->meteors, f, 500);
+        my[n] -= mspeed;
+    }, 500);
 
     // delete old meteors
     //    meteors.remove_if(MeteorHasExpiredY(TailLength));
-    cache->meteors.remove_if(IcicleHasExpired());
+    meteors.RemoveIf([&meteors](size_t n) { return meteors.Get<METEOR_Y>(n) < -meteors.Get<METEOR_H>(n); });
 }
 
 /*
@@ -515,19 +491,6 @@ void MeteorsEffect::RenderIcicleDrip(RenderBuffer &buffer, int ColorScheme, int
  * *************************************************************
  */
 
-class MeteorHasExpiredImplode
-{
-    int cx, cy;
-public:
-    MeteorHasExpiredImplode(int centerX, int centerY)
-    { cx=centerX; cy=centerY; }
-
-    // operator() is what's called when you do MeteorHasExpired()
-    bool operator()(const MeteorRadialClass& obj) {
-        return (std::abs(obj.y - cy) < 2) && (std::abs(obj.x - cx) < 2);
-    }
-};
-
 void MeteorsEffect::RenderMeteorsImplode(RenderBuffer &buffer, int ColorScheme, int Count, int Length, int SwirlIntensity, int mspeed, int xoffset, int yoffset, bool fadeWithDistance)
 {
     int truexoffset = xoffset * buffer.BufferWi / 2 / 100;
@@ -542,7 +505,6 @@ void MeteorsEffect::RenderMeteorsImplode(RenderBuffer &buffer, int ColorScheme,
             std::max(sqrt((buffer.BufferWi - centerX)*(buffer.BufferWi - centerX) + (0 - centerY)*(0 - centerY)),
                 sqrt((buffer.BufferWi - centerX)*(buffer.BufferWi - centerX) + (buffer.BufferHt - centerY)*(buffer.BufferHt - centerY)))));
 
-    MeteorRadialClass m;
     HSVValue hsv,hsv0,hsv1;
     buffer.palette.GetHSV(0,hsv0);
     buffer.palette.GetHSV(1,hsv1);
@@ -552,65 +514,73 @@ void MeteorsEffect::RenderMeteorsImplode(RenderBuffer &buffer, int ColorScheme,
     if (TailLength < 1) TailLength=1;
     int MinDimension = buffer.BufferHt < buffer.BufferWi ? buffer.BufferHt : buffer.BufferWi;
     MeteorsRenderCache *cache = GetCache(buffer, id);
+    MeteorRadialList &meteors = cache->meteorsRadial;
 
     // create new meteors
 
-    m.cnt=1;
     for (int i = 0; i < MinDimension; i++) {
-        if (rand() % 200 < Count) {
+        if (buffer.Rand() % 200 < Count) {
+            size_t m = meteors.Add();
+            meteors.Get<RADIAL_CNT>(m)=1;
             if (buffer.BufferHt == 1) {
-                angle=double(rand() % 2) * M_PI;
+                angle=double(buffer.Rand() % 2) * M_PI;
             } else if (buffer.BufferWi == 1) {
-                angle=double(rand() % 2) * M_PI - (M_PI/2.0);
+                angle=double(buffer.Rand() % 2) * M_PI - (M_PI/2.0);
             } else {
-                angle=rand01()*2.0*M_PI;
+                angle=buffer.Rand01()*2.0*M_PI;
             }
-            m.dx=buffer.cos(angle);
-            m.dy=buffer.sin(angle);
+            meteors.Get<RADIAL_DX>(m)=buffer.cos(angle);
+            meteors.Get<RADIAL_DY>(m)=buffer.sin(angle);
             //m.x = centerX + double(halfdiag + TailLength)*m.dx;
             //m.y = centerY + double(halfdiag + TailLength)*m.dy;
-            m.x = centerX + double(maxdiag + TailLength)*m.dx;
-            m.y = centerY + double(maxdiag + TailLength)*m.dy;
+            meteors.Get<RADIAL_X>(m) = centerX + double(maxdiag + TailLength)*meteors.Get<RADIAL_DX>(m);
+            meteors.Get<RADIAL_Y>(m) = centerY + double(maxdiag + TailLength)*meteors.Get<RADIAL_DY>(m);
 
             switch (ColorScheme) {
                 case 1:
-                    buffer.SetRangeColor(hsv0,hsv1,m.hsv);
+                    buffer.SetRangeColor(hsv0,hsv1,meteors.Get<RADIAL_HSV>(m));
                     break;
                 case 2:
-                    buffer.palette.GetHSV(rand()%colorcnt, m.hsv);
+                    buffer.palette.GetHSV(buffer.Rand()%colorcnt, meteors.Get<RADIAL_HSV>(m));
                     break;
             }
-            cache->meteorsRadial.push_back(m);
         }
     }
 
     // render meteors
 
-    std::function<void(MeteorRadialClass&, int)> f = [&buffer, fadeWithDistance, centerX, centerY, maxdiag, TailLength, ColorScheme, mspeed](MeteorRadialClass& meteor, int n) {
+    double *mx = meteors.Data<RADIAL_X>();
+    double *my = meteors.Data<RADIAL_Y>();
+    double *mdx = meteors.Data<RADIAL_DX>();
+    double *mdy = meteors.Data<RADIAL_DY>();
+    int *mcnt = meteors.Data<RADIAL_CNT>();
+    HSVValue *mhsv = meteors.Data<RADIAL_HSV>();
+    const double *hues = ColorScheme == 0 ? cache->DrawHues(buffer, meteors.Size() * (TailLength + 1)) : nullptr;
+    meteors.ForEach([&buffer, fadeWithDistance, centerX, centerY, maxdiag, TailLength, ColorScheme, hues, mspeed, mx, my, mdx, mdy, mcnt, mhsv](int n) {
         int x,y;
         HSVValue hsv;
         float hdistance = 1.0f;
         if (fadeWithDistance) {
-            float x = meteor.x;
-            float y = meteor.y;
+            float x = mx[n];
+            float y = my[n];
             hdistance = std::max(0.1f, (float)sqrt((x - (float)centerX) * (x - (float)centerX) + (y - (float)centerY) * (y - (float)centerY)) / (float)maxdiag);
         }
 
         for (int ph = 0; ph <= TailLength; ph++) {
             switch (ColorScheme) {
                 case 0:
-                    hsv.hue=double(rand() % 1000) / 1000.0;
+                    hsv.hue=hues[n * (TailLength + 1) + ph];
                     hsv.saturation=1.0;
                     hsv.value=1.0;
                     break;
                 default:
-                    hsv=meteor.hsv;
+                    hsv=mhsv[n];
                     break;
             }
             // if we were to swirl, it would need to alter the angle here
 
-            x = int(meteor.x-meteor.dx*double(ph));
-            y = int(meteor.y-meteor.dy*double(ph));
+            x = int(mx[n]-mdx[n]*double(ph));
+            y = int(my[n]-mdy[n]*double(ph));
 
             // the next line cannot test for exact center! Some lines miss by 1 because of rounding.
             if ((abs(y - centerY) < 2) && (abs(x - centerX) < 2)) break;
@@ -634,14 +604,15 @@ void MeteorsEffect::RenderMeteorsImplode(RenderBuffer &buffer, int ColorScheme,
             }
         }
 
-        meteor.x -= meteor.dx*mspeed * hdistance;
-        meteor.y -= meteor.dy*mspeed * hdistance;
-        meteor.cnt++;
-    };
-    parallel_for(cache->meteorsRadial, f, 500);
+        mx[n] -= mdx[n]*mspeed * hdistance;
+        my[n] -= mdy[n]*mspeed * hdistance;
+        mcnt[n]++;
+    }, 500);
 
     // delete old meteors
-    cache->meteorsRadial.remove_if(MeteorHasExpiredImplode(buffer.BufferWi/2+truexoffset,buffer.BufferHt/2+trueyoffset));
+    meteors.RemoveIf([&meteors, centerX, centerY](size_t n) {
+        return (std::abs(meteors.Get<RADIAL_Y>(n) - centerY) < 2) && (std::abs(meteors.Get<RADIAL_X>(n) - centerX) < 2);
+    });
 }
 
 /*
@@ -650,19 +621,6 @@ void MeteorsEffect::RenderMeteorsImplode(RenderBuffer &buffer, int ColorScheme,
  * *************************************************************
  */
 
-class MeteorHasExpiredExplode
-{
-    int ht, wi;
-public:
-    MeteorHasExpiredExplode(int h, int w)
-    { ht=h; wi=w; }
-
-    // operator() is what's called when you do MeteorHasExpired()
-    bool operator()(const MeteorRadialClass& obj) {
-        return obj.y < 0 || obj.x < 0 || obj.y > ht || obj.x > wi;
-    }
-};
-
 void MeteorsEffect::RenderMeteorsExplode(RenderBuffer &buffer, int ColorScheme, int Count, int Length, int SwirlIntensity, int mspeed, int xoffset, int yoffset, bool fadeWithDistance)
 {
     int truexoffset = xoffset * buffer.BufferWi / 2 / 100;
@@ -677,7 +635,6 @@ void MeteorsEffect::RenderMeteorsExplode(RenderBuffer &buffer, int ColorScheme,
             std::max(sqrt((buffer.BufferWi - centerX)*(buffer.BufferWi - centerX) + (0 - centerY)*(0 - centerY)),
                 sqrt((buffer.BufferWi - centerX)*(buffer.BufferWi - centerX) + (buffer.BufferHt - centerY)*(buffer.BufferHt - centerY)))));
 
-    MeteorRadialClass m;
     HSVValue hsv,hsv0,hsv1;
     buffer.palette.GetHSV(0,hsv0);
     buffer.palette.GetHSV(1,hsv1);
@@ -687,46 +644,54 @@ void MeteorsEffect::RenderMeteorsExplode(RenderBuffer &buffer, int ColorScheme,
     if (TailLength < 1) TailLength=1;
     int MinDimension = buffer.BufferHt < buffer.BufferWi ? buffer.BufferHt : buffer.BufferWi;
     MeteorsRenderCache *cache = GetCache(buffer, id);
+    MeteorRadialList &meteors = cache->meteorsRadial;
 
     // create new meteors
 
-    m.x=buffer.BufferWi/2+truexoffset;
-    m.y=buffer.BufferHt/2+trueyoffset;
-    m.cnt=1;
     for (int i = 0; i < MinDimension; i++) {
-        if (rand() % 200 < Count) {
+        if (buffer.Rand() % 200 < Count) {
+            size_t m = meteors.Add();
+            meteors.Get<RADIAL_X>(m)=buffer.BufferWi/2+truexoffset;
+            meteors.Get<RADIAL_Y>(m)=buffer.BufferHt/2+trueyoffset;
+            meteors.Get<RADIAL_CNT>(m)=1;
             if (buffer.BufferHt == 1) {
-                angle=double(rand() % 2) * M_PI;
+                angle=double(buffer.Rand() % 2) * M_PI;
             } else if (buffer.BufferWi == 1) {
-                angle=double(rand() % 2) * M_PI - (M_PI/2.0);
+                angle=double(buffer.Rand() % 2) * M_PI - (M_PI/2.0);
             } else {
-                angle=rand01()*2.0*M_PI;
+                angle=buffer.Rand01()*2.0*M_PI;
             }
-            m.dx=buffer.cos(angle);
-            m.dy=buffer.sin(angle);
+            meteors.Get<RADIAL_DX>(m)=buffer.cos(angle);
+            meteors.Get<RADIAL_DY>(m)=buffer.sin(angle);
 
             switch (ColorScheme) {
                 case 1:
-                    buffer.SetRangeColor(hsv0,hsv1,m.hsv);
+                    buffer.SetRangeColor(hsv0,hsv1,meteors.Get<RADIAL_HSV>(m));
                     break;
                 case 2:
-                    buffer.palette.GetHSV(rand()%colorcnt, m.hsv);
+                    buffer.palette.GetHSV(buffer.Rand()%colorcnt, meteors.Get<RADIAL_HSV>(m));
                     break;
             }
-            cache->meteorsRadial.push_back(m);
         }
     }
 
     // render meteors
 
-    std::function<void(MeteorRadialClass&, int)> f = [&buffer, fadeWithDistance, centerX, centerY, maxdiag, TailLength, ColorScheme, mspeed](MeteorRadialClass& meteor, int n) {
+    double *mx = meteors.Data<RADIAL_X>();
+    double *my = meteors.Data<RADIAL_Y>();
+    double *mdx = meteors.Data<RADIAL_DX>();
+    double *mdy = meteors.Data<RADIAL_DY>();
+    int *mcnt = meteors.Data<RADIAL_CNT>();
+    HSVValue *mhsv = meteors.Data<RADIAL_HSV>();
+    const double *hues = ColorScheme == 0 ? cache->DrawHues(buffer, meteors.Size() * (TailLength + 1)) : nullptr;
+    meteors.ForEach([&buffer, fadeWithDistance, centerX, centerY, maxdiag, TailLength, ColorScheme, hues, mspeed, mx, my, mdx, mdy, mcnt, mhsv](int n) {
         int x,y;
         HSVValue hsv;
 
         float hdistance = 1.0f;
         if (fadeWithDistance) {
-            float x = meteor.x;
-            float y = meteor.y;
+            float x = mx[n];
+            float y = my[n];
             hdistance = std::max(0.1f, (float)sqrt((x - (float)centerX) * (x - (float)centerX) + (y - (float)centerY) * (y - (float)centerY)) / (float)maxdiag);
         }
 
@@ -734,19 +699,19 @@ void MeteorsEffect::RenderMeteorsExplode(RenderBuffer &buffer, int ColorScheme,
             //if (ph >= it->cnt) continue;
             switch (ColorScheme) {
                 case 0:
-                    hsv.hue=double(rand() % 1000) / 1000.0;
+                    hsv.hue=hues[n * (TailLength + 1) + ph];
                     hsv.saturation=1.0;
                     hsv.value=1.0;
                     break;
                 default:
-                    hsv=meteor.hsv;
+                    hsv=mhsv[n];
                     break;
             }
 
             // if we were to swirl, it would need to alter the angle here
 
-            x=int(meteor.x+meteor.dx*double(ph));
-            y=int(meteor.y+meteor.dy*double(ph));
+            x=int(mx[n]+mdx[n]*double(ph));
+            y=int(my[n]+mdy[n]*double(ph));
 
             if (fadeWithDistance) {
                 // distance
@@ -767,13 +732,18 @@ void MeteorsEffect::RenderMeteorsExplode(RenderBuffer &buffer, int ColorScheme,
             }
         }
 
-        meteor.x += meteor.dx*mspeed * hdistance;
-        meteor.y += meteor.dy*mspeed * hdistance;
-        meteor.cnt++;
-    };
-    parallel_for(cache->meteorsRadial, f, 500);
+        mx[n] += mdx[n]*mspeed * hdistance;
+        my[n] += mdy[n]*mspeed * hdistance;
+        mcnt[n]++;
+    }, 500);
 
     // delete old meteors
-    cache->meteorsRadial.remove_if(MeteorHasExpiredExplode(buffer.BufferHt,buffer.BufferWi));
+    int ht = buffer.BufferHt;
+    int wi = buffer.BufferWi;
+    meteors.RemoveIf([&meteors, ht, wi](size_t n) {
+        double x = meteors.Get<RADIAL_X>(n);
+        double y = meteors.Get<RADIAL_Y>(n);
+        return y < 0 || x < 0 || y > ht || x > wi;
+    });
 }
 
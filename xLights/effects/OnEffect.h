@@ -26,7 +26,8 @@ class OnEffect : public RenderableEffect
         virtual bool SupportsLinearColorCurves(const SettingsMap &SettingsMap) const override { return true; }
         virtual void SetDefaultParameters() override;
         virtual std::string GetEffectString() override;
-        virtual bool CanRenderPartialTimeInterval() const override { return true; }
+        // the background display list is built up frame by frame and shared by every buffer rendering the effect
+        //virtual bool CanRenderPartialTimeInterval() const override { return true; }
 
     protected:
         virtual void RemoveDefaults(const std::string &version, Effect *effect) override;
@@ -0,0 +1,122 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../Parallel.h"
+
+/**
+ * A pool of particles stored as a structure of arrays. Each field type in the template
+ * arguments gets its own contiguous array so update and draw loops only touch the fields
+ * they use, and adding and removing particles reuses the same memory frame after frame.
+ * Fields are addressed by their position in the template arguments:
+ *
+ * enum { X, Y, AGE };
+ * ParticlePool<float, float, int> pool;
+ * size_t p = pool.Add();
+ * pool.Get<X>(p) = 1.0f;
+ * pool.ForEach([&](int i) { pool.Get<AGE>(i)++; });
+ * pool.RemoveIf([&](size_t i) { return pool.Get<AGE>(i) > 10; });
+ *
+ * Use uint8_t rather than bool for flags as std::vector<bool> cannot hand out references.
+ */
+template <typename... Fields>
+class ParticlePool
+{
+public:
+    template <size_t F>
+    using FieldType = typename std::tuple_element<F, std::tuple<Fields...>>::type;
+
+    size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+    // drops all the particles but keeps the memory for reuse
+    void Clear() { _size = 0; }
+
+    void Reserve(size_t count) {
+        if (count > _capacity) {
+            ResizeFields(count, std::index_sequence_for<Fields...>());
+            _capacity = count;
+        }
+    }
+
+    // appends a particle with default initialised fields and returns its index
+    size_t Add() {
+        if (_size == _capacity) {
+            Reserve(_capacity == 0 ? 64 : _capacity * 2);
+        }
+        ResetFields(_size, std::index_sequence_for<Fields...>());
+        return _size++;
+    }
+
+    template <size_t F>
+    FieldType<F>& Get(size_t index) { return std::get<F>(_fields)[index]; }
+    template <size_t F>
+    const FieldType<F>& Get(size_t index) const { return std::get<F>(_fields)[index]; }
+    template <size_t F>
+    FieldType<F>* Data() { return std::get<F>(_fields).data(); }
+
+    // removes a particle by moving the last one into its place so the order is not kept
+    void SwapRemove(size_t index) {
+        --_size;
+        if (index != _size) {
+            MoveFields(_size, index, std::index_sequence_for<Fields...>());
+        }
+    }
+
+    // removes every particle the predicate returns true for, the rest keep their order
+    // so anything drawn in particle order looks the same
+    template <typename Pred>
+    void RemoveIf(Pred expired) {
+        size_t out = 0;
+        for (size_t i = 0; i < _size; ++i) {
+            if (!expired(i)) {
+                if (out != i) {
+                    MoveFields(i, out, std::index_sequence_for<Fields...>());
+                }
+                ++out;
+            }
+        }
+        _size = out;
+    }
+
+    // calls f for each particle index, spreading the work over the parallel job pool
+    // once there are at least minStep particles for each thread
+    void ForEach(std::function<void(int)>&& f, int minStep = 1) {
+        parallel_for(0, (int)_size, std::move(f), minStep);
+    }
+
+private:
+    template <size_t... I>
+    void ResizeFields(size_t count, std::index_sequence<I...>) {
+        int dummy[] = { 0, (std::get<I>(_fields).resize(count), 0)... };
+        (void)dummy;
+    }
+    template <size_t... I>
+    void ResetFields(size_t index, std::index_sequence<I...>) {
+        int dummy[] = { 0, (std::get<I>(_fields)[index] = FieldType<I>(), 0)... };
+        (void)dummy;
+    }
+    template <size_t... I>
+    void MoveFields(size_t from, size_t to, std::index_sequence<I...>) {
+        int dummy[] = { 0, (std::get<I>(_fields)[to] = std::move(std::get<I>(_fields)[from]), 0)... };
+        (void)dummy;
+    }
+
+    std::tuple<std::vector<Fields>...> _fields;
+    size_t _size = 0;
+    size_t _capacity = 0;
+};
@@ -53,6 +53,8 @@ class RenderableEffect
         virtual std::list<std::string> GetFacesUsed(const SettingsMap &SettingsMap) const { return std::list<std::string>(); }
         virtual bool CleanupFileLocations(xLightsFrame* frame, SettingsMap &SettingsMap) { return false; }
         virtual bool AppropriateOnNodes() const { return true; }
+        // true if any frame can be rendered without first rendering the frames before it (nothing carried from frame to frame
+        // in the render cache, the buffer or the random number stream) ... lets the renderer split a model's frames across threads
         virtual bool CanRenderPartialTimeInterval() const { return false; }
         virtual bool PressButton(const std::string& id, SettingsMap& paletteMap, SettingsMap& settings) { return false; }
 
@@ -19,6 +19,8 @@
 #include "UtilFunctions.h"
 #include "AudioManager.h"
 
+#include <algorithm>
+
 #include "../../include/shape-16.xpm"
 #include "../../include/shape-24.xpm"
 #include "../../include/shape-32.xpm"
@@ -212,9 +214,9 @@ public:
     }
 };
 
-bool compare_shapes(const ShapeData* first, const ShapeData* second)
+bool compare_shapes(const ShapeData& first, const ShapeData& second)
 {
-    return first->_oset > second->_oset;
+    return first._oset > second._oset;
 }
 
 class ShapeRenderCache : public EffectRenderCache {
@@ -226,47 +228,43 @@ public:
         DeleteShapes();
     }
 
-    std::list<ShapeData*> _shapes;
+    // shapes are held by value so the draw loop walks contiguous memory
+    std::vector<ShapeData> _shapes;
     int _lastColorIdx;
     int _sinceLastTriggered;
     wxFontInfo _font;
 
-    void AddShape(wxPoint centre, float size, xlColor color, int oset, int shape, int angle, int speed, bool randomMovement, bool holdColour, int colourIndex)
+    void AddShape(RenderBuffer& buffer, wxPoint centre, float size, xlColor color, int oset, int shape, int angle, int speed, bool randomMovement, bool holdColour, int colourIndex)
     {
         if (randomMovement)
         {
-            speed = rand01() * (SHAPE_VELOCITY_MAX - SHAPE_VELOCITY_MIN) - SHAPE_VELOCITY_MIN;
-            angle = rand01() * (SHAPE_DIRECTION_MAX - SHAPE_DIRECTION_MIN) - SHAPE_VELOCITY_MIN;
+            speed = buffer.Rand01() * (SHAPE_VELOCITY_MAX - SHAPE_VELOCITY_MIN) - SHAPE_VELOCITY_MIN;
+            angle = buffer.Rand01() * (SHAPE_DIRECTION_MAX - SHAPE_DIRECTION_MIN) - SHAPE_VELOCITY_MIN;
         }
-        _shapes.push_back(new ShapeData(centre, size, oset, color, shape, angle, speed, holdColour, colourIndex));
+        _shapes.emplace_back(centre, size, oset, color, shape, angle, speed, holdColour, colourIndex);
     }
 
     void DeleteShapes()
     {
-        while (_shapes.size() > 0)
-        {
-            auto todelete = _shapes.front();
-            _shapes.pop_front();
-            delete todelete;
-        }
+        _shapes.clear();
     }
     void RemoveOld(int maxAge)
     {
         // old are always at the front of the list
-        while (_shapes.size() > 0 && _shapes.front()->_oset >= maxAge)
+        auto it = _shapes.begin();
+        while (it != _shapes.end() && it->_oset >= maxAge)
         {
-            auto todelete = _shapes.front();
-            _shapes.pop_front();
-            delete todelete;
+            ++it;
         }
+        _shapes.erase(_shapes.begin(), it);
     }
     void SortShapes()
     {
-        _shapes.sort(compare_shapes);
+        std::stable_sort(_shapes.begin(), _shapes.end(), compare_shapes);
     }
 };
 
-int ShapeEffect::DecodeShape(const std::string& shape)
+int ShapeEffect::DecodeShape(const std::string& shape, RenderBuffer& buffer)
 {
     if (shape == "Circle")
     {
@@ -330,7 +328,7 @@ int ShapeEffect::DecodeShape(const std::string& shape)
         return RENDER_SHAPE_EMOJI;
     }
 
-    return rand01() * 14; // exclude emoji
+    return buffer.Rand01() * 14; // exclude emoji
 }
 
 void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer &buffer) {
@@ -358,7 +356,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
 
     int rotation = GetValueCurveInt("Shape_Rotation", 0, SettingsMap, oset, SHAPE_ROTATION_MIN, SHAPE_ROTATION_MAX, buffer.GetStartTimeMS(), buffer.GetEndTimeMS());
 
-    int Object_To_Draw = DecodeShape(Object_To_DrawStr);
+    int Object_To_Draw = DecodeShape(Object_To_DrawStr, buffer);
 
     float f = 0.0;
     bool useMusic = SettingsMap.GetBool("CHECKBOX_Shape_UseMusic", false);
@@ -383,7 +381,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
         buffer.infoCache[id] = cache;
     }
 
-    std::list<ShapeData*>& _shapes = cache->_shapes;
+    std::vector<ShapeData>& _shapes = cache->_shapes;
     int& _lastColorIdx = cache->_lastColorIdx;
     int& _sinceLastTriggered = cache->_sinceLastTriggered;
     wxFontInfo& _font = cache->_font;
@@ -420,7 +418,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 wxPoint pt;
                 if (randomLocation)
                 {
-                    pt = wxPoint(rand01() * buffer.BufferWi, rand01() * buffer.BufferHt);
+                    pt = wxPoint(buffer.Rand01() * buffer.BufferWi, buffer.Rand01() * buffer.BufferHt);
                 }
                 else
                 {
@@ -437,10 +435,10 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 int os = 0;
                 if (startRandomly)
                 {
-                    os = rand01() * lifetimeFrames;
+                    os = buffer.Rand01() * lifetimeFrames;
                 }
 
-                cache->AddShape(pt, startSize + os * growthPerFrame, buffer.palette.GetColor(_lastColorIdx), os, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
+                cache->AddShape(buffer, pt, startSize + os * growthPerFrame, buffer.palette.GetColor(_lastColorIdx), os, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
             }
             cache->SortShapes();
         }
@@ -486,7 +484,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                         wxPoint pt;
                         if (randomLocation)
                         {
-                            pt = wxPoint(rand01() * buffer.BufferWi, rand01() * buffer.BufferHt);
+                            pt = wxPoint(buffer.Rand01() * buffer.BufferWi, buffer.Rand01() * buffer.BufferHt);
                         }
                         else
                         {
@@ -500,7 +498,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                             _lastColorIdx = 0;
                         }
 
-                        cache->AddShape(pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
+                        cache->AddShape(buffer, pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
                         break;
                     }
                 }
@@ -518,7 +516,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 wxPoint pt;
                 if (randomLocation)
                 {
-                    pt = wxPoint(rand01() * buffer.BufferWi, rand01() * buffer.BufferHt);
+                    pt = wxPoint(buffer.Rand01() * buffer.BufferWi, buffer.Rand01() * buffer.BufferHt);
                 }
                 else
                 {
@@ -532,7 +530,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                     _lastColorIdx = 0;
                 }
 
-                cache->AddShape(pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
+                cache->AddShape(buffer, pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
             }
 
             // if music is over the trigger level for REPEATTRIGGER frames then we will trigger another firework
@@ -555,7 +553,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
             wxPoint pt;
             if (randomLocation)
             {
-                pt = wxPoint(rand01() * buffer.BufferWi, rand01() * buffer.BufferHt);
+                pt = wxPoint(buffer.Rand01() * buffer.BufferWi, buffer.Rand01() * buffer.BufferHt);
             }
             else
             {
@@ -569,7 +567,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
                 _lastColorIdx = 0;
             }
 
-            cache->AddShape(pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
+            cache->AddShape(buffer, pt, startSize, buffer.palette.GetColor(_lastColorIdx), 0, Object_To_Draw, direction, velocity, randomMovement, holdColour, _lastColorIdx);
         }
     }
 
@@ -579,7 +577,7 @@ void ShapeEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffer
         context->Clear();
     }
 
-    for (const auto& it : _shapes)
+    for (auto it = _shapes.begin(); it != _shapes.end(); ++it)
     {
         // if location is not random then update it to whatever the current location is
         // as it may be value curve controlled
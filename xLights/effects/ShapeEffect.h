@@ -63,7 +63,7 @@ protected:
         virtual wxPanel *CreatePanel(wxWindow *parent) override;
     private:
 
-    static int DecodeShape(const std::string& shape);
+    static int DecodeShape(const std::string& shape, RenderBuffer& buffer);
         void SetPanelTimingTracks() const;
         void Drawcircle(RenderBuffer &buffer, int xc, int yc, double radius, xlColor color, int thickness) const;
         void Drawheart(RenderBuffer &buffer, int xc, int yc, double radius, xlColor color, int thickness, double rotation) const;
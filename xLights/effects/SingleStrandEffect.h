@@ -29,7 +29,8 @@ class SingleStrandEffect : public RenderableEffect
         virtual void SetDefaultParameters() override;
         virtual void Render(Effect *effect, SettingsMap &settings, RenderBuffer &buffer) override;
         virtual bool SupportsLinearColorCurves(const SettingsMap &SettingsMap) const override { return true; }
-        virtual bool CanRenderPartialTimeInterval() const override { return true; }
+        // the chase direction is set up in needToInit and skips resizes the shared background display list there
+        //virtual bool CanRenderPartialTimeInterval() const override { return true; }
 
     protected:
         virtual wxPanel *CreatePanel(wxWindow *parent) override;
@@ -127,7 +127,7 @@ void SpirographEffect::Render(Effect* effect, SettingsMap& SettingsMap, RenderBu
         buffer.palette.GetHSV(ColorIdx, hsv); // Now go and get the hsv value for this ColorIdx
 
         buffer.palette.GetHSV(0, hsv0);
-        ColorIdx = (state + rand()) % colorcnt; // Select random numbers from 0 up to number of colors the user has checked. 0-5 if 6 boxes checked
+        ColorIdx = (state + buffer.Rand()) % colorcnt; // Select random numbers from 0 up to number of colors the user has checked. 0-5 if 6 boxes checked
         buffer.palette.GetHSV(ColorIdx, hsv1); // Now go and get the hsv value for this ColorIdx
 
         // work out the normal to the point being drawn
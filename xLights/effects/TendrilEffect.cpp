@@ -82,34 +82,7 @@ void TendrilEffect::adjustSettings(const std::string &version, Effect *effect, b
 	}
 }
 
-TendrilNode::TendrilNode(float x_, float y_)
-{
-    x = x_;
-    y = y_;
-    vx = 0;
-    vy = 0;
-}
-
-// Note callers of this function have to delete the returned wxPoint
-wxPoint* TendrilNode::Point()
-{
-    return new wxPoint(rint(x) ,rint(y));
-}
-
-ATendril::~ATendril()
-{
-	while (_nodes.size() != 0)
-	{
-		TendrilNode* p = _nodes.front();
-		_nodes.pop_front();
-		if (p != nullptr)
-		{
-			delete p;
-		}
-	}
-}
-
-ATendril::ATendril(float friction, int size, float dampening, float tension, float spring, const wxPoint& start, size_t maxx, size_t maxy)
+ATendril::ATendril(RenderBuffer& buffer, float friction, int size, float dampening, float tension, float spring, const wxPoint& start, size_t maxx, size_t maxy)
 {
     _width = maxx;
     _height = maxy;
@@ -136,130 +109,113 @@ ATendril::ATendril(float friction, int size, float dampening, float tension, flo
 	_friction = 0.5f;
 	if (friction >= 0)
 	{
-		_friction = friction + ((float)rand())/(float)RAND_MAX * 0.01f - 0.005f;
+		_friction = friction + (float)buffer.Rand01() * 0.01f - 0.005f;
 	}
 	else
 	{
-		_friction = _friction + ((float)rand())/(float)RAND_MAX * 0.01f - 0.005f;
+		_friction = _friction + (float)buffer.Rand01() * 0.01f - 0.005f;
 	}
 
-    _nodes.clear();
+    _nodes.Clear();
+    _nodes.Reserve(_size);
 	for (size_t i = 0; i < _size; i++)
 	{
-		TendrilNode* node = new TendrilNode(start.x, start.y);
-		if (node != nullptr)
-		{
-			_nodes.push_back(node);
-		}
+		size_t node = _nodes.Add();
+		_nodes.Get<TENDRIL_X>(node) = start.x;
+		_nodes.Get<TENDRIL_Y>(node) = start.y;
 	}
 }
 
 void ATendril::Update(wxPoint* target)
 {
+    size_t count = _nodes.Size();
+    if (count == 0) return;
+
+    // each node chases the one before it so this has to run in order, but walking
+    // the separate position and velocity arrays keeps it all in cache
+    float* x = _nodes.Data<TENDRIL_X>();
+    float* y = _nodes.Data<TENDRIL_Y>();
+    float* vx = _nodes.Data<TENDRIL_VX>();
+    float* vy = _nodes.Data<TENDRIL_VY>();
+
 	float spring = _spring;
-	TendrilNode* node = _nodes.front();
-	if (node != nullptr)
-	{
-		node->vx += (target->x - node->x) * spring;
-		node->vy += (target->y - node->y) * spring;
+	vx[0] += (target->x - x[0]) * spring;
+	vy[0] += (target->y - y[0]) * spring;
 
-		TendrilNode* prev = nullptr;
-		for (std::list<TendrilNode*>::const_iterator ci = _nodes.begin(); ci != _nodes.end(); ++ci)
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i > 0)
 		{
-			node = *ci;
-			if (prev != nullptr)
-			{
-				node->vx += (prev->x - node->x) * spring;
-				node->vy += (prev->y - node->y) * spring;
-				node->vx += prev->vx * _dampening;
-				node->vy += prev->vy * _dampening;
-			}
-			node->vx *= _friction;
-			node->vy *= _friction;
-			node->x += node->vx;
-			node->y += node->vy;
-			if (node->x < -1 * _width)
-			{
-				node->x = -1 * _width;
-			}
-			if (node->x > 2 * _width)
-			{
-				node->x = 2 * _width;
-			}
-			if (node->y < -1 * _height)
-			{
-				node->y = -1 * _height;
-			}
-			if (node->y > 2 * _height)
-			{
-				node->y = 2 * _height;
-			}
-			prev = node;
-			spring *= _tension;
+			vx[i] += (x[i - 1] - x[i]) * spring;
+			vy[i] += (y[i - 1] - y[i]) * spring;
+			vx[i] += vx[i - 1] * _dampening;
+			vy[i] += vy[i - 1] * _dampening;
+		}
+		vx[i] *= _friction;
+		vy[i] *= _friction;
+		x[i] += vx[i];
+		y[i] += vy[i];
+		if (x[i] < -1 * _width)
+		{
+			x[i] = -1 * _width;
+		}
+		if (x[i] > 2 * _width)
+		{
+			x[i] = 2 * _width;
 		}
+		if (y[i] < -1 * _height)
+		{
+			y[i] = -1 * _height;
+		}
+		if (y[i] > 2 * _height)
+		{
+			y[i] = 2 * _height;
+		}
+		spring *= _tension;
 	}
 }
 
 void ATendril::Draw(PathDrawingContext* gc, xlColor colour, int thickness)
 {
+    size_t count = _nodes.Size();
+    if (count < 2) return;
+
+    const float* x = _nodes.Data<TENDRIL_X>();
+    const float* y = _nodes.Data<TENDRIL_Y>();
+
     wxColor c(colour);
     wxPen pen(c, thickness);
     gc->SetPen(pen);
 
     wxGraphicsPath path = gc->CreatePath();
-    path.MoveToPoint(_nodes.front()->x, _nodes.front()->y);
-
-    std::list<TendrilNode*>::const_iterator ci = _nodes.begin();
-    ++ci; // move to second node
+    path.MoveToPoint(x[0], y[0]);
 
-    std::list<TendrilNode*>::const_iterator ci_second_last = _nodes.end();
-    --ci_second_last;
-    --ci_second_last;
-
-    for(;ci != ci_second_last; ++ci)
+    // curve through the mid points of the second to second last nodes
+    size_t i = 1;
+    for (; i + 2 < count; ++i)
     {
-        TendrilNode* a = *ci;
-        std::list<TendrilNode*>::const_iterator cinext = ci;
-        ++cinext;
-        TendrilNode* b = *cinext;
-        float x = (a->x + b->x) * 0.5;
-        float y = (a->y + b->y) * 0.5;
-        path.AddQuadCurveToPoint(a->x, a->y, x, y);
+        float mx = (x[i] + x[i + 1]) * 0.5;
+        float my = (y[i] + y[i + 1]) * 0.5;
+        path.AddQuadCurveToPoint(x[i], y[i], mx, my);
     }
 
-    TendrilNode* a = *ci;
-    TendrilNode* b = *(++ci);
-    path.AddQuadCurveToPoint(a->x, a->y, b->x, b->y);
+    i = count - 2;
+    path.AddQuadCurveToPoint(x[i], y[i], x[i + 1], y[i + 1]);
     gc->StrokePath(path);
 }
 
+// Note callers of this function have to delete the returned wxPoint
 wxPoint* ATendril::LastLocation()
 {
-    TendrilNode *last = _nodes.back();
-    if (last != nullptr)
-    {
-        return last->Point();
-    }
-    else
+    if (_nodes.Empty())
     {
         return nullptr;
     }
+    size_t last = _nodes.Size() - 1;
+    return new wxPoint(rint(_nodes.Get<TENDRIL_X>(last)), rint(_nodes.Get<TENDRIL_Y>(last)));
 }
 
-Tendril::~Tendril()
-{
-	while (_tendrils.size() != 0)
-	{
-		ATendril* p = _tendrils.front();
-		_tendrils.pop_front();
-		if (p != nullptr)
-		{
-			delete p;
-		}
-	}
-}
-
-Tendril::Tendril(float friction, int trails, int size, float dampening, float tension, float springbase, float springincr, const wxPoint& start, size_t maxx, size_t maxy)
+Tendril::Tendril(RenderBuffer& buffer, float friction, int trails, int size, float dampening, float tension, float springbase, float springincr, const wxPoint& start, size_t maxx, size_t maxy)
 {
     _width = maxx;
     _height = maxy;
@@ -280,18 +236,15 @@ Tendril::Tendril(float friction, int trails, int size, float dampening, float te
 	}
 
 	_tendrils.clear();
+	_tendrils.reserve(t);
 	for (int i = 0; i < t; i++)
 	{
 		float aspring = sb + si * ((float)i / (float)t);
-		ATendril* at = new ATendril(friction, size, dampening, tension, aspring, start, maxx, maxy);
-		if (at != nullptr)
-		{
-			_tendrils.push_back(at);
-		}
+		_tendrils.emplace_back(buffer, friction, size, dampening, tension, aspring, start, maxx, maxy);
 	}
 }
 
-void Tendril::UpdateRandomMove(int tunemovement)
+void Tendril::UpdateRandomMove(RenderBuffer& buffer, int tunemovement)
 {
     if (tunemovement < 1)
     {
@@ -307,10 +260,9 @@ void Tendril::UpdateRandomMove(int tunemovement)
 	int maxmovex = _width * 2 * tunemovement / 20;
 	int maxmovey = _height * 2 * tunemovement / 20;
 
-	ATendril* t = _tendrils.front();
-	if (t != nullptr)
+	if (!_tendrils.empty())
 	{
-		wxPoint* current = t->LastLocation();
+		wxPoint* current = _tendrils.front().LastLocation();
 
 		if (current != nullptr)
 		{
@@ -340,12 +292,12 @@ void Tendril::UpdateRandomMove(int tunemovement)
 			int x = 0;
 			if (xmove > 0)
 			{
-				x = (rand() % xmove) + realminmovex;
+				x = (buffer.Rand() % xmove) + realminmovex;
 			}
 			int y = 0;
 			if (ymove > 0)
 			{
-				y = (rand() % ymove) + realminmovey;
+				y = (buffer.Rand() % ymove) + realminmovey;
 			}
 
 			current->x = current->x + x;
@@ -387,9 +339,9 @@ void Tendril::UpdateRandomMove(int tunemovement)
 
 void Tendril::Update(wxPoint* target)
 {
-    for (std::list<ATendril*>::const_iterator ci = _tendrils.begin(); ci != _tendrils.end(); ++ci)
+    for (auto& it : _tendrils)
     {
-        (*ci)->Update(target);
+        it.Update(target);
     }
 }
 
@@ -401,9 +353,9 @@ void Tendril::Update(int x, int y)
 
 void Tendril::Draw(PathDrawingContext* gc, xlColor colour, int thickness)
 {
-	for (std::list<ATendril*>::const_iterator ci = _tendrils.begin(); ci != _tendrils.end(); ++ci)
+	for (auto& it : _tendrils)
 	{
-		(*ci)->Draw(gc, colour, thickness);
+		it.Draw(gc, colour, thickness);
 	}
 }
 
@@ -601,7 +553,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
         {
         case 1:
             // random
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 2:
             // corners
@@ -613,7 +565,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
             {
                 _mv4 = 1;
             }
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startbottomleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startbottomleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 3:
             // circles
@@ -624,7 +576,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
             {
                 _mv3 = 1;
             }
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 4:
             // horizontal zig zag
@@ -635,14 +587,14 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
                 _mv2 = 1;
             }
             _mv3 = 1; // direction
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddlebottom, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddlebottom, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 5:
             // vertical zig zag
             _mv1 = 0 + truexoffset; // current x
             _mv2 = (double)tunemovement * 1.5;
             _mv3 = 1; // direction
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddleleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddleleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 6:
             // line movement based on music
@@ -652,7 +604,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
             {
                 _mv3 = 1;
             }
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startbottomleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startbottomleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 7:
             // circle movement based on music
@@ -663,7 +615,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
             {
                 _mv3 = 1;
             }
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddle, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 9:
             // horizontal zig zag return
@@ -674,17 +626,17 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
                 _mv2 = 1;
             }
             _mv3 = 1; // direction
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddlebottom, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddlebottom, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 8:
             // vertical zig zag return
             _mv1 = 0; // current x
             _mv2 = (double)tunemovement * 1.5;
             _mv3 = 1; // direction
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, startmiddleleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, startmiddleleft, buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         case 10:
-            _tendril = new Tendril(friction, trails, length, dampening, tension, -1, -1, wxPoint(manualx * buffer.BufferWi / 100, manualy * buffer.BufferHt / 100), buffer.ModelBufferWi, buffer.ModelBufferHt);
+            _tendril = new Tendril(buffer, friction, trails, length, dampening, tension, -1, -1, wxPoint(manualx * buffer.BufferWi / 100, manualy * buffer.BufferHt / 100), buffer.ModelBufferWi, buffer.ModelBufferHt);
             break;
         }
     }
@@ -710,7 +662,7 @@ void TendrilEffect::Render(RenderBuffer &buffer, const std::string& movement,
             // random
             if (_tendril != nullptr)
             {
-                _tendril->UpdateRandomMove(tunemovement);
+                _tendril->UpdateRandomMove(buffer, tunemovement);
             }
             break;
         case 2:
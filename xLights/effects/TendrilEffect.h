@@ -13,10 +13,11 @@
 #include "RenderableEffect.h"
 #include "../RenderBuffer.h"
 #include <string>
-#include <list>
+#include <vector>
 #include <wx/gdicmn.h>
 #include <wx/colour.h>
 #include <wx/dcmemory.h>
+#include "ParticlePool.h"
 class wxString;
 
 #define TENDRIL_MOVEMENT_MIN 0
@@ -37,17 +38,9 @@ class wxString;
 #define TENDRIL_OFFSETY_MIN -100
 #define TENDRIL_OFFSETY_MAX 100
 
-class TendrilNode
-{
-    public:
-    float x;
-    float y;
-    float vx;
-    float vy;
-
-    TendrilNode(float x_, float y_);
-    wxPoint* Point();
-};
+// tendril node position and velocity
+enum { TENDRIL_X, TENDRIL_Y, TENDRIL_VX, TENDRIL_VY };
+typedef ParticlePool<float, float, float, float> TendrilNodes;
 
 class ATendril
 {
@@ -60,12 +53,11 @@ class ATendril
 	int _width;
 	int _height;
 
-    std::list<TendrilNode*> _nodes;
+    TendrilNodes _nodes;
 
 	public:
 
-	~ATendril();
-	ATendril(float friction, int size, float dampening, float tension, float spring, const wxPoint& start, size_t maxx, size_t maxy);
+	ATendril(RenderBuffer& buffer, float friction, int size, float dampening, float tension, float spring, const wxPoint& start, size_t maxx, size_t maxy);
 	void Update(wxPoint* target);
 	void Draw(PathDrawingContext* gc, xlColor colour, int thickness);
 	wxPoint* LastLocation();
@@ -73,15 +65,14 @@ class ATendril
 
 class Tendril
 {
-	std::list<ATendril*> _tendrils;
+	std::vector<ATendril> _tendrils;
 	int _width;
 	int _height;
 
 	public:
 
-	~Tendril();
-	Tendril(float friction, int trails, int size, float dampening, float tension, float springbase, float springincr, const wxPoint& start, size_t maxx, size_t maxy);
-	void UpdateRandomMove(int tunemovement);
+	Tendril(RenderBuffer& buffer, float friction, int trails, int size, float dampening, float tension, float springbase, float springincr, const wxPoint& start, size_t maxx, size_t maxy);
+	void UpdateRandomMove(RenderBuffer& buffer, int tunemovement);
     void Update(wxPoint* target);
     void Update(int x, int y);
     void Draw(PathDrawingContext* gc, xlColor colour, int thickness);
@@ -12,6 +12,7 @@
 
 #include <mutex>
 #include <array>
+#include <cmath>
 #include <unordered_map>
 
 #include "TextPanel.h"
@@ -717,10 +718,132 @@ public:
         textExtentCache[key] = sz;
     }
     
+    // width of the line and the partial extents of each character within it
+    struct LineLayout {
+        int width = 0;
+        wxArrayDouble extents;
+    };
+    const LineLayout &GetLineLayout(TextDrawingContext *dc, const std::string &font, const wxString &line, bool &fontSet) {
+        std::pair<std::string, wxString> key(font, line);
+        auto i = lineLayoutCache.find(key);
+        if (i == lineLayoutCache.end()) {
+            if (!fontSet) {
+                dc->Clear();
+                SetFont(dc, font, xlWHITE);
+                fontSet = true;
+            }
+            // lines are keyed by their text so countdowns and changing text would grow
+            // this without bound, it is cheap to rebuild
+            if (lineLayoutCache.size() >= MAX_LINE_LAYOUTS) {
+                lineLayoutCache.clear();
+            }
+            LineLayout &layout = lineLayoutCache[key];
+            double w, h;
+            dc->GetTextExtent(line, &w, &h);
+            layout.width = w;
+            dc->GetTextExtents(line, layout.extents);
+            return layout;
+        }
+        return i->second;
+    }
+
     std::unordered_map<CachedTextInfo, wxImage*, CachedTextInfoHasher> textCache;
     std::map<std::pair<std::string, wxString>, wxSize> textExtentCache;
+    std::map<std::pair<std::string, wxString>, LineLayout> lineLayoutCache;
+    static const size_t MAX_LINE_LAYOUTS = 256;
+    wxImage composedImage;
+};
+
+// Glyphs are drawn through wx once per font and character and kept as coverage masks
+// in an atlas shared by all buffers, text is then composed by copying the glyphs into
+// place so moving and countdown text does not need to be drawn through wx every frame.
+// Only used for multi colour text which DrawLabel also draws a character at a time,
+// single colour lines are drawn whole so wx can kern them.
+class GlyphAtlas {
+public:
+    struct Glyph {
+        int width = 0;
+        int height = 0;
+        int pad = 0; // room around the glyph for parts that overhang its extent
+        std::vector<uint8_t> coverage; // empty if it has not been drawn yet
+    };
+
+    // returns nullptr if the glyph does not fit in a drawing context of the given size
+    const Glyph *GetGlyph(TextDrawingContext *dc, int dcWidth, int dcHeight,
+                          const std::string &font, wxUniChar ch, bool &fontSet) {
+        std::unique_lock<std::mutex> locker(lock);
+        Glyph &glyph = glyphs[std::make_pair(font, (wxUniChar::value_type)ch)];
+        if (!glyph.coverage.empty()) {
+            return &glyph;
+        }
+        if (glyph.width == 0) {
+            if (!fontSet) {
+                dc->Clear();
+                SetFont(dc, font, xlWHITE);
+                fontSet = true;
+            }
+            double w, h;
+            dc->GetTextExtent(wxString(ch), &w, &h);
+            // italic and script fonts can overhang by a good part of their height
+            glyph.pad = std::max(2, (int)std::ceil(h / 2));
+            glyph.width = std::ceil(w) + glyph.pad * 2;
+            glyph.height = std::ceil(h) + glyph.pad * 2;
+        }
+        if (glyph.width > dcWidth || glyph.height > dcHeight) {
+            return nullptr;
+        }
+
+        dc->Clear();
+        SetFont(dc, font, xlWHITE);
+        dc->DrawText(wxString(ch), glyph.pad, glyph.pad);
+        wxImage *image = dc->FlushAndGetImage();
+        // the context needs clearing again before anything else is measured or drawn
+        fontSet = false;
+
+        const unsigned char *data = image->GetData();
+        const unsigned char *alpha = image->HasAlpha() ? image->GetAlpha() : nullptr;
+        glyph.coverage.resize(glyph.width * glyph.height);
+        for (int y = 0; y < glyph.height; y++) {
+            for (int x = 0; x < glyph.width; x++) {
+                int idx = y * image->GetWidth() + x;
+                uint8_t c;
+                if (alpha != nullptr) {
+                    c = alpha[idx];
+                } else {
+                    c = std::max(data[idx * 3], std::max(data[idx * 3 + 1], data[idx * 3 + 2]));
+                }
+                glyph.coverage[y * glyph.width + x] = c;
+            }
+        }
+        return &glyph;
+    }
+
+    // the character sheet of an xLights bitmap font with the lit pixels set
+    const Glyph *GetFontSheet(xlFont *font) {
+        std::unique_lock<std::mutex> locker(lock);
+        Glyph &sheet = fontSheets[font];
+        if (sheet.coverage.empty()) {
+            wxImage image = font->get_bitmap()->ConvertToImage();
+            sheet.width = image.GetWidth();
+            sheet.height = image.GetHeight();
+            sheet.coverage.resize(sheet.width * sheet.height);
+            const unsigned char *data = image.GetData();
+            for (int x = 0; x < sheet.width * sheet.height; x++) {
+                bool lit = data[x * 3] == 255 && data[x * 3 + 1] == 255 && data[x * 3 + 2] == 255;
+                sheet.coverage[x] = lit ? 255 : 0;
+            }
+        }
+        return &sheet;
+    }
+
+private:
+    std::mutex lock;
+    std::map<std::pair<std::string, wxUniChar::value_type>, Glyph> glyphs;
+    std::map<xlFont*, Glyph> fontSheets;
 };
 
+static GlyphAtlas GLYPH_ATLAS;
+
 wxSize GetMultiLineTextExtent(TextDrawingContext *dc,
                               const wxString& text,
                               TextRenderCache *cache,
@@ -850,6 +973,92 @@ void DrawLabel(TextDrawingContext *dc,
 }
 
 
+// Lays multi colour text out the same way DrawLabel does (centered in rect, a character
+// at a time at the truncated partial extent) but builds it from the glyph atlas.
+// Text is drawn without antialiasing so the coverage is all or nothing and the result
+// matches what DrawLabel draws. Returns nullptr if a glyph cannot be drawn so the
+// caller can fall back to DrawLabel.
+static wxImage *ComposeLabel(TextDrawingContext *dc,
+                             int width, int height,
+                             const wxString& text,
+                             const wxRect& rect,
+                             TextRenderCache *cache,
+                             const std::string &fontString,
+                             const std::vector<xlColor> &colors,
+                             bool &fontSet)
+{
+    struct PlacedGlyph {
+        const GlyphAtlas::Glyph *glyph;
+        int x;
+        int y;
+        xlColor color;
+    };
+    std::vector<PlacedGlyph> placed;
+
+    wxArrayString lines = wxSplit(text, '\n', 0);
+
+    // DrawLabel advances every line by the height of the last non empty line
+    wxCoord heightLine = 0;
+    for (const auto &line : lines) {
+        if (!line.empty()) {
+            heightLine = GetMultiLineTextExtent(dc, line, cache, fontString, fontSet).y;
+        }
+    }
+    wxSize textSize = GetMultiLineTextExtent(dc, text, cache, fontString, fontSet);
+    wxCoord x = (rect.GetLeft() + rect.GetRight() + 1 - textSize.x) / 2;
+    wxCoord y = (rect.GetTop() + rect.GetBottom() + 1 - textSize.y) / 2;
+
+    int curPos = 0;
+    for (const auto &line : lines) {
+        if (!line.empty()) {
+            const TextRenderCache::LineLayout &layout = cache->GetLineLayout(dc, fontString, line, fontSet);
+            int xRealStart = x + (textSize.x - layout.width) / 2;
+            for (int x1 = 0; x1 < line.size(); x1++) {
+                if (line[x1] == ' ') {
+                    continue;
+                }
+                const GlyphAtlas::Glyph *glyph = GLYPH_ATLAS.GetGlyph(dc, width, height, fontString, line[x1], fontSet);
+                if (glyph == nullptr) {
+                    return nullptr;
+                }
+                double loc = xRealStart;
+                if (x1 != 0 && x1 - 1 < layout.extents.size()) {
+                    loc += layout.extents[x1 - 1];
+                }
+                const xlColor &color = colors[curPos % colors.size()];
+                curPos++;
+                placed.push_back({ glyph, (int)loc - glyph->pad, y - glyph->pad, color });
+            }
+        }
+        y += heightLine;
+    }
+
+    wxImage &image = cache->composedImage;
+    if (!image.IsOk() || image.GetWidth() != width || image.GetHeight() != height) {
+        image.Create(width, height, true);
+        image.SetAlpha();
+    }
+    unsigned char *data = image.GetData();
+    unsigned char *alpha = image.GetAlpha();
+    memset(data, 0, width * height * 3);
+    memset(alpha, 0, width * height);
+    for (const auto &p : placed) {
+        for (int gy = std::max(0, -p.y); gy < p.glyph->height && p.y + gy < height; gy++) {
+            const uint8_t *coverage = &p.glyph->coverage[gy * p.glyph->width];
+            for (int gx = std::max(0, -p.x); gx < p.glyph->width && p.x + gx < width; gx++) {
+                if (coverage[gx] != 0) {
+                    int idx = (p.y + gy) * width + p.x + gx;
+                    data[idx * 3] = p.color.red;
+                    data[idx * 3 + 1] = p.color.green;
+                    data[idx * 3 + 2] = p.color.blue;
+                    alpha[idx] = std::max(alpha[idx], coverage[gx]);
+                }
+            }
+        }
+    }
+    return &image;
+}
+
 
 
 
@@ -1083,6 +1292,13 @@ wxImage *TextEffect::RenderTextLine(RenderBuffer &buffer,
         if (colors.size() == 0) {
             colors.push_back(xlWHITE);
         }
+        if (colors.size() != 1) {
+            wxImage *composed = ComposeLabel(dc, buffer.BufferWi, buffer.BufferHt, msg, rect, cache, fontString, colors, fontSet);
+            if (composed != nullptr) {
+                return composed;
+            }
+        }
+
         CachedTextInfo inf(msg.ToStdString(), fontString, colors, rect);
         wxImage *img = GetCache(buffer,id)->GetImage(inf);
         if (img == nullptr) {
@@ -1389,8 +1605,7 @@ void TextEffect::RenderXLText(Effect *effect, const SettingsMap &settings, Rende
     font_mgr.init();  // make sure font class is initialized
     wxString xl_font = settings["CHOICE_Text_Font"];
     xlFont* font = font_mgr.get_font(xl_font);
-    wxBitmap* bmp = font->get_bitmap();
-    wxImage image = bmp->ConvertToImage();
+    const GlyphAtlas::Glyph *sheet = GLYPH_ATLAS.GetFontSheet(font);
     int char_width = font->GetWidth();
     int char_height = font->GetHeight();
 
@@ -1542,12 +1757,9 @@ void TextEffect::RenderXLText(Effect *effect, const SettingsMap &settings, Rende
                 int x_pos = x_start_corner + w;
                 for (int y_pos = y_start_corner; y_pos < y_start_corner + char_height; y_pos++)
                 {
-                    if (x_pos >= 0 && x_pos < image.GetWidth() && y_pos >= 0 && y_pos < image.GetHeight())
+                    if (x_pos >= 0 && x_pos < sheet->width && y_pos >= 0 && y_pos < sheet->height)
                     {
-                        int red = image.GetRed(x_pos, y_pos);
-                        int green = image.GetGreen(x_pos, y_pos);
-                        int blue = image.GetBlue(x_pos, y_pos);
-                        if (red == 255 && green == 255 && blue == 255) {
+                        if (sheet->coverage[y_pos * sheet->width + x_pos] != 0) {
                             if (rotate_90) {
                                 if (up) {
                                     buffer.SetPixel(y_pos - y_start_corner + OffsetLeft, (buffer.BufferHt - 1) - (actual_width - 1 - x_pos + x_start_corner + OffsetTop), c, false);
@@ -44,6 +44,7 @@ public:
     int x,y;
     int duration; // How frames strobe light stays on. Will be decremented each frame
     int colorindex;
+    bool draw;    // decided before a re-randomise this frame so the strobe is still drawn in the frame it is reset
 };
 
 class TwinkleRenderCache : public EffectRenderCache {
@@ -212,29 +213,34 @@ void TwinkleEffect::Render(Effect *effect, SettingsMap &SettingsMap, RenderBuffe
                 if (i%step==1 || step==1) {
                     int s = strobe.size();
                     strobe.resize(s + 1);
-                    strobe[s].duration = rand() % max_modulo;
+                    strobe[s].duration = buffer.Rand() % max_modulo;
                     
                     strobe[s].x = x;
                     strobe[s].y = y;
                     
-                    strobe[s].colorindex = rand() % colorcnt;
+                    strobe[s].colorindex = buffer.Rand() % colorcnt;
                 }
             }
         }
     }
     
-    parallel_for(0, strobe.size(), [&strobe, &buffer, max_modulo, max_modulo2, colorcnt, reRandomize, Strobe](int x) {
-        strobe[x].duration++;
-        if (strobe[x].duration < 0) {
-            return;
-        }
-        if (strobe[x].duration == max_modulo) {
-            strobe[x].duration = 0;
+    // advance the twinkles serially so the random draws always happen in the same order
+    for (auto& s : strobe) {
+        s.duration++;
+        s.draw = s.duration >= 0;
+        if (s.duration == max_modulo) {
+            s.duration = 0;
             if (reRandomize) {
-                strobe[x].duration -= rand() % max_modulo2;
-                strobe[x].colorindex = rand() % colorcnt;
+                s.duration -= buffer.Rand() % max_modulo2;
+                s.colorindex = buffer.Rand() % colorcnt;
             }
         }
+    }
+
+    parallel_for(0, strobe.size(), [&strobe, &buffer, max_modulo, max_modulo2, Strobe](int x) {
+        if (!strobe[x].draw) {
+            return;
+        }
         int i7 = strobe[x].duration;
         HSVValue hsv;
         buffer.palette.GetHSV(strobe[x].colorindex, hsv);
@@ -149,6 +149,10 @@ void CustomModel::AddTypeProperties(wxPropertyGridInterface *grid) {
                                              "CustomBkgImage",
                                              custom_background));
     p->SetAttribute(wxPG_FILE_WILDCARD, "Image files|*.png;*.bmp;*.jpg;*.gif;*.jpeg|All files (*.*)|*.*");
+
+    p = grid->Append(new wxBoolProperty("Compress Model Data", "CustomModelCompressed", IsCustomDataCompressed()));
+    p->SetAttribute("UseCheckbox", true);
+    p->SetHelpString("Store only the populated cells. This makes very large sparse models much smaller and faster to load but older versions of xLights cannot read it.");
 }
 
 int CustomModel::OnPropertyGridChange(wxPropertyGridInterface *grid, wxPropertyGridEvent& event) {
@@ -174,6 +178,12 @@ int CustomModel::OnPropertyGridChange(wxPropertyGridInterface *grid, wxPropertyG
         AddASAPWork(OutputModelManager::WORK_RELOAD_MODEL_FROM_XML, "CustomModel::OnPropertyGridChange::CustomBkgImage");
         return 0;
     }
+    else if ("CustomModelCompressed" == event.GetPropertyName()) {
+        WriteCustomData(GetCustomData(), event.GetValue().GetBool());
+        AddASAPWork(OutputModelManager::WORK_RGBEFFECTS_CHANGE, "CustomModel::OnPropertyGridChange::CustomModelCompressed");
+        AddASAPWork(OutputModelManager::WORK_RELOAD_MODEL_FROM_XML, "CustomModel::OnPropertyGridChange::CustomModelCompressed");
+        return 0;
+    }
     else if ("CustomModelStrings" == event.GetPropertyName())
     {
         _strings = event.GetValue().GetInteger();
@@ -231,66 +241,236 @@ int CustomModel::OnPropertyGridChange(wxPropertyGridInterface *grid, wxPropertyG
     return Model::OnPropertyGridChange(grid, event);
 }
 
-std::tuple<int,int,int> FindNode(int node, const std::vector<std::vector<std::vector<int>>>& locations)
+#pragma region CustomModelData
+void CustomModelData::Clear()
 {
-    for (int l = 0; l < locations.size(); l++)
-    {
-        for (int r = 0; r < locations[l].size(); r++)
-        {
-            for (int c = 0; c < locations[l][r].size(); c++)
-            {
-                if (locations[l][r][c] == node+1)
-                {
-                    return { l, r, c };
+    width = 0;
+    height = 0;
+    depth = 0;
+    maxNode = 0;
+    cells.clear();
+    rowWidths.clear();
+    layerHeights.clear();
+}
+
+void CustomModelData::ParseDense(const std::string& data)
+{
+    Clear();
+
+    // an empty string is still a single empty cell
+    width = 1;
+    height = 1;
+    depth = 1;
+
+    int layer = 0;
+    int row = 0;
+    int col = 0;
+    int value = 0;
+    bool negative = false;
+    bool started = false;
+    bool stopped = false;
+    bool digits = false;
+
+    const char* p = data.c_str();
+    const char* end = p + data.size();
+    while (true) {
+        char c = (p == end) ? '\0' : *p;
+        if (c == ',' || c == ';' || c == '|' || c == '\0') {
+            if (digits && !negative && value > 0) {
+                cells.push_back({ layer, row, col, value });
+                if (value > maxNode) maxNode = value;
+            }
+            value = 0;
+            negative = false;
+            started = false;
+            stopped = false;
+            digits = false;
+
+            if (c == ',') {
+                col++;
+            }
+            else {
+                width = std::max(width, col + 1);
+                rowWidths.push_back(width);
+                col = 0;
+                if (c == ';') {
+                    row++;
+                }
+                else {
+                    height = std::max(height, row + 1);
+                    layerHeights.push_back(row + 1);
+                    row = 0;
+                    if (c == '\0') break;
+                    layer++;
                 }
             }
         }
+        else if (!stopped) {
+            // same rules as stoi ... skip leading spaces, optional sign then digits, ignore anything after
+            if (!started && c == ' ') {
+            }
+            else if (!started && (c == '-' || c == '+')) {
+                negative = (c == '-');
+                started = true;
+            }
+            else if (c >= '0' && c <= '9') {
+                if (value < 100000000) value = value * 10 + (c - '0');
+                digits = true;
+                started = true;
+            }
+            else {
+                stopped = true;
+            }
+        }
+        ++p;
     }
-    wxASSERT(false);
-    return { -1,-1,-1 };
+    depth = layer + 1;
 }
 
-std::vector<std::vector<std::vector<int>>> ParseCustomModel(const wxString& data, int width, int height, int depth)
+void CustomModelData::ParseCompressed(const std::string& data, int w, int h, int d)
 {
-    std::vector<std::vector<std::vector<int>>> res;
-
-    wxASSERT(width > 0);
-    wxASSERT(height > 0);
-    wxASSERT(depth > 0);
-
-    if (data == "")         {
-        for (int l = 0; l < depth; l++)             {
-            std::vector<std::vector<int>> ll;
-            for (int r = 0; r < height; r++)                 {
-                std::vector<int> rr;
-                for (int c = 0; c < width; c++)                     {
-                    rr.push_back(-1);
+    Clear();
+    width = std::max(w, 1);
+    height = std::max(h, 1);
+    depth = std::max(d, 1);
+
+    // each entry is row,col,node[,run] ... a run of n cells along the row holds consecutive node numbers,
+    // counting down if the run is negative
+    int layer = 0;
+    int field = 0;
+    int values[4] = { 0, 0, 0, 1 };
+    bool negative = false;
+    const char* p = data.c_str();
+    const char* end = p + data.size();
+    while (true) {
+        char c = (p == end) ? '\0' : *p;
+        if (c == ',') {
+            if (negative) values[field] = -values[field];
+            negative = false;
+            if (field < 3) values[++field] = 0;
+        }
+        else if (c == ';' || c == '|' || c == '\0') {
+            if (negative) values[field] = -values[field];
+            negative = false;
+            if (field >= 2 && values[2] > 0 && values[3] != 0) {
+                int run = std::abs(values[3]);
+                int step = values[3] > 0 ? 1 : -1;
+                for (int i = 0; i < run; i++) {
+                    int col = values[1] + i;
+                    int node = values[2] + i * step;
+                    if (values[0] < 0 || col < 0 || node <= 0) break;
+                    // the stored size can be smaller than the data (eg parm1 narrower than the widest row) so grow to fit
+                    // rather than drop nodes
+                    width = std::max(width, col + 1);
+                    height = std::max(height, values[0] + 1);
+                    depth = std::max(depth, layer + 1);
+                    cells.push_back({ layer, values[0], col, node });
+                    if (node > maxNode) maxNode = node;
                 }
-                ll.push_back(rr);
             }
-            res.push_back(ll);
+            field = 0;
+            values[0] = values[1] = values[2] = 0;
+            values[3] = 1;
+            if (c == '|') layer++;
+            if (c == '\0') break;
+        }
+        else if (c == '-') {
+            negative = true;
         }
+        else if (c >= '0' && c <= '9') {
+            if (values[field] < 100000000) values[field] = values[field] * 10 + (c - '0');
+        }
+        ++p;
     }
-    else {
-        wxArrayString layers = wxSplit(data, '|');
-        for (auto l : layers) {
-            std::vector<std::vector<int>> ll;
-            wxArrayString rows = wxSplit(l, ';');
-            for (auto r : rows) {
-                std::vector<int> rr;
-                wxArrayString columns = wxSplit(r, ',');
-                for (auto c : columns) {
-                    if (c == "") rr.push_back(-1);
-                    else rr.push_back(wxAtoi(c));
-                }
-                while (rr.size() < width) rr.push_back(-1);
-                ll.push_back(rr);
+
+    std::stable_sort(cells.begin(), cells.end(), [](const Cell& a, const Cell& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.row != b.row) return a.row < b.row;
+        return a.col < b.col;
+        });
+}
+
+std::vector<int> CustomModelData::ToDenseArray() const
+{
+    std::vector<int> res(width * height * depth, -1);
+    for (const auto& it : cells) {
+        res[(it.layer * height + it.row) * width + it.col] = it.node;
+    }
+    return res;
+}
+
+std::vector<int> CustomModelData::FirstCellForNode() const
+{
+    std::vector<int> res(maxNode + 1, -1);
+    for (size_t i = 0; i < cells.size(); i++) {
+        if (res[cells[i].node] == -1) {
+            res[cells[i].node] = i;
+        }
+    }
+    return res;
+}
+
+std::string CustomModelData::ToDense() const
+{
+    auto dense = ToDenseArray();
+    std::string res;
+    res.reserve(dense.size() * 2 + cells.size() * 4);
+    for (int l = 0; l < depth; l++) {
+        if (l != 0) res += "|";
+        for (int r = 0; r < height; r++) {
+            if (r != 0) res += ";";
+            for (int c = 0; c < width; c++) {
+                if (c != 0) res += ",";
+                int v = dense[(l * height + r) * width + c];
+                if (v > 0) res += std::to_string(v);
+            }
+        }
+    }
+    return res;
+}
+
+std::string CustomModelData::ToCompressed() const
+{
+    std::string res;
+    res.reserve(cells.size() * 4 + depth);
+    int layer = 0;
+    bool first = true;
+    size_t i = 0;
+    while (i < cells.size()) {
+        const auto& it = cells[i];
+        while (layer < it.layer) {
+            res += "|";
+            layer++;
+            first = true;
+        }
+
+        // collapse adjacent cells on the row with consecutive node numbers into a single run
+        int step = 0;
+        size_t j = i + 1;
+        if (j < cells.size() && cells[j].layer == it.layer && cells[j].row == it.row && cells[j].col == it.col + 1 &&
+            std::abs(cells[j].node - it.node) == 1) {
+            step = cells[j].node - it.node;
+            while (j < cells.size() && cells[j].layer == it.layer && cells[j].row == it.row &&
+                cells[j].col == it.col + (int)(j - i) && cells[j].node == it.node + step * (int)(j - i)) {
+                j++;
             }
-            res.push_back(ll);
         }
+
+        if (!first) res += ";";
+        res += std::to_string(it.row) + "," + std::to_string(it.col) + "," + std::to_string(it.node);
+        if (j - i > 1) {
+            res += "," + std::to_string(step * (int)(j - i));
+        }
+        first = false;
+        i = j;
+    }
+    while (layer < depth - 1) {
+        res += "|";
+        layer++;
     }
     return res;
 }
+#pragma endregion
 
 int CustomModel::GetStrandLength(int strand) const {
     return Nodes.size();
@@ -308,14 +488,13 @@ void CustomModel::UpdateModel(int width, int height, int depth, const std::strin
     ModelXml->AddAttribute("parm2", wxString::Format("%d", height));
     ModelXml->DeleteAttribute("Depth");
     ModelXml->AddAttribute("Depth", wxString::Format("%d", depth));
-    ModelXml->DeleteAttribute("CustomModel");
-    ModelXml->AddAttribute("CustomModel", modelData);
+    WriteCustomData(modelData, IsCustomDataCompressed());
     SetFromXml(ModelXml, zeroBased);
 }
 
 void CustomModel::InitModel() {
-    std::string customModel = ModelXml->GetAttribute("CustomModel").ToStdString();
-    InitCustomMatrix(customModel);
+    ParseCustomData();
+    InitCustomMatrix();
     //CopyBufCoord2ScreenCoord();
     custom_background = ModelXml->GetAttribute("CustomBkgImage").ToStdString();
     _strings = wxAtoi(ModelXml->GetAttribute("CustomStrings", "1"));
@@ -345,15 +524,59 @@ void CustomModel::SetCustomDepth(long d)
 }
 
 std::string CustomModel::GetCustomData() const {
+    if (IsCustomDataCompressed()) {
+        // callers and exported xmodel files always see the original dense layout
+        CustomModelData data;
+        data.ParseCompressed(ModelXml->GetAttribute("CustomModelCompressed").ToStdString(), parm1, parm2, wxAtoi(ModelXml->GetAttribute("Depth", "1")));
+        return data.ToDense();
+    }
     return ModelXml->GetAttribute("CustomModel").ToStdString();
 }
 
 void CustomModel::SetCustomData(const std::string &data) {
-    ModelXml->DeleteAttribute("CustomModel");
-    ModelXml->AddAttribute("CustomModel", data);
+    WriteCustomData(data, IsCustomDataCompressed());
     SetFromXml(ModelXml, zeroBased);
 }
 
+bool CustomModel::IsCustomDataCompressed() const
+{
+    // if something has written a dense CustomModel attribute directly (eg xmodel import) then that wins
+    return ModelXml->HasAttribute("CustomModelCompressed") && !ModelXml->HasAttribute("CustomModel");
+}
+
+void CustomModel::WriteCustomData(const std::string& data, bool compressed)
+{
+    ModelXml->DeleteAttribute("CustomModel");
+    ModelXml->DeleteAttribute("CustomModelCompressed");
+    if (compressed) {
+        CustomModelData cmd;
+        cmd.ParseDense(data);
+        ModelXml->AddAttribute("CustomModelCompressed", cmd.ToCompressed());
+    }
+    else {
+        ModelXml->AddAttribute("CustomModel", data);
+    }
+}
+
+void CustomModel::ParseCustomData()
+{
+    // this is called from SetStringStartChannels and InitModel on every SetFromXml so only reparse if the data has changed
+    std::string source;
+    if (IsCustomDataCompressed()) {
+        source = wxString::Format("%ld,%ld,%s:", parm1, parm2, ModelXml->GetAttribute("Depth", "1")).ToStdString() + ModelXml->GetAttribute("CustomModelCompressed").ToStdString();
+        if (source != _customDataSource) {
+            _customData.ParseCompressed(ModelXml->GetAttribute("CustomModelCompressed").ToStdString(), parm1, parm2, wxAtoi(ModelXml->GetAttribute("Depth", "1")));
+        }
+    }
+    else {
+        source = ModelXml->GetAttribute("CustomModel").ToStdString();
+        if (source != _customDataSource) {
+            _customData.ParseDense(source);
+        }
+    }
+    _customDataSource = source;
+}
+
 void CustomModel::SetCustomBackground(std::string background)
 {
     custom_background = background;
@@ -404,9 +627,9 @@ std::list<std::string> CustomModel::GetFileReferences()
 }
 
 void CustomModel::SetStringStartChannels(bool zeroBased, int NumberOfStrings, int StartChannel, int ChannelsPerString) {
-    std::string customModel = ModelXml->GetAttribute("CustomModel").ToStdString();
+    ParseCustomData();
     _strings = wxAtoi(ModelXml->GetAttribute("CustomStrings", "1").ToStdString());
-    int maxval=GetCustomMaxChannel(customModel);
+    int maxval = _customData.maxNode;
     // fix NumberOfStrings
     if (SingleNode) {
         NumberOfStrings=maxval;
@@ -441,21 +664,6 @@ int CustomModel::NodesPerString() const
     return GetChanCount() / std::max(GetChanCountPerNode(),1);
 }
 
-inline void split(std::string frag, char splitBy, std::vector<std::string>& tokens)
-{
-    // Loop infinitely - break is internal.
-    while(true) {
-        size_t splitAt = frag.find(splitBy);
-        // If we didn't find a new split point...
-        if (splitAt == std::string::npos) {
-            tokens.push_back(frag);
-            break;
-        }
-        tokens.push_back(frag.substr(0, splitAt));
-        frag.erase(0, splitAt + 1);
-    }
-}
-
 static std::vector<std::string> CUSTOM_BUFFERSTYLES =
 {
     "Default",
@@ -587,13 +795,22 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
 
     GetBufferSize(type, camera, transform, BufferWi, BufferHi);
 
-    auto locations = ParseCustomModel(ModelXml->GetAttribute("CustomModel"), width, height, depth);
+    // node n is the n+1 node number ... find the first cell each node appears in once rather than searching the grid per node
+    auto firstCell = _customData.FirstCellForNode();
+    auto FindNode = [this, &firstCell](int node) -> std::tuple<int, int, int> {
+        if (node + 1 < firstCell.size() && firstCell[node + 1] != -1) {
+            const auto& c = _customData.cells[firstCell[node + 1]];
+            return { c.layer, c.row, c.col };
+        }
+        wxASSERT(false);
+        return { -1,-1,-1 };
+    };
 
     if (type == "Stacked X Horizontally")
     {
         for (auto n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = depth - std::get<0>(loc) - 1 + std::get<2>(loc) * depth;
             Nodes[n]->Coords[0].bufY = height - std::get<1>(loc) - 1;
         }
@@ -602,7 +819,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc) + std::get<1>(loc) * width;
             Nodes[n]->Coords[0].bufY = std::get<0>(loc);
         }
@@ -615,7 +832,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = depth - std::get<0>(loc) - 1;
             Nodes[n]->Coords[0].bufY = std::get<1>(loc) + height * std::get<2>(loc);
         }
@@ -624,7 +841,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc);
             Nodes[n]->Coords[0].bufY = std::get<0>(loc) + depth * std::get<1>(loc);
         }
@@ -633,7 +850,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc);
             Nodes[n]->Coords[0].bufY = std::get<1>(loc) + depth * std::get<0>(loc);
         }
@@ -642,7 +859,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = depth - std::get<0>(loc) - 1;
             Nodes[n]->Coords[0].bufY = height - std::get<1>(loc) - 1;
         }
@@ -651,7 +868,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc);
             Nodes[n]->Coords[0].bufY = std::get<0>(loc);
         }
@@ -660,7 +877,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc);
             Nodes[n]->Coords[0].bufY = height - std::get<1>(loc) - 1;
         }
@@ -669,7 +886,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = depth - std::get<0>(loc) - 1 + std::get<2>(loc) * depth;
             Nodes[n]->Coords[0].bufY = std::get<1>(loc) + std::get<2>(loc) * height;
         }
@@ -678,7 +895,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc) + std::get<1>(loc) * width;
             Nodes[n]->Coords[0].bufY = std::get<0>(loc) + std::get<1>(loc) * depth;
         }
@@ -687,7 +904,7 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     {
         for (size_t n = 0; n < Nodes.size(); n++)
         {
-            auto loc = FindNode(n, locations);
+            auto loc = FindNode(n);
             Nodes[n]->Coords[0].bufX = std::get<2>(loc) + std::get<0>(loc) * width;
             Nodes[n]->Coords[0].bufY = std::get<1>(loc) + (height - std::get<1>(loc) - 1) * height;
         }
@@ -698,33 +915,8 @@ void CustomModel::InitRenderBufferNodes(const std::string& type, const std::stri
     }
 }
 
-int CustomModel::GetCustomMaxChannel(const std::string& customModel) const
-{
-    int maxval = 0;
-
-    std::string cm = customModel;
-    std::replace(cm.begin(), cm.end(), '|', ',');
-    std::replace(cm.begin(), cm.end(), ';', ',');
-    std::stringstream ss(cm);
-    std::string token;
-
-    while (std::getline(ss, token, ',')) {
-        if (token != "") {
-            try {
-                maxval = std::max(std::stoi(token), maxval);
-            }
-            catch (...) {
-                // not a number, treat as 0
-            }
-        }
-    }
-    return maxval;
-}
-
-void CustomModel::InitCustomMatrix(const std::string& customModel) {
-    float width = 1.0;
-    float height = 1.0;
-    std::vector<int> nodemap;
+void CustomModel::InitCustomMatrix() {
+    std::vector<int> nodemap(_customData.maxNode, -1);
 
     int32_t firstStartChan = 999999999;
     for (auto it: stringStartChan)
@@ -733,100 +925,68 @@ void CustomModel::InitCustomMatrix(const std::string& customModel) {
     }
 
     int cpn = -1;
-    std::vector<std::string> layers;
-    std::vector<std::string> rows;
-    std::vector<std::string> cols;
-    layers.reserve(20);
-    rows.reserve(100);
-    cols.reserve(100);
-
-    split(customModel, '|', layers);
-    float depth = layers.size();
-    int layer = 0;
-
-    for (auto lv : layers) {
-        rows.clear();
-        split(lv, ';', rows);
-        height = rows.size();
-
-        int row = 0;
-        for (auto rv : rows) {
-            cols.clear();
-            split(rv, ',', cols);
-            if (cols.size() > width) width = cols.size();
-            int col = 0;
-            for (auto value : cols) {
-                while (value.length() > 0 && value[0] == ' ') {
-                    value = value.substr(1);
-                }
-                long idx = -1;
-                if (value != "") {
-                    try {
-                        idx = std::stoi(value);
-                    }
-                    catch (...) {
-                        // not a number, treat as 0
-                    }
-                }
-                if (idx > 0) {
-                    // increase nodemap size if necessary
-                    if (idx > nodemap.size()) {
-                        nodemap.resize(idx, -1);
-                    }
-                    idx--;  // adjust to 0-based
-
-                    // is node already defined in map?
-                    if (nodemap[idx] < 0) {
-                        // unmapped - so add a node
-                        nodemap[idx] = Nodes.size();
-                        SetNodeCount(1, 0, rgbOrder);  // this creates a node of the correct class
-                        Nodes.back()->StringNum = idx;
-                        if (cpn == -1) {
-                            cpn = GetChanCountPerNode();
-                        }
-                        Nodes.back()->ActChan = firstStartChan + idx * cpn;
-                        if (idx < nodeNames.size() && nodeNames[idx] != "") {
-                            Nodes.back()->SetName(nodeNames[idx]);
-                        }
-                        else {
-                            Nodes.back()->SetName("Node " + std::to_string(idx + 1));
-                        }
-
-                        Nodes.back()->AddBufCoord(layer * width + col, height - row - 1);
-                        auto& c = Nodes[nodemap[idx]]->Coords.back();
-                        c.screenX = (float)col - width / 2.0f;
-                        c.screenY = height - (float)row - 1.0f - height / 2.0f;
-                        c.screenZ = depth - (float)layer - 1.0f - depth / 2.0f;
-                    }
-                    else {
-                        // mapped - so add a coord to existing node
-                        Nodes[nodemap[idx]]->AddBufCoord(layer * width + col, height - row - 1);
-                        auto& c = Nodes[nodemap[idx]]->Coords.back();
-                        c.screenX = (float)col - width / 2.0f;
-                        c.screenY = height - (float)row - 1.0f - height / 2.0f;
-                        c.screenZ = depth - (float)layer - 1.0f - depth / 2.0f;
-                    }
-                }
-                col++;
-            }
-            row++;
+    float width = _customData.width;
+    float height = _customData.height;
+    float depth = _customData.depth;
+
+    // jagged dense data is laid out as the row by row parse always did it ... each cell uses the widest row seen
+    // up to its own row and the number of rows in its own layer
+    const bool jagged = !_customData.rowWidths.empty();
+    std::vector<int> layerFirstRow;
+    if (jagged) {
+        int r = 0;
+        for (auto h : _customData.layerHeights) {
+            layerFirstRow.push_back(r);
+            r += h;
         }
-        layer++;
     }
 
-    for (int x = 0; x < Nodes.size(); x++) {
-        for (int y = x+1; y < Nodes.size(); y++) {
-            if (Nodes[y]->StringNum < Nodes[x]->StringNum) {
-                Nodes[x].swap(Nodes[y]);
+    for (const auto& cell : _customData.cells) {
+        int idx = cell.node - 1;  // adjust to 0-based
+        if (jagged) {
+            width = _customData.rowWidths[layerFirstRow[cell.layer] + cell.row];
+            height = _customData.layerHeights[cell.layer];
+        }
+
+        // is node already defined in map?
+        if (nodemap[idx] < 0) {
+            // unmapped - so add a node
+            nodemap[idx] = Nodes.size();
+            SetNodeCount(1, 0, rgbOrder);  // this creates a node of the correct class
+            Nodes.back()->StringNum = idx;
+            if (cpn == -1) {
+                cpn = GetChanCountPerNode();
+            }
+            Nodes.back()->ActChan = firstStartChan + idx * cpn;
+            if (idx < nodeNames.size() && nodeNames[idx] != "") {
+                Nodes.back()->SetName(nodeNames[idx]);
+            }
+            else {
+                Nodes.back()->SetName("Node " + std::to_string(idx + 1));
             }
         }
+
+        // add a coord to the node
+        Nodes[nodemap[idx]]->AddBufCoord(cell.layer * width + cell.col, height - cell.row - 1);
+        auto& c = Nodes[nodemap[idx]]->Coords.back();
+        c.screenX = (float)cell.col - width / 2.0f;
+        c.screenY = height - (float)cell.row - 1.0f - height / 2.0f;
+        c.screenZ = depth - (float)cell.layer - 1.0f - depth / 2.0f;
     }
+
+    // node numbers are unique so this gives the same order as the old pairwise swap without being O(n^2)
+    std::sort(Nodes.begin(), Nodes.end(), [](const NodeBaseClassPtr& a, const NodeBaseClassPtr& b) { return a->StringNum < b->StringNum; });
     for (int x = 0; x < Nodes.size(); x++) {
         if (Nodes[x]->GetName() == "") {
             Nodes[x]->SetName(GetNodeName(Nodes[x]->StringNum));
         }
     }
 
+    if (jagged) {
+        // the buffer is the widest row by the height of the last layer
+        width = _customData.width;
+        height = _customData.layerHeights.back();
+    }
     SetBufferSize(height,width*depth);
     if (screenLocation.RenderDp < 10.0f) {
         screenLocation.RenderDp = 10.0f;  // give the bounding box a little depth
@@ -1038,30 +1198,19 @@ std::string CustomModel::ChannelLayoutHtml(OutputManager* outputManager) {
         html += "<tr><td>No custom data</td></tr>";
     }
     else {
-        std::vector<std::vector<std::vector<wxString>>> _data;
-        int cols = parm1;
-        wxArrayString layers = wxSplit(data, '|');
-        for (auto l : layers) {
-            std::vector<std::vector<wxString>> ll;
-            wxArrayString rows = wxSplit(l, ';');
-            for (auto r : rows) {
-                std::vector<wxString> rr;
-                wxArrayString columns = wxSplit(r, ',');
-                for (auto c : columns) {
-                    rr.push_back(c);
-                }
-                while (rr.size() < cols) rr.push_back("");
-                ll.push_back(rr);
-            }
-            _data.push_back(ll);
-        }
-
+        auto cells = _customData.ToDenseArray();
+        int w = _customData.width;
+        int h = _customData.height;
+        int d = _customData.depth;
         for (int r = 0; r < parm2; r++) {
             html += "<tr>";
             for (int l = 0; l < _depth; l++) {
                 for (int c = 0; c < parm1; c++) {
-                    wxString value = _data[l][r][c];
-                    if (!value.IsEmpty() && value != "0") {
+                    wxString value;
+                    if (l < d && r < h && c < w && cells[(l * h + r) * w + c] > 0) {
+                        value = wxString::Format("%d", cells[(l * h + r) * w + c]);
+                    }
+                    if (!value.IsEmpty()) {
                         wxString bgcolor = "#ADD8E6"; //"#90EE90"
                         if (_strings == 1) {
                             html += wxString::Format("<td bgcolor='" + bgcolor + "'>n%s</td>", value);
@@ -1445,7 +1594,7 @@ void CustomModel::ExportXlightsModel()
     wxFile f(filename);
     //    bool isnew = !wxFile::Exists(filename);
     if (!f.Create(filename, true) || !f.IsOpened()) DisplayError(wxString::Format("Unable to create file %s. Error %d\n", filename, f.GetLastError()).ToStdString());
-    wxString cm = ModelXml->GetAttribute("CustomModel");
+    wxString cm = GetCustomData();
     wxString p1 = ModelXml->GetAttribute("parm1");
     wxString p2 = ModelXml->GetAttribute("parm2");
     wxString d = ModelXml->GetAttribute("Depth");
@@ -12,6 +12,44 @@
 
 #include "Model.h"
 
+// The CustomModel attribute parsed in a single pass. Only cells holding a node are kept, in layer, row, column
+// order, so very large mostly empty grids stay small. Two encodings are supported:
+//   dense      - the original "n,n,,n;n,,n|..." layout (layers split by |, rows by ; and columns by ,)
+//   compressed - only populated cells as "row,col,node[,run]" entries split by ; with layers split by |
+//                where run collapses a row of consecutive node numbers (negative when counting down)
+class CustomModelData
+{
+public:
+    struct Cell
+    {
+        int layer;
+        int row;
+        int col;
+        int node; // 1 based node number
+    };
+
+    int width = 0;
+    int height = 0;
+    int depth = 0;
+    int maxNode = 0;
+    std::vector<Cell> cells;
+    // dense rows can be different lengths ... the widest row so far at the end of each row (in layer then row order)
+    // and the number of rows in each layer. Both are empty for compressed data which is always rectangular
+    std::vector<int> rowWidths;
+    std::vector<int> layerHeights;
+
+    void Clear();
+    void ParseDense(const std::string& data);
+    void ParseCompressed(const std::string& data, int w, int h, int d);
+    std::string ToDense() const;
+    std::string ToCompressed() const;
+
+    // 1 based node number (or -1) for each cell indexed by (layer * height + row) * width + col
+    std::vector<int> ToDenseArray() const;
+    // index into cells of the first cell holding each node number, -1 if the node is not used
+    std::vector<int> FirstCellForNode() const;
+};
+
 class CustomModel : public ModelWithScreenLocation<BoxedScreenLocation>
 {
     public:
@@ -49,6 +87,8 @@ class CustomModel : public ModelWithScreenLocation<BoxedScreenLocation>
 
         std::string GetCustomData() const;
         void SetCustomData(const std::string &data);
+        const CustomModelData& GetCustomModelData() const { return _customData; }
+        bool IsCustomDataCompressed() const;
 
         std::string GetCustomBackground() const {return custom_background;}
         void SetCustomBackground(std::string background);
@@ -72,8 +112,9 @@ class CustomModel : public ModelWithScreenLocation<BoxedScreenLocation>
         virtual void SetStringStartChannels(bool zeroBased, int NumberOfStrings, int StartChannel, int ChannelsPerString) override;
 
     private:
-        int GetCustomMaxChannel(const std::string& customModel) const;
-        void InitCustomMatrix(const std::string& customModel);
+        void ParseCustomData();
+        void WriteCustomData(const std::string& data, bool compressed);
+        void InitCustomMatrix();
         static std::string StartNodeAttrName(int idx)
         {
             return wxString::Format(wxT("String%i"), idx + 1).ToStdString();  // a space between "String" and "%i" breaks the start channels listed in Indiv Start Chans
@@ -85,4 +126,6 @@ class CustomModel : public ModelWithScreenLocation<BoxedScreenLocation>
         std::string custom_background;
         int _strings;
         std::vector<int> stringStartNodes;
+        CustomModelData _customData;
+        std::string _customDataSource;
 };
@@ -112,6 +112,11 @@ Model::Model(const ModelManager &manager) : modelDimmingCurve(nullptr),
     SingleChannel = false;
 }
 
+void Model::IncrementChangeCount() {
+    BaseObject::IncrementChangeCount();
+    modelManager.InvalidateChannelIndex();
+}
+
 Model::~Model() {
     if (modelDimmingCurve != nullptr) {
         delete modelDimmingCurve;
@@ -1816,6 +1821,7 @@ void Model::AddState(wxXmlNode* n)
 
 void Model::AddSubmodel(wxXmlNode* n)
 {
+    EnsureSubModels();
     ParseSubModel(n);
 
     // this may break if the submodel format changes and the user loads an old format ... if that happens this needs to go through a upgrade routine
@@ -2114,6 +2120,21 @@ bool Model::UpdateStartChannelFromChannelString(std::map<std::string, Model*>& m
     return valid;
 }
 
+// true if the model was built with the start channel its xml currently resolves to ... only plain start channels
+// that do not depend on another model or on individual string start channels are checked
+bool Model::IsStartChannelCurrent() const
+{
+    if (stringStartChan.empty() || ModelXml == nullptr) return false;
+    if (ModelXml->GetAttribute("Advanced", "0") == "1") return false;
+
+    bool valid = false;
+    std::string dependsonmodel;
+    int32_t StartChannel = GetNumberFromChannelString(ModelXml->GetAttribute("StartChannel", "1").ToStdString(), valid, dependsonmodel);
+    if (!valid || dependsonmodel != "") return false;
+
+    return stringStartChan[0] == (zeroBased ? 0 : StartChannel - 1);
+}
+
 int Model::GetNumberFromChannelString(const std::string &sc) const {
     bool v = false;
     std::string dependsonmodel;
@@ -2270,11 +2291,15 @@ void Model::SetFromXml(wxXmlNode* ModelNode, bool zb) {
         delete modelDimmingCurve;
         modelDimmingCurve = nullptr;
     }
-    for (auto it = subModels.begin(); it != subModels.end(); ++it) {
-        Model *m = *it;
-        delete m;
+    {
+        std::lock_guard<std::mutex> lock(_subModelsLock);
+        for (auto it = subModels.begin(); it != subModels.end(); ++it) {
+            Model *m = *it;
+            delete m;
+        }
+        subModels.clear();
+        _subModelsPending = false;
     }
-    subModels.clear();
     superStringColours.clear();
 
     wxString channelstr;
@@ -2422,7 +2447,7 @@ void Model::SetFromXml(wxXmlNode* ModelNode, bool zb) {
             dimmingCurveNode = f;
             modelDimmingCurve = DimmingCurve::createFromXML(f);
         } else if ("subModel" == f->GetName()) {
-            ParseSubModel(f);
+            _subModelsPending = true;
         } else if ("ControllerConnection" == f->GetName()) {
             controllerConnectionNode = f;
         }
@@ -2570,6 +2595,7 @@ wxXmlNode *Model::GetControllerConnection() const {
 }
 
 void Model::RemoveSubModel(const std::string &name) {
+    EnsureSubModels();
     for (auto a = subModels.begin(); a != subModels.end(); ++a) {
         Model *m = *a;
         if (m->GetName() == name) {
@@ -2580,6 +2606,7 @@ void Model::RemoveSubModel(const std::string &name) {
 }
 
 Model *Model::GetSubModel(const std::string &name) const {
+    EnsureSubModels();
     for (auto a = subModels.begin(); a != subModels.end(); ++a) {
         if ((*a)->GetName() == name) {
             return *a;
@@ -2600,8 +2627,25 @@ std::string Model::GenerateUniqueSubmodelName(const std::string suggested) const
     }
 }
 
-void Model::ParseSubModel(wxXmlNode *node) {
-    subModels.push_back(new SubModel(this, node));
+void Model::ParseSubModel(wxXmlNode *node) const {
+    subModels.push_back(new SubModel(const_cast<Model*>(this), node));
+}
+
+// Builds the submodels SetFromXml found but did not create. Loading a layout builds every model and then rebuilds many
+// of them once start channels are resolved so building the submodels each time was wasted work. They are read from the
+// live xml so any edits made since the model was built are picked up.
+void Model::EnsureSubModels() const {
+    if (!_subModelsPending) return;
+
+    std::lock_guard<std::mutex> lock(_subModelsLock);
+    if (!_subModelsPending) return;
+
+    for (wxXmlNode* f = ModelXml->GetChildren(); f != nullptr; f = f->GetNext()) {
+        if ("subModel" == f->GetName()) {
+            ParseSubModel(f);
+        }
+    }
+    _subModelsPending = false;
 }
 
 int Model::CalcCannelsPerString() {
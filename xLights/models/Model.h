@@ -14,6 +14,8 @@
 #include <map>
 #include <vector>
 #include <list>
+#include <atomic>
+#include <mutex>
 
 #include "ModelScreenLocation.h"
 #include "../Color.h"
@@ -225,8 +227,12 @@ protected:
     int rgbwHandlingType;
     std::vector<xlColor> superStringColours;
 
-    std::vector<Model *> subModels;
-    void ParseSubModel(wxXmlNode *subModelNode);
+    // submodels are built from the xml the first time they are asked for rather than every time the model is built
+    mutable std::vector<Model *> subModels;
+    mutable std::atomic_bool _subModelsPending { false };
+    mutable std::mutex _subModelsLock;
+    void ParseSubModel(wxXmlNode *subModelNode) const;
+    void EnsureSubModels() const;
     void ColourClashingChains(wxPGProperty* p);
 
     std::vector<std::string> modelState;
@@ -276,15 +282,16 @@ public:
     void SetSmartRemote(int sr);
     void SetControllerDMXChannel(int ch);
     std::string GetModelChain() const;
-    const std::vector<Model *>& GetSubModels() const { return subModels; }
+    const std::vector<Model *>& GetSubModels() const { EnsureSubModels(); return subModels; }
     Model *GetSubModel(const std::string &name) const;
     std::string GenerateUniqueSubmodelName(const std::string suggested) const;
-    int GetNumSubModels() const { return subModels.size();}
-    Model *GetSubModel(int i) const { return i < (int)subModels.size() ? subModels[i] : nullptr;}
+    int GetNumSubModels() const { EnsureSubModels(); return subModels.size();}
+    Model *GetSubModel(int i) const { EnsureSubModels(); return i < (int)subModels.size() ? subModels[i] : nullptr;}
     void RemoveSubModel(const std::string &name);
     std::list<int> ParseFaceNodes(std::string channels);
 
     unsigned long GetChangeCount() const { return changeCount; }
+    virtual void IncrementChangeCount() override;
 
     std::string rgbOrder;
     bool SingleNode = false;     // true for dumb strings and single channel strings
@@ -318,6 +325,7 @@ public:
     uint32_t GetNodeNumber(size_t nodenum) const;
     uint32_t GetNodeNumber(int bufY, int bufX) const;
     bool UpdateStartChannelFromChannelString(std::map<std::string, Model*>& models, std::list<std::string>& used);
+    bool IsStartChannelCurrent() const;
     int GetNumberFromChannelString(const std::string &sc) const;
     int GetNumberFromChannelString(const std::string &sc, bool &valid, std::string& dependsonmodel) const;
     virtual void DisplayModelOnWindow(ModelPreview* preview, DrawGLUtils::xlAccumulator &solidVa, DrawGLUtils::xlAccumulator &transparentVa, float& minx, float& miny, float& maxx, float& maxy, bool is_3d = false, const xlColor *color = NULL, bool allowSelected = false);
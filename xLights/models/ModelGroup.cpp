@@ -319,7 +319,13 @@ int ModelGroup::GetYCentreOffset() const
     return wxAtoi(ModelXml->GetAttribute("YCentreOffset", "0"));
 }
 
+void ModelGroup::ClearBufferLayoutCache() {
+    std::unique_lock<std::mutex> lock(_bufferLayoutLock);
+    _bufferLayouts.clear();
+}
+
 bool ModelGroup::Reset(bool zeroBased) {
+    ClearBufferLayoutCache();
     this->zeroBased = zeroBased;
     selected = false;
     name = ModelXml->GetAttribute("name").Trim(true).Trim(false).ToStdString();
@@ -654,12 +660,32 @@ bool ModelGroup::SubModelRenamed(const std::string &oldName, const std::string &
     return changed;
 }
 
-void ModelGroup::CheckForChanges() const {
+unsigned long ModelGroup::GetMemberChangeCount() const {
 
     unsigned long l = 0;
     for (const auto& it : models) {
         l += it->GetChangeCount();
     }
+    return l;
+}
+
+void ModelGroup::CheckForChanges() const {
+    std::list<const Model*> visited;
+    CheckForChanges(visited);
+}
+
+void ModelGroup::CheckForChanges(std::list<const Model*>& visited) const {
+    visited.push_back(this);
+
+    // a nested group only picks up changes to its own members when it is checked so check those first,
+    // any that reset change their change count and so trigger a reset (and new buffer layouts) here
+    for (const auto& it : models) {
+        if (it != nullptr && it->GetDisplayAs() == "ModelGroup" && std::find(visited.begin(), visited.end(), it) == visited.end()) {
+            dynamic_cast<const ModelGroup*>(it)->CheckForChanges(visited);
+        }
+    }
+
+    unsigned long l = GetMemberChangeCount();
 
     if (l != changeCount) {
         // this is ugly ... it is casting away the const-ness of this
@@ -812,12 +838,61 @@ static inline void SetCoords(NodeBaseClass::CoordStruct &it2, int x, int y, int
 //    wxASSERT(mgNodesDefault.size() == totalSingleLine);
 //}
 
-void ModelGroup::InitRenderBufferNodes(const std::string &tp,
+std::shared_ptr<const ModelGroup::BufferLayout> ModelGroup::GetBufferLayout(const std::string &type,
+                                                                              const std::string &camera,
+                                                                              const std::string &transform) const {
+    CheckForChanges();
+    const unsigned long cc = GetMemberChangeCount();
+
+    // 3D cameras can be moved without any model changing so those buffers are never cached
+    const bool cacheable = camera == "2D";
+    const std::string key = type + "|" + transform;
+    if (cacheable) {
+        std::unique_lock<std::mutex> lock(_bufferLayoutLock);
+        auto it = _bufferLayouts.find(key);
+        if (it != _bufferLayouts.end() && it->second->changeCount == cc) {
+            return it->second;
+        }
+    }
+
+    // build outside the lock so other styles are not held up ... two threads may occasionally build the same layout
+    auto layout = std::make_shared<BufferLayout>();
+    layout->changeCount = cc;
+    BuildRenderBufferNodes(type, camera, transform, layout->nodes, layout->bufferWi, layout->bufferHt);
+
+    if (cacheable) {
+        std::unique_lock<std::mutex> lock(_bufferLayoutLock);
+        _bufferLayouts[key] = layout;
+    }
+    return layout;
+}
+
+void ModelGroup::InitRenderBufferNodes(const std::string &type,
                                        const std::string& camera,
                                        const std::string &transform,
                                        std::vector<NodeBaseClassPtr> &Nodes,
                                        int &BufferWi, int &BufferHt) const {
-    CheckForChanges();
+    if (!Nodes.empty()) {
+        // appending to an existing buffer ... layout depends on what is already there so build it directly
+        CheckForChanges();
+        BuildRenderBufferNodes(type, camera, transform, Nodes, BufferWi, BufferHt);
+        return;
+    }
+
+    auto layout = GetBufferLayout(type, camera, transform);
+    Nodes.reserve(layout->nodes.size());
+    for (const auto& it : layout->nodes) {
+        Nodes.push_back(NodeBaseClassPtr(it->clone()));
+    }
+    BufferWi = layout->bufferWi;
+    BufferHt = layout->bufferHt;
+}
+
+void ModelGroup::BuildRenderBufferNodes(const std::string &tp,
+                                        const std::string& camera,
+                                        const std::string &transform,
+                                        std::vector<NodeBaseClassPtr> &Nodes,
+                                        int &BufferWi, int &BufferHt) const {
     std::string type = tp;
     if (type.compare(0, 9, "Per Model") == 0) {
         type = "Default";
@@ -12,6 +12,9 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "Model.h"
 
@@ -21,6 +24,15 @@ class ModelGroup : public ModelWithScreenLocation<BoxedScreenLocation>
 {
     public:
 
+        // A computed group render buffer. Once built it is never modified so it can be shared between render threads
+        struct BufferLayout
+        {
+            std::vector<NodeBaseClassPtr> nodes;
+            int bufferWi = 0;
+            int bufferHt = 0;
+            unsigned long changeCount = 0;
+        };
+
         static bool AllModelsExist(wxXmlNode* node, const ModelManager& models);
         static bool RemoveNonExistentModels(wxXmlNode* node, const std::list<std::string>& allmodels);
 
@@ -53,6 +65,7 @@ class ModelGroup : public ModelWithScreenLocation<BoxedScreenLocation>
         virtual void GetBufferSize(const std::string &type, const std::string &camera, const std::string &transform, int &BufferWi, int &BufferHi) const override;
         virtual void InitRenderBufferNodes(const std::string &type, const std::string &camera, const std::string &transform,
                                            std::vector<NodeBaseClassPtr> &Nodes, int &BufferWi, int &BufferHi) const override;
+        std::shared_ptr<const BufferLayout> GetBufferLayout(const std::string &type, const std::string &camera, const std::string &transform) const;
         virtual bool SupportsExportAsCustom() const override { return false; }
         virtual bool SupportsWiringView() const override { return false; }
 
@@ -65,10 +78,19 @@ class ModelGroup : public ModelWithScreenLocation<BoxedScreenLocation>
 
     private:
         void CheckForChanges() const;
+        void CheckForChanges(std::list<const Model*>& visited) const;
+        unsigned long GetMemberChangeCount() const;
+        void ClearBufferLayoutCache();
+        void BuildRenderBufferNodes(const std::string &type, const std::string &camera, const std::string &transform,
+                                    std::vector<NodeBaseClassPtr> &Nodes, int &BufferWi, int &BufferHi) const;
 
         std::vector<std::string> modelNames;
         std::vector<Model *> models;
         bool selected;
         std::string defaultBufferStyle;
+
+        // computed buffers keyed by style/camera/transform
+        mutable std::mutex _bufferLayoutLock;
+        mutable std::map<std::string, std::shared_ptr<const BufferLayout>> _bufferLayouts;
 };
 
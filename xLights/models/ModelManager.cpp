@@ -11,6 +11,9 @@
 #include <wx/xml/xml.h>
 #include <wx/msgdlg.h>
 
+#include <algorithm>
+#include <set>
+
 #include "ModelManager.h"
 #include "Model.h"
 #include "SubModel.h"
@@ -77,6 +80,8 @@ void ModelManager::clear()
         }
     }
     models.clear();
+    _loadedChangeCounts.clear();
+    InvalidateChannelIndex();
 }
 
 inline BaseObject *ModelManager::GetObject(const std::string &name) const {
@@ -138,6 +143,7 @@ bool ModelManager::Rename(const std::string &oldName, const std::string &newName
         }
         models.erase(models.find(on));
         models[nn] = model;
+        InvalidateChannelIndex();
 
         // go through all the model groups looking for things that might need to be renamed
         for (const auto& it : models) {
@@ -184,6 +190,7 @@ bool ModelManager::RenameInListOnly(const std::string& oldName, const std::strin
     std::lock_guard<std::recursive_mutex> lock(_modelMutex);
     models.erase(models.find(on));
     models[nn] = model;
+    InvalidateChannelIndex();
     return true;
 }
 
@@ -222,6 +229,7 @@ void ModelManager::LoadModels(wxXmlNode* modelNode, int previewW, int previewH)
     this->modelNode = modelNode;
     wxStopWatch timer;
     std::list<wxXmlNode*> modelsToLoad;
+    long nodeCount = 0;
     for (wxXmlNode* e = modelNode->GetChildren(); e != nullptr; e = e->GetNext()) {
         if (e->GetName() == "model") {
             std::string name = e->GetAttribute("name").Trim(true).Trim(false).ToStdString();
@@ -230,12 +238,24 @@ void ModelManager::LoadModels(wxXmlNode* modelNode, int previewW, int previewH)
             }
         }
     }
+    long scanTime = timer.Time();
     std::function<void(wxXmlNode*&, int)> f = [this, previewW, previewH] (wxXmlNode *e, int idx) {
         createAndAddModel(e, previewW, previewH);
     };
     parallel_for(modelsToLoad, f);
+    long createTime = timer.Time() - scanTime;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(_modelMutex);
+        _loadedChangeCounts.clear();
+        for (const auto& it : models) {
+            _loadedChangeCounts[it.second] = it.second->GetChangeCount();
+            nodeCount += it.second->GetNodeCount();
+        }
+    }
     //printf("%d Models loaded in %ldms", (int)modelsToLoad.size(), timer.Time());
-    logger_base.debug("Models loaded in %ldms", timer.Time());
+    logger_base.debug("%d Models loaded in %ldms: xml scan %ldms, model create %ldms, %ld nodes.",
+        (int)modelsToLoad.size(), timer.Time(), scanTime, createTime, nodeCount);
     _modelsLoading = false;
 
     xlights->GetOutputModelManager()->AddASAPWork(OutputModelManager::WORK_CALCULATE_START_CHANNELS, "ModelManager::LoadModels");
@@ -328,11 +348,28 @@ bool ModelManager::RecalcStartChannels() const {
     bool changed = false;
     std::list<std::string> modelsDone;
 
+    // models LoadModels built whose absolute start channel still resolves to the same place do not need rebuilding.
+    // Only models that are unchanged since the load qualify and this only applies to the first pass after a load.
+    std::map<const Model*, unsigned long> loaded;
+    std::swap(loaded, _loadedChangeCounts);
+    std::set<const Model*> current;
+    for (const auto& it : models) {
+        auto l = loaded.find(it.second);
+        if (l != loaded.end() && l->second == it.second->GetChangeCount() &&
+            it.second->CouldComputeStartChannel && it.second->IsStartChannelCurrent()) {
+            current.insert(it.second);
+        }
+    }
+    int skipped = 0;
+    int rebuilt = 0;
+
     for (const auto& it : models) {
         it.second->CouldComputeStartChannel = false;
     }
 
     // first go through all models whose start channels are not dependent on other models
+    // these do not depend on each other so they can be rebuilt in parallel
+    std::vector<Model*> independent;
     for (const auto& it : models) {
         if (it.second->GetDisplayAs() != "ModelGroup")
         {
@@ -341,15 +378,30 @@ bool ModelManager::RecalcStartChannels() const {
             if (first != '>' && first != '@')
             {
                 modelsDone.push_back(it.first);
-                auto oldsc = it.second->GetFirstChannel();
-                it.second->SetFromXml(it.second->GetModelXml());
-                if (oldsc != it.second->GetFirstChannel())
+                if (current.find(it.second) != current.end())
                 {
-                    changed = true;
+                    it.second->CouldComputeStartChannel = true;
+                    skipped++;
+                }
+                else
+                {
+                    independent.push_back(it.second);
                 }
             }
         }
     }
+    std::atomic_bool independentChanged(false);
+    parallel_for(0, independent.size(), [&independent, &independentChanged](int i) {
+        Model* m = independent[i];
+        auto oldsc = m->GetFirstChannel();
+        m->SetFromXml(m->GetModelXml());
+        if (oldsc != m->GetFirstChannel())
+        {
+            independentChanged = true;
+        }
+    });
+    rebuilt += independent.size();
+    changed |= independentChanged;
 
     // now go through all undone models that depend on something
     bool workDone = false;
@@ -371,6 +423,7 @@ bool ModelManager::RecalcStartChannels() const {
                         modelsDone.push_back(it.first);
                         auto oldsc = it.second->GetFirstChannel();
                         it.second->SetFromXml(it.second->GetModelXml());
+                        rebuilt++;
                         if (oldsc != it.second->GetFirstChannel())
                         {
                             changed = true;
@@ -398,6 +451,7 @@ bool ModelManager::RecalcStartChannels() const {
                 modelsDone.push_back(it.first);
                 auto oldsc = it.second->GetFirstChannel();
                 it.second->SetFromXml(it.second->GetModelXml());
+                rebuilt++;
                 if (oldsc != it.second->GetFirstChannel())
                 {
                     changed = true;
@@ -412,7 +466,7 @@ bool ModelManager::RecalcStartChannels() const {
     ResetModelGroups();
 
     long end = sw.Time();
-    logger_base.debug("RecalcStartChannels takes %ldms.", end);
+    logger_base.debug("RecalcStartChannels takes %ldms. %d models rebuilt, %d unchanged since load.", end, rebuilt, skipped);
 
     if (countInvalid > 0) {
         DisplayStartChannelCalcWarning();
@@ -1233,11 +1287,13 @@ void ModelManager::AddModel(Model *model) {
         std::lock_guard<std::recursive_mutex> _lock(_modelMutex);
         auto it = models.find(model->name);
         if (it != models.end()) {
+            _loadedChangeCounts.erase(it->second);
             delete it->second;
             it->second = nullptr;
             ResetModelGroups();
         }
         models[model->name] = model;
+        InvalidateChannelIndex();
 
         if ("ModelGroup" == model->GetDisplayAs()) {
             if (model->GetModelXml()->GetParent() != groupNode) {
@@ -1268,18 +1324,14 @@ std::string ModelManager::GetModelsOnChannels(uint32_t start, uint32_t end, int
     std::string res;
     std::string line;
 
-    for (const auto& it : *this) {
-        if (it.second->GetDisplayAs() != "ModelGroup") {
-            if (perLine > 0 && CountChar(line, ',') >= perLine - 1) {
-                if (res != "") res += "\n";
-                res += line;
-                line = "";
-            }
-            if (it.second->GetFirstChannel()+1 <= end && it.second->GetLastChannel() + 1 >= start) {
-                if (line != "") line += ", ";
-                line += it.first;
-            }
+    for (const auto& it : GetModelsInChannelRange(start, end)) {
+        if (perLine > 0 && CountChar(line, ',') >= perLine - 1) {
+            if (res != "") res += "\n";
+            res += line;
+            line = "";
         }
+        if (line != "") line += ", ";
+        line += it->GetName();
     }
 
     if (line != "") {
@@ -1290,6 +1342,90 @@ std::string ModelManager::GetModelsOnChannels(uint32_t start, uint32_t end, int
 	return res;
 }
 
+void ModelManager::ValidateChannelIndex() const {
+
+    // models invalidate the index whenever their change count moves, SetFromXml bumps it whenever channels are recalculated
+    if (_channelIndexValid) return;
+    // marked valid before reading the models so a change made while this runs causes another rebuild
+    _channelIndexValid = true;
+
+    _channelIndex.clear();
+    _channelIndex.reserve(models.size());
+    for (const auto& it : models) {
+        if (it.second->GetDisplayAs() != "ModelGroup") {
+            _channelIndex.push_back({ it.second->GetFirstChannel() + 1, it.second->GetLastChannel() + 1, it.second });
+        }
+    }
+    std::stable_sort(_channelIndex.begin(), _channelIndex.end(), [](const ChannelRange& a, const ChannelRange& b) { return a.start < b.start; });
+
+    _channelIndexMaxEnd.resize(_channelIndex.size());
+    uint32_t maxEnd = 0;
+    for (size_t i = 0; i < _channelIndex.size(); i++) {
+        maxEnd = std::max(maxEnd, _channelIndex[i].end);
+        _channelIndexMaxEnd[i] = maxEnd;
+    }
+}
+
+std::vector<Model*> ModelManager::GetModelsInChannelRange(uint32_t start, uint32_t end) const {
+
+    std::lock_guard<std::recursive_mutex> lock(_modelMutex);
+    ValidateChannelIndex();
+
+    // everything before last can start on or before end ... everything from first on can end on or after start
+    size_t last = std::upper_bound(_channelIndex.begin(), _channelIndex.end(), end, [](uint32_t ch, const ChannelRange& r) { return ch < r.start; }) - _channelIndex.begin();
+    size_t first = std::lower_bound(_channelIndexMaxEnd.begin(), _channelIndexMaxEnd.end(), start) - _channelIndexMaxEnd.begin();
+
+    std::vector<Model*> res;
+    for (size_t i = first; i < last; i++) {
+        if (_channelIndex[i].end >= start) {
+            res.push_back(_channelIndex[i].model);
+        }
+    }
+    std::sort(res.begin(), res.end(), [](const Model* a, const Model* b) { return a->GetName() < b->GetName(); });
+
+#ifdef _DEBUG
+    // models is keyed by name so the scan is already in name order
+    std::vector<Model*> check;
+    for (const auto& it : models) {
+        if (it.second->GetDisplayAs() != "ModelGroup") {
+            if (it.second->GetFirstChannel() + 1 <= end && it.second->GetLastChannel() + 1 >= start) {
+                check.push_back(it.second);
+            }
+        }
+    }
+    wxASSERT(check == res);
+#endif
+
+    return res;
+}
+
+std::list<std::pair<Model*, Model*>> ModelManager::GetOverlappingModels() const {
+
+    std::lock_guard<std::recursive_mutex> lock(_modelMutex);
+    ValidateChannelIndex();
+
+    // sweep in start channel order ... only ranges starting before the current one ends can overlap it
+    std::list<std::pair<Model*, Model*>> res;
+    for (size_t i = 0; i < _channelIndex.size(); i++) {
+        for (size_t j = i + 1; j < _channelIndex.size() && _channelIndex[j].start <= _channelIndex[i].end; j++) {
+            if (_channelIndex[j].end >= _channelIndex[i].start) {
+                if (_channelIndex[i].model->GetName() < _channelIndex[j].model->GetName()) {
+                    res.push_back({ _channelIndex[i].model, _channelIndex[j].model });
+                }
+                else {
+                    res.push_back({ _channelIndex[j].model, _channelIndex[i].model });
+                }
+            }
+        }
+    }
+    res.sort([](const std::pair<Model*, Model*>& a, const std::pair<Model*, Model*>& b) {
+        if (a.first->GetName() == b.first->GetName()) return a.second->GetName() < b.second->GetName();
+        return a.first->GetName() < b.first->GetName();
+    });
+
+    return res;
+}
+
 void ModelManager::Delete(const std::string &name) {
 
     if( xlights->CurrentSeqXmlFile != nullptr )
@@ -1333,6 +1469,8 @@ void ModelManager::Delete(const std::string &name) {
                     }
                 }
                 models.erase(it);
+                _loadedChangeCounts.erase(model);
+                InvalidateChannelIndex();
                 ResetModelGroups();
 
                 // If models are chained to us then make their start channel ... our start channel
@@ -13,6 +13,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <list>
 #include <mutex>
 #include <atomic>
 
@@ -79,8 +80,24 @@ class ModelManager : public ObjectManager
         Model *createAndAddModel(wxXmlNode *node, int previewW, int previewH);
         std::string GetModelsOnChannels(uint32_t start, uint32_t end, int perLine) const;
 
+        // Channel queries use 1 based absolute channel numbers and only consider non group models.
+        // Results are returned in model name order.
+        std::vector<Model*> GetModelsInChannelRange(uint32_t start, uint32_t end) const;
+        std::list<std::pair<Model*, Model*>> GetOverlappingModels() const;
+        // called by models when their change count moves as their channels may have too
+        void InvalidateChannelIndex() const { _channelIndexValid = false; }
+
     private:
 
+    struct ChannelRange
+    {
+        uint32_t start;
+        uint32_t end;
+        Model* model;
+    };
+
+    void ValidateChannelIndex() const;
+
     wxXmlNode *layoutsNode = nullptr;
     OutputManager* _outputManager = nullptr;
     xLightsFrame* xlights = nullptr;
@@ -89,5 +106,13 @@ class ModelManager : public ObjectManager
     std::map<std::string, Model *> models;
     mutable std::recursive_mutex _modelMutex;
     std::atomic<bool> _modelsLoading;
+
+    // models sorted by start channel with a running maximum of end channel so range queries can binary search
+    mutable std::vector<ChannelRange> _channelIndex;
+    mutable std::vector<uint32_t> _channelIndexMaxEnd;
+    mutable std::atomic<bool> _channelIndexValid{ false };
+
+    // change counts of models as LoadModels built them ... lets the first start channel pass skip models it would rebuild identically
+    mutable std::map<const Model*, unsigned long> _loadedChangeCounts;
 };
 
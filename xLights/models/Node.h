@@ -165,6 +165,11 @@ public:
         color.Set(c[0],c[1],c[2]);
     }
 
+    // the colour as stored, GetColor and GetForChannels are both worked out from these three bytes
+    const uint8_t *GetRawColor() const {
+        return c;
+    }
+
     void GetMaskColor(xlColor& color) const {
         color = _maskColor;
     }
@@ -59,6 +59,49 @@ void DDPOutput::OpenDatagram() {
         _ok = false;
     }
 }
+
+// Sends size channels starting at index in as many packets as needed. push is true if these are the last packets of the frame.
+void DDPOutput::SendData(int32_t index, int32_t size, bool push) {
+
+    int32_t chan = (_keepChannelNumbers ? (_startChannel - 1) : 0) + index;
+    int32_t tosend = size;
+
+    while (tosend > 0) {
+        int32_t thissend = (tosend < _channelsPerPacket) ? tosend : _channelsPerPacket;
+
+        if (__initialised) {
+            // sync packet will boadcast later
+            _data[0] = DDP_FLAGS1_VER1;
+        }
+        else {
+            if (push && tosend == thissend) {
+                _data[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
+            }
+            else {
+                _data[0] = DDP_FLAGS1_VER1;
+            }
+        }
+
+        _data[1] = (_data[1] & 0xF0) + _sequenceNum;
+
+        _data[4] = (chan & 0xFF000000) >> 24;
+        _data[5] = (chan & 0xFF0000) >> 16;
+        _data[6] = (chan & 0xFF00) >> 8;
+        _data[7] = (chan & 0xFF);
+
+        _data[8] = (thissend & 0xFF00) >> 8;
+        _data[9] = thissend & 0x00FF;
+
+        memcpy(&_data[10], _fulldata + index, thissend);
+
+        _datagram->SendTo(_remoteAddr, &_data[0], DDP_PACKET_LEN - (1440 - thissend));
+        _sequenceNum = _sequenceNum == 15 ? 1 : _sequenceNum + 1;
+
+        tosend -= thissend;
+        index += thissend;
+        chan += thissend;
+    }
+}
 #pragma endregion
 
 #pragma region Constructors and Destructors
@@ -67,6 +110,8 @@ DDPOutput::DDPOutput(wxXmlNode* node) : IPOutput(node) {
     _fulldata = nullptr;
     _channelsPerPacket = wxAtoi(node->GetAttribute("ChannelsPerPacket"));
     _keepChannelNumbers = wxAtoi(node->GetAttribute("KeepChannelNumbers"));
+    _deltaOutput = wxAtoi(node->GetAttribute("DeltaOutput", "0"));
+    _deltaRefreshFrames = wxAtoi(node->GetAttribute("DeltaRefreshFrames", "40"));
     _sequenceNum = 0;
     _datagram = nullptr;
     memset(_data, 0, sizeof(_data));
@@ -96,6 +141,10 @@ wxXmlNode* DDPOutput::Save() {
 
     node->AddAttribute("ChannelsPerPacket", wxString::Format("%i", _channelsPerPacket));
     node->AddAttribute("KeepChannelNumbers", _keepChannelNumbers ? "1" : "0");
+    if (_deltaOutput) {
+        node->AddAttribute("DeltaOutput", "1");
+        node->AddAttribute("DeltaRefreshFrames", wxString::Format("%i", _deltaRefreshFrames));
+    }
     IPOutput::Save(node);
 
     return node;
@@ -190,6 +239,7 @@ bool DDPOutput::Open() {
         _ok = false;
         return false;
     }
+    if (_deltaOutput) InitDirtyBlocks();
     AllOff();
 
     _ok = IPOutput::Open();
@@ -253,46 +303,27 @@ void DDPOutput::EndFrame(int suppressFrames) {
     }
     if (_datagram == nullptr) return;
 
-    if (_changed || NeedToOutput(suppressFrames)) {
-        int32_t index = 0;
-        int32_t chan = _keepChannelNumbers ? (_startChannel - 1) : 0;
-        int32_t tosend = _channels;
-
-        while (tosend > 0) {
-            int32_t thissend = (tosend < _channelsPerPacket) ? tosend : _channelsPerPacket;
-
-            if (__initialised) {
-                // sync packet will boadcast later
-                _data[0] = DDP_FLAGS1_VER1;
-            }
-            else {
-                if (tosend == thissend) {
-                    _data[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_PUSH;
-                }
-                else {
-                    _data[0] = DDP_FLAGS1_VER1;
-                }
+    if (_deltaOutput) {
+        // only send the changed blocks but send everything every so often in case a packet was lost
+        if (IsFullOutputDue()) {
+            SendData(0, _channels, true);
+            CheckDeltaFrame(_fulldata, _channels, { { 0, _channels } });
+            DeltaFrameOutput(true);
+        }
+        else if (_changed) {
+            auto ranges = GetDirtyRanges(_channels);
+            for (size_t i = 0; i < ranges.size(); i++) {
+                SendData(ranges[i].first, ranges[i].second, i == ranges.size() - 1);
             }
-
-            _data[1] = (_data[1] & 0xF0) + _sequenceNum;
-
-            _data[4] = (chan & 0xFF000000) >> 24;
-            _data[5] = (chan & 0xFF0000) >> 16;
-            _data[6] = (chan & 0xFF00) >> 8;
-            _data[7] = (chan & 0xFF);
-
-            _data[8] = (thissend & 0xFF00) >> 8;
-            _data[9] = thissend & 0x00FF;
-
-            memcpy(&_data[10], _fulldata + index, thissend);
-
-            _datagram->SendTo(_remoteAddr, &_data[0], DDP_PACKET_LEN - (1440 - thissend));
-            _sequenceNum = _sequenceNum == 15 ? 1 : _sequenceNum + 1;
-
-            tosend -= thissend;
-            index += thissend;
-            chan += thissend;
+            CheckDeltaFrame(_fulldata, _channels, ranges);
+            DeltaFrameOutput(false);
         }
+        else {
+            _framesSinceFullOutput++;
+            SkipFrame();
+        }
+    } else if (_changed || NeedToOutput(suppressFrames)) {
+        SendData(0, _channels, true);
         FrameOutput();
     } else {
         SkipFrame();
@@ -313,6 +344,7 @@ void DDPOutput::SetOneChannel(int32_t channel, unsigned char data) {
 
     if ((channel < _channels) && (*(_fulldata + channel) != data)) {
         *(_fulldata + channel) = data;
+        if (_deltaOutput) MarkDirty(channel);
         _changed = true;
     }
 }
@@ -329,7 +361,11 @@ void DDPOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t siz
 
     size_t chs = (std::min)((int32_t)size, _channels - channel);
 
-    if (memcmp(_fulldata + channel, data, chs) == 0) {
+    if (_deltaOutput) {
+        if (CopyChannels(_fulldata, channel, data, chs)) {
+            _changed = true;
+        }
+    } else if (memcmp(_fulldata + channel, data, chs) == 0) {
         // nothing changed
     } else {
         memcpy(_fulldata + channel, data, chs);
@@ -347,6 +383,7 @@ void DDPOutput::AllOff() {
     }
     if (_fulldata == nullptr) return;
     memset(_fulldata, 0x00, _channels);
+    MarkAllDirty();
     _changed = true;
 }
 #pragma endregion
@@ -362,6 +399,14 @@ void DDPOutput::AddProperties(wxPropertyGrid* propertyGrid, bool allSameSize)
 
     p = propertyGrid->Append(new wxBoolProperty("Keep Channel Numbers", "KeepChannelNumbers", IsKeepChannelNumbers()));
     p->SetEditor("CheckBox");
+
+    p = propertyGrid->Append(new wxBoolProperty("Send Changed Channels Only", "DeltaOutput", IsDeltaOutput()));
+    p->SetEditor("CheckBox");
+
+    p = propertyGrid->Append(new wxUIntProperty("Send All Channels Every N Frames", "DeltaRefreshFrames", GetDeltaRefreshFrames()));
+    p->SetAttribute("Min", 1);
+    p->SetAttribute("Max", 1000);
+    p->SetEditor("SpinCtrl");
 }
 
 bool DDPOutput::HandlePropertyEvent(wxPropertyGridEvent& event, OutputModelManager* outputModelManager) {
@@ -376,6 +421,14 @@ bool DDPOutput::HandlePropertyEvent(wxPropertyGridEvent& event, OutputModelManag
         SetKeepChannelNumber(event.GetValue().GetBool());
         outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "DDPOutput::HandlePropertyEvent::KeepChannelNumbers");
         return true;
+    } else if (name == "DeltaOutput") {
+        SetDeltaOutput(event.GetValue().GetBool());
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "DDPOutput::HandlePropertyEvent::DeltaOutput");
+        return true;
+    } else if (name == "DeltaRefreshFrames") {
+        SetDeltaRefreshFrames(event.GetValue().GetLong());
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "DDPOutput::HandlePropertyEvent::DeltaRefreshFrames");
+        return true;
     }
 
     return false;
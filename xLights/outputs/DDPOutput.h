@@ -55,6 +55,7 @@ class DDPOutput : public IPOutput
 
     #pragma region Private Functions
     void OpenDatagram();
+    void SendData(int32_t index, int32_t size, bool push);
     #pragma  endregion
 
 public:
@@ -60,6 +60,8 @@ Output::Output(Output* output) {
     _autoSize_CONVERT = output->IsAutoSize_CONVERT();
     _fppProxy = output->GetFPPProxyIP();
     _enabled = output->IsEnabled();
+    _deltaOutput = output->IsDeltaOutput();
+    _deltaRefreshFrames = output->GetDeltaRefreshFrames();
 }
 
 Output::Output(wxXmlNode* node) {
@@ -241,6 +243,106 @@ void Output::SetManyChannels(int32_t channel, unsigned char* data, size_t size)
 }
 #pragma endregion 
 
+#pragma region Delta Output
+// Sizes the dirty flags to the channel count and marks everything dirty so the first frame is sent in full
+void Output::InitDirtyBlocks() {
+    _dirtyBlocks.assign((_channels + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE, 1);
+    _framesSinceFullOutput = _deltaRefreshFrames;
+#ifdef _DEBUG
+    _deltaReceiver.clear();
+    _deltaReceiverSynced = false;
+#endif
+}
+
+// Copies data into dest a block at a time flagging each block that actually changed. Returns true if anything changed.
+bool Output::CopyChannels(uint8_t* dest, int32_t channel, const uint8_t* data, size_t size) {
+
+    bool changed = false;
+    size_t done = 0;
+    while (done < size) {
+        int32_t ch = channel + (int32_t)done;
+        size_t len = (std::min)(size - done, (size_t)(DELTA_BLOCK_SIZE - ch % DELTA_BLOCK_SIZE));
+        if (memcmp(dest + ch, data + done, len) != 0) {
+            memcpy(dest + ch, data + done, len);
+            MarkDirty(ch);
+            changed = true;
+        }
+        done += len;
+    }
+    return changed;
+}
+
+// Returns the start and length of each run of dirty channels below channels. Runs separated by a single clean
+// block are merged as resending 64 unchanged channels is cheaper than the header of another packet.
+std::vector<std::pair<int32_t, int32_t>> Output::GetDirtyRanges(int32_t channels) const {
+
+    std::vector<std::pair<int32_t, int32_t>> res;
+    int32_t blocks = (std::min)((int32_t)_dirtyBlocks.size(), (channels + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE);
+    int32_t b = 0;
+    while (b < blocks) {
+        if (_dirtyBlocks[b] == 0) {
+            b++;
+            continue;
+        }
+        int32_t first = b;
+        int32_t last = b;
+        while (b < blocks && (_dirtyBlocks[b] != 0 || (b + 1 < blocks && _dirtyBlocks[b + 1] != 0))) {
+            if (_dirtyBlocks[b] != 0) last = b;
+            b++;
+        }
+        int32_t start = first * DELTA_BLOCK_SIZE;
+        int32_t end = (std::min)((last + 1) * DELTA_BLOCK_SIZE, channels);
+        res.push_back({ start, end - start });
+    }
+    return res;
+}
+
+// Debug builds only. Rebuilds the frame the way a receiver would from just the ranges sent and checks it matches a
+// full send of data ... catches a merged run, the partial last block or a skipped full frame leaving a channel stale.
+// Checking starts with the first full frame as until then the receiver's contents are unknown.
+void Output::CheckDeltaFrame(const uint8_t* data, int32_t channels, const std::vector<std::pair<int32_t, int32_t>>& sent) {
+#ifdef _DEBUG
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+    if (_deltaReceiver.size() != (size_t)channels) {
+        _deltaReceiver.assign(channels, 0);
+        _deltaReceiverSynced = false;
+    }
+    for (const auto& it : sent) {
+        if (it.first < 0 || it.second < 0 || it.first + it.second > channels) {
+            logger_base.error("Changed channels only output %s sent channels %d-%d outside the %d channel frame.",
+                (const char*)GetLongDescription().c_str(), it.first, it.first + it.second - 1, channels);
+            wxASSERT(false);
+            continue;
+        }
+        memcpy(&_deltaReceiver[it.first], data + it.first, it.second);
+        if (it.first == 0 && it.second == channels) _deltaReceiverSynced = true;
+    }
+    if (_deltaReceiverSynced && channels > 0 && memcmp(&_deltaReceiver[0], data, channels) != 0) {
+        int32_t ch = 0;
+        while (_deltaReceiver[ch] == data[ch]) ch++;
+        logger_base.error("Changed channels only output %s would leave channel %d stale at the receiver.",
+            (const char*)GetLongDescription().c_str(), ch + 1);
+        wxASSERT(false);
+        // resync so one bad frame is only reported once
+        memcpy(&_deltaReceiver[0], data, channels);
+    }
+#endif
+}
+
+// Call instead of FrameOutput once a frame has been sent, full is true if every channel was sent
+void Output::DeltaFrameOutput(bool full) {
+    std::fill(_dirtyBlocks.begin(), _dirtyBlocks.end(), 0);
+    if (full) {
+        _framesSinceFullOutput = 0;
+    }
+    else {
+        _framesSinceFullOutput++;
+    }
+    FrameOutput();
+}
+#pragma endregion
+
 #pragma region Frame Handling
 void Output::FrameOutput() {
     _lastOutputTime = wxGetUTCTimeMillis();
@@ -10,7 +10,9 @@
  * License: https://github.com/smeighan/xLights/blob/master/License.txt
  **************************************************************/
 
+#include <algorithm>
 #include <list>
+#include <vector>
 
 #include <wx/window.h>
 #include <wx/time.h>
@@ -42,6 +44,9 @@ class Controller;
 #define OUTPUT_xxxSERIAL "xxx Serial"
 #define OUTPUT_xxxETHERNET "xxx Ethernet"
 #define OUTPUT_OPC "OPC"
+
+// Changed channels only outputs track changes in blocks of this many channels
+#define DELTA_BLOCK_SIZE 64
 #pragma endregion
 
 class Output
@@ -68,6 +73,14 @@ protected:
     bool _changed = false; // set to true when something in the packed has changed
     std::string _fppProxy;
     Output *_fppProxyOutput = nullptr;
+    bool _deltaOutput = false; // only send the blocks of channels that changed
+    int _deltaRefreshFrames = 40; // when only sending changes still send everything this often
+    int _framesSinceFullOutput = 0;
+    std::vector<uint8_t> _dirtyBlocks; // one flag per DELTA_BLOCK_SIZE channels
+#ifdef _DEBUG
+    std::vector<uint8_t> _deltaReceiver; // the frame a receiver would hold having only seen what was sent
+    bool _deltaReceiverSynced = false;
+#endif
 
     bool _autoSize_CONVERT = false;
     std::string _description_CONVERT;
@@ -77,6 +90,17 @@ protected:
     virtual void Save(wxXmlNode* node);
 #pragma endregion
 
+#pragma region Delta Output
+    void InitDirtyBlocks();
+    bool CopyChannels(uint8_t* dest, int32_t channel, const uint8_t* data, size_t size);
+    void MarkDirty(int32_t channel) { if (channel / DELTA_BLOCK_SIZE < (int32_t)_dirtyBlocks.size()) _dirtyBlocks[channel / DELTA_BLOCK_SIZE] = 1; }
+    void MarkAllDirty() { std::fill(_dirtyBlocks.begin(), _dirtyBlocks.end(), 1); }
+    std::vector<std::pair<int32_t, int32_t>> GetDirtyRanges(int32_t channels) const;
+    bool IsFullOutputDue() const { return !_deltaOutput || _dirtyBlocks.empty() || _framesSinceFullOutput >= _deltaRefreshFrames; }
+    void DeltaFrameOutput(bool full);
+    void CheckDeltaFrame(const uint8_t* data, int32_t channels, const std::vector<std::pair<int32_t, int32_t>>& sent);
+#pragma endregion
+
 public:
 
     enum class PINGSTATE
@@ -163,6 +187,12 @@ public:
     void SetSuppressDuplicateFrames(const bool suppressDuplicateFrames) { _suppressDuplicateFrames = suppressDuplicateFrames; _dirty = true; }
     bool IsSuppressDuplicateFrames() const { return _suppressDuplicateFrames; }
 
+    void SetDeltaOutput(bool deltaOutput) { if (_deltaOutput != deltaOutput) { _deltaOutput = deltaOutput; _dirty = true; } }
+    bool IsDeltaOutput() const { return _deltaOutput; }
+
+    void SetDeltaRefreshFrames(int frames) { if (_deltaRefreshFrames != frames) { _deltaRefreshFrames = frames; _dirty = true; } }
+    int GetDeltaRefreshFrames() const { return _deltaRefreshFrames; }
+
     virtual void SetTransientData(int32_t& startChannel, int nullnumber);
 
     virtual std::string GetLongDescription() const = 0;
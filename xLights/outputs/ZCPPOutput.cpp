@@ -114,6 +114,8 @@ ZCPPOutput::ZCPPOutput(Controller* c, wxXmlNode* node, std::string showdir) : IP
     _supportsSmartRemotes = node->GetAttribute("SupportsSmartRemotes", "FALSE") == "TRUE";
     _multicast = node->GetAttribute("Multicast", "FALSE") == "TRUE";
     _dontConfigure = node->GetAttribute("DontConfigure", "FALSE") == "TRUE";
+    _deltaOutput = node->GetAttribute("DeltaOutput", "FALSE") == "TRUE";
+    _deltaRefreshFrames = wxAtoi(node->GetAttribute("DeltaRefreshFrames", "40"));
     DeserialiseProtocols(node->GetAttribute("Protocols", ""));
 
     if (!_dontConfigure) {
@@ -268,6 +270,10 @@ wxXmlNode* ZCPPOutput::Save() {
     }
     if (_dontConfigure)node->AddAttribute("DontConfigure", "TRUE");
     if (_multicast)node->AddAttribute("Multicast", "TRUE");
+    if (_deltaOutput) {
+        node->AddAttribute("DeltaOutput", "TRUE");
+        node->AddAttribute("DeltaRefreshFrames", wxString::Format("%d", _deltaRefreshFrames));
+    }
     node->AddAttribute("Protocols", SerialiseProtocols());
     IPOutput::Save(node);
 
@@ -683,6 +689,7 @@ void ZCPPOutput::SetChannels(int32_t channels) {
         _data = (wxByte*)malloc(_channels);
         if (_data != nullptr) memset(_data, 0x00, _channels);
         if (_usedChannels > _channels) _usedChannels = _channels;
+        if (_deltaOutput) InitDirtyBlocks();
     }
 }
 
@@ -690,6 +697,7 @@ void ZCPPOutput::AllOn() {
 
     // turn everything to a dim white
     memset(_data, 0x20, _channels);
+    MarkAllDirty();
     _changed = true;
 }
 
@@ -832,6 +840,8 @@ bool ZCPPOutput::Open() {
 
     _ok = IPOutput::Open();
 
+    if (_deltaOutput) InitDirtyBlocks();
+
     memset(&_packet, 0x00, sizeof(_packet));
     _sequenceNum = 0;
 
@@ -885,6 +895,26 @@ void ZCPPOutput::Close() {
 #pragma endregion
 
 #pragma region Frame Handling
+// Sends size channels starting at start. first and last mark the first and last packets of the frame.
+void ZCPPOutput::SendData(long start, long size, bool first, bool last) {
+
+    long i = start;
+    long end = start + size;
+    while (i < end) {
+        _packet.Data.sequenceNumber = _sequenceNum;
+        uint32_t startAddress = i;
+        _packet.Data.frameAddress = ntohl(startAddress);
+        uint16_t packetlen = end - i > sizeof(ZCPP_packet_t) - ZCPP_DATA_HEADER_SIZE ? sizeof(ZCPP_packet_t) - ZCPP_DATA_HEADER_SIZE : end - i;
+        _packet.Data.flags = (OutputManager::IsSyncEnabled_() ? ZCPP_DATA_FLAG_SYNC_WILL_BE_SENT : 0x00) +
+                      (last && i + packetlen == end ? ZCPP_DATA_FLAG_LAST : 0x00) +
+                      (first && i == start ? ZCPP_DATA_FLAG_FIRST : 0x00);
+        _packet.Data.packetDataLength = ntohs(packetlen);
+        memcpy(_packet.Data.data, &_data[i], packetlen);
+        _datagram->SendTo(_remoteAddr, &_packet, ZCPP_GetPacketActualSize(_packet));
+        i += packetlen;
+    }
+}
+
 void ZCPPOutput::StartFrame(long msec) {
 
     if (!_enabled) return;
@@ -941,21 +971,30 @@ void ZCPPOutput::EndFrame(int suppressFrames) {
         }
     }
 
-    if (_changed || NeedToOutput(suppressFrames)) {
-        long i = 0;
-        while (i < _usedChannels) {
-            _packet.Data.sequenceNumber = _sequenceNum;
-            uint32_t startAddress = i;
-            _packet.Data.frameAddress = ntohl(startAddress);
-            uint16_t packetlen = _usedChannels - i > sizeof(ZCPP_packet_t) - ZCPP_DATA_HEADER_SIZE ? sizeof(ZCPP_packet_t) - ZCPP_DATA_HEADER_SIZE : _usedChannels - i;
-            _packet.Data.flags = (OutputManager::IsSyncEnabled_() ? ZCPP_DATA_FLAG_SYNC_WILL_BE_SENT : 0x00) +
-                          (i + packetlen == _usedChannels ? ZCPP_DATA_FLAG_LAST : 0x00) +
-                          (i == 0 ? ZCPP_DATA_FLAG_FIRST : 0x00);
-            _packet.Data.packetDataLength = ntohs(packetlen);
-            memcpy(_packet.Data.data, &_data[i], packetlen);
-            _datagram->SendTo(_remoteAddr, &_packet, ZCPP_GetPacketActualSize(_packet));
-            i += packetlen;
+    if (_deltaOutput) {
+        // only send the changed blocks but send everything every so often in case a packet was lost
+        if (IsFullOutputDue()) {
+            SendData(0, _usedChannels, true, true);
+            _sequenceNum++;
+            CheckDeltaFrame(_data, _usedChannels, { { 0, (int32_t)_usedChannels } });
+            DeltaFrameOutput(true);
         }
+        else if (_changed) {
+            auto ranges = GetDirtyRanges(_usedChannels);
+            for (size_t i = 0; i < ranges.size(); i++) {
+                SendData(ranges[i].first, ranges[i].second, i == 0, i == ranges.size() - 1);
+            }
+            if (!ranges.empty()) _sequenceNum++;
+            CheckDeltaFrame(_data, _usedChannels, ranges);
+            DeltaFrameOutput(false);
+        }
+        else {
+            _framesSinceFullOutput++;
+            SkipFrame();
+        }
+    }
+    else if (_changed || NeedToOutput(suppressFrames)) {
+        SendData(0, _usedChannels, true, true);
         _sequenceNum++;
 
         FrameOutput();
@@ -978,6 +1017,7 @@ void ZCPPOutput::SetOneChannel(int32_t channel, unsigned char data) {
 
     if (_data[channel] != data) {
         _data[channel] = data;
+        if (_deltaOutput) MarkDirty(channel);
         _changed = true;
     }
 }
@@ -988,7 +1028,12 @@ void ZCPPOutput::SetManyChannels(int32_t channel, unsigned char* data, size_t si
 
     size_t chs = std::min(size, (size_t)(_channels - channel));
 
-    if (memcmp(&_data[channel], data, chs) != 0)
+    if (_deltaOutput) {
+        if (CopyChannels(_data, channel, data, chs)) {
+            _changed = true;
+        }
+    }
+    else if (memcmp(&_data[channel], data, chs) != 0)
     {
         memcpy(&_data[channel], data, chs);
         _changed = true;
@@ -999,6 +1044,7 @@ void ZCPPOutput::AllOff() {
 
     if (!_enabled) return;
     memset(_data, 0x00, _channels);
+    MarkAllDirty();
     _changed = true;
 }
 #pragma endregion 
@@ -1022,6 +1068,14 @@ void ZCPPOutput::AddProperties(wxPropertyGrid* propertyGrid, bool allSameSize) {
 
     p = propertyGrid->Append(new wxBoolProperty("Suppress Sending Configuration", "DontSendConfig", IsDontConfigure()));
     p->SetEditor("CheckBox");
+
+    p = propertyGrid->Append(new wxBoolProperty("Send Changed Channels Only", "DeltaOutput", IsDeltaOutput()));
+    p->SetEditor("CheckBox");
+
+    p = propertyGrid->Append(new wxUIntProperty("Send All Channels Every N Frames", "DeltaRefreshFrames", GetDeltaRefreshFrames()));
+    p->SetAttribute("Min", 1);
+    p->SetAttribute("Max", 1000);
+    p->SetEditor("SpinCtrl");
 }
 
 bool ZCPPOutput::HandlePropertyEvent(wxPropertyGridEvent& event, OutputModelManager* outputModelManager) {
@@ -1048,6 +1102,16 @@ bool ZCPPOutput::HandlePropertyEvent(wxPropertyGridEvent& event, OutputModelMana
         outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "ControllerEthernet::HandlePropertyEvent::DontSendConfig");
         return true;
     }
+    else if (name == "DeltaOutput") {
+        SetDeltaOutput(event.GetValue().GetBool());
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "ControllerEthernet::HandlePropertyEvent::DeltaOutput");
+        return true;
+    }
+    else if (name == "DeltaRefreshFrames") {
+        SetDeltaRefreshFrames(event.GetValue().GetLong());
+        outputModelManager->AddASAPWork(OutputModelManager::WORK_NETWORK_CHANGE, "ControllerEthernet::HandlePropertyEvent::DeltaRefreshFrames");
+        return true;
+    }
 
     return false;
 }
@@ -46,6 +46,7 @@ class ZCPPOutput : public IPOutput
  
     void DeserialiseProtocols(const std::string& protocols);
     std::string SerialiseProtocols();
+    void SendData(long start, long size, bool first, bool last);
     #pragma endregion
 
 public:
@@ -118,9 +118,9 @@ class EffectLayer
 
         void CleanupAfterRender();
         void NumberEffects();
+        void SortEffects();
     protected:
     private:
-        void SortEffects();
         void PlayEffect(Effect* effect);
 
         static std::atomic_int exclusive_index;
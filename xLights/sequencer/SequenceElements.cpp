@@ -12,8 +12,11 @@
 #include <wx/utils.h>
 #include <wx/tokenzr.h>
 #include <wx/filename.h>
+#include <wx/stopwatch.h>
+#include <wx/thread.h>
 
 #include <algorithm>
+#include <atomic>
 
 #include "SequenceElements.h"
 #include "TimeLine.h"
@@ -27,6 +30,7 @@
 #include "../SequenceViewManager.h"
 #include "../JukeboxPanel.h"
 #include "../TraceLog.h"
+#include "../Parallel.h"
 
 #include <log4cpp/Category.hh>
 
@@ -652,7 +656,9 @@ int SequenceElements::LoadEffects(EffectLayer *effectLayer,
         if (effect->GetName() == STR_EFFECT)
         {
             std::string effectName;
-            std::string settings;
+            std::string inlineSettings;
+            // points into effectStrings when the effect uses a shared EffectDB entry so we dont copy it per effect
+            const std::string* settings = &STR_EMPTY;
             int id = 0;
             long palette = -1;
 
@@ -672,29 +678,23 @@ int SequenceElements::LoadEffects(EffectLayer *effectLayer,
                 effectName = effect->GetAttribute(STR_NAME);
                 // ID
                 id = wxAtoi(effect->GetAttribute(STR_ID, STR_ZERO));
-                if (effect->GetAttribute(STR_REF) != STR_EMPTY) {
-                    int ref = wxAtoi(effect->GetAttribute(STR_REF));
-                    if (ref >= effectStrings.size())
+                wxString ref;
+                if (effect->GetAttribute(STR_REF, &ref) && ref != STR_EMPTY) {
+                    int r = wxAtoi(ref);
+                    if (r < 0 || r >= (int)effectStrings.size())
                     {
                         logger_base.warn("Effect string not found for effect %s between %d and %d. Settings ignored.", (const char *)effectName.c_str(), (int)startTime, (int)endTime);
-                        settings = "";
                     }
                     else
                     {
-                        settings = effectStrings[ref];
+                        // file parameters in the effect db have already been fixed
+                        settings = &effectStrings[r];
                     }
                 }
                 else {
-                    settings = effect->GetNodeContent();
-                }
-
-                if (settings.find("E_FILEPICKER_Pictures_Filename") != std::string::npos)
-                {
-                    settings = FixEffectFileParameter("E_FILEPICKER_Pictures_Filename", settings, "");
-                }
-                else if (settings.find("E_FILEPICKER_Glediator_Filename") != std::string::npos)
-                {
-                    settings = FixEffectFileParameter("E_FILEPICKER_Glediator_Filename", settings, "");
+                    inlineSettings = effect->GetNodeContent();
+                    inlineSettings = FixEffectFileParameters(inlineSettings);
+                    settings = &inlineSettings;
                 }
 
                 wxString tmp;
@@ -708,13 +708,13 @@ int SequenceElements::LoadEffects(EffectLayer *effectLayer,
                 effectName = effect->GetAttribute(STR_LABEL);
 
             }
-            std::string pal = STR_EMPTY;
-            if (palette != -1)
+            const std::string* pal = &STR_EMPTY;
+            if (palette >= 0 && palette < (long)colorPalettes.size())
             {
-                pal = colorPalettes[palette];
+                pal = &colorPalettes[palette];
             }
-            effectLayer->AddEffect(id, effectName, settings, pal,
-                startTime, endTime, EFFECT_NOT_SELECTED, bProtected);
+            effectLayer->AddEffect(id, effectName, *settings, *pal,
+                startTime, endTime, EFFECT_NOT_SELECTED, bProtected, true);
         }
         else if (effect->GetName() == STR_NODE && effectLayerNode->GetName() == STR_STRAND) {
             StrandElement *se = (StrandElement*)effectLayer->GetParentElement();
@@ -727,6 +727,66 @@ int SequenceElements::LoadEffects(EffectLayer *effectLayer,
         }
         loaded++;
     }
+    // effects are saved in time order so we only need to sort once the layer is fully loaded
+    effectLayer->SortEffects();
+    return loaded;
+}
+
+std::string SequenceElements::FixEffectFileParameters(const std::string& settings)
+{
+    if (settings.find("E_FILEPICKER_Pictures_Filename") != std::string::npos)
+    {
+        return FixEffectFileParameter("E_FILEPICKER_Pictures_Filename", settings, "").ToStdString();
+    }
+    else if (settings.find("E_FILEPICKER_Glediator_Filename") != std::string::npos)
+    {
+        return FixEffectFileParameter("E_FILEPICKER_Glediator_Filename", settings, "").ToStdString();
+    }
+    return settings;
+}
+
+int SequenceElements::LoadElementEffects(Element* element,
+    wxXmlNode* elementNode,
+    const std::vector<std::string> & effectStrings,
+    const std::vector<std::string> & colorPalettes)
+{
+    int loaded = 0;
+    const std::string type = elementNode->GetAttribute(STR_TYPE).ToStdString();
+    for (wxXmlNode* effectLayerNode = elementNode->GetChildren(); effectLayerNode != nullptr; effectLayerNode = effectLayerNode->GetNext())
+    {
+        EffectLayer* effectLayer = nullptr;
+        if (effectLayerNode->GetName() == STR_EFFECTLAYER) {
+            effectLayer = element->AddEffectLayer();
+        }
+        else if (effectLayerNode->GetName() == STR_SUBMODEL_EFFECTLAYER) {
+            wxString name = effectLayerNode->GetAttribute("name").Trim(true).Trim(false);
+            int layer = wxAtoi(effectLayerNode->GetAttribute("layer", "0"));
+            SubModelElement *se = dynamic_cast<ModelElement*>(element)->GetSubModel(name.ToStdString(), true);
+            wxASSERT(se != nullptr);
+            while (layer >= se->GetEffectLayerCount()) {
+                se->AddEffectLayer();
+            }
+            effectLayer = se->GetEffectLayer(layer);
+        }
+        else {
+            StrandElement *se = dynamic_cast<ModelElement*>(element)->GetStrand(wxAtoi(effectLayerNode->GetAttribute(STR_INDEX)), true);
+            int layer = wxAtoi(effectLayerNode->GetAttribute("layer", "0"));
+            while (layer >= se->GetEffectLayerCount()) {
+                se->AddEffectLayer();
+            }
+            effectLayer = se->GetEffectLayer(layer);
+            if (effectLayerNode->GetAttribute(STR_NAME, STR_EMPTY) != STR_EMPTY) {
+                se->SetName(effectLayerNode->GetAttribute(STR_NAME).Trim(true).Trim(false).ToStdString());
+            }
+        }
+        if (effectLayer != nullptr) {
+            loaded += LoadEffects(effectLayer, type, effectLayerNode, effectStrings, colorPalettes);
+        }
+        else
+        {
+            wxASSERT(false);
+        }
+    }
     return loaded;
 }
 
@@ -816,7 +876,8 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
                         elementNode->SetContent(FixEffectFileParameter("E_TEXTCTRL_Glediator_Filename", elementNode->GetNodeContent(), ShowDir));
                     }
 
-                    effectStrings.push_back(elementNode->GetNodeContent().ToStdString());
+                    // apply the per effect file fixups once here rather than for every effect that references this entry
+                    effectStrings.push_back(FixEffectFileParameters(elementNode->GetNodeContent().ToStdString()));
                 }
             }
         }
@@ -837,6 +898,7 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
         }
         else if (e->GetName() == "ElementEffects")
         {
+            wxStopWatch sw;
             int count = 0;
             for (wxXmlNode* elementNode = e->GetChildren(); elementNode != NULL; elementNode = elementNode->GetNext())
             {
@@ -852,7 +914,10 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
                 }
             }
 
-            int loaded = 0;
+            // Fixed timing tracks are generated here but every other element is queued so its effects
+            // can be created in parallel. Each job only touches its own element (and its submodel/strand
+            // layers) so elements never share an effect layer or a dirty range.
+            std::vector<std::pair<Element*, wxXmlNode*>> toLoad;
             for (wxXmlNode* elementNode = e->GetChildren(); elementNode != NULL; elementNode = elementNode->GetNext())
             {
                 if (elementNode->GetName() == STR_ELEMENT)
@@ -890,44 +955,7 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
                         }
                         else
                         {
-                            for (wxXmlNode* effectLayerNode = elementNode->GetChildren(); effectLayerNode != nullptr; effectLayerNode = effectLayerNode->GetNext())
-                            {
-                                EffectLayer* effectLayer = nullptr;
-                                if (effectLayerNode->GetName() == STR_EFFECTLAYER) {
-                                    effectLayer = element->AddEffectLayer();
-                                }
-                                else if (effectLayerNode->GetName() == STR_SUBMODEL_EFFECTLAYER) {
-                                    wxString name = effectLayerNode->GetAttribute("name").Trim(true).Trim(false);
-                                    int layer = wxAtoi(effectLayerNode->GetAttribute("layer", "0"));
-                                    SubModelElement *se = dynamic_cast<ModelElement*>(element)->GetSubModel(name.ToStdString(), true);
-                                    wxASSERT(se != nullptr);
-                                    while (layer >= se->GetEffectLayerCount()) {
-                                        se->AddEffectLayer();
-                                    }
-                                    effectLayer = se->GetEffectLayer(layer);
-                                }
-                                else {
-                                    StrandElement *se = dynamic_cast<ModelElement*>(element)->GetStrand(wxAtoi(effectLayerNode->GetAttribute(STR_INDEX)), true);
-                                    int layer = wxAtoi(effectLayerNode->GetAttribute("layer", "0"));
-                                    while (layer >= se->GetEffectLayerCount()) {
-                                        se->AddEffectLayer();
-                                    }
-                                    effectLayer = se->GetEffectLayer(layer);
-                                    if (effectLayerNode->GetAttribute(STR_NAME, STR_EMPTY) != STR_EMPTY) {
-                                        se->SetName(effectLayerNode->GetAttribute(STR_NAME).Trim(true).Trim(false).ToStdString());
-                                    }
-                                }
-                                if (effectLayer != nullptr) {
-                                    loaded += LoadEffects(effectLayer, elementNode->GetAttribute(STR_TYPE).ToStdString(), effectLayerNode, effectStrings, colorPalettes);
-                                    if (count) {
-                                        GetXLightsFrame()->SetStatusText(wxString::Format("Effects Loaded: %i%%.", loaded * 100 / count));
-                                    }
-                                }
-                                else
-                                {
-                                    wxASSERT(false);
-                                }
-                            }
+                            toLoad.push_back({ element, elementNode });
                         }
                     }
                     else
@@ -936,6 +964,29 @@ bool SequenceElements::LoadSequencerFile(xLightsXmlFile& xml_file, const wxStrin
                     }
                 }
             }
+            long queueTime = sw.Time();
+
+            std::atomic_int loaded(0);
+            std::atomic_int elementsLoaded(0);
+            int lastPercent = -1;
+            parallel_for(0, toLoad.size(), [&toLoad, &effectStrings, &colorPalettes, &loaded, &elementsLoaded, &lastPercent, count, this](int i) {
+                loaded += LoadElementEffects(toLoad[i].first, toLoad[i].second, effectStrings, colorPalettes);
+                elementsLoaded++;
+                // the calling thread loads elements too ... each time it finishes one it reports everything completed so far
+                // as the worker threads cannot touch the status bar
+                if (count && wxThread::IsMain()) {
+                    int percent = (int)loaded * 100 / count;
+                    if (percent != lastPercent) {
+                        lastPercent = percent;
+                        GetXLightsFrame()->SetStatusText(wxString::Format("Effects Loaded: %i%% (%d of %d elements).", percent, (int)elementsLoaded, (int)toLoad.size()));
+                    }
+                }
+            });
+            if (count) {
+                GetXLightsFrame()->SetStatusText(wxString::Format("Effects Loaded: %i%%.", (int)loaded * 100 / count));
+            }
+            logger_base.debug("Loaded %d effects on %d elements (%d shared settings, %d palettes) in %ldms, element setup %ldms.",
+                (int)loaded, (int)toLoad.size(), (int)effectStrings.size(), (int)colorPalettes.size(), sw.Time(), queueTime);
         }
         TraceLog::PopTraceContext();
     }
@@ -17,6 +17,7 @@
 #include <set>
 #include <string>
 #include <mutex>
+#include <atomic>
 #include "wx/xml/xml.h"
 #include "wx/filename.h"
 #include "UndoManager.h"
@@ -205,6 +206,11 @@ private:
         wxXmlNode *effectLayerNode,
         const std::vector<std::string> & effectStrings,
         const std::vector<std::string> & colorPalettes);
+    int LoadElementEffects(Element* element,
+        wxXmlNode* elementNode,
+        const std::vector<std::string> & effectStrings,
+        const std::vector<std::string> & colorPalettes);
+    static std::string FixEffectFileParameters(const std::string& settings);
     static bool SortElementsByIndex(const Element *element1, const Element *element2)
     {
         return (element1->GetIndex() < element2->GetIndex());
@@ -243,7 +249,7 @@ private:
 
     // mFirstVisibleModelRow=0 is first model row not the row in Row_Information struct.
     int mFirstVisibleModelRow;
-    unsigned int mChangeCount;
+    std::atomic_uint mChangeCount;
     unsigned int mMasterViewChangeCount;
     UndoManager undo_mgr;
 
@@ -840,6 +840,7 @@ void xLightsFrame::Scrub(wxCommandEvent& event)
 
     if (ms > CurrentSeqXmlFile->GetSequenceDurationMS()) ms = CurrentSeqXmlFile->GetSequenceDurationMS();
     if (frame >= SeqData.NumFrames()) frame = SeqData.NumFrames();
+    SequenceData::FramePin pin(SeqData, frame);
 
     // update any video diaplay
     sequenceVideoPanel->UpdateVideo(ms);
@@ -2342,6 +2343,7 @@ void xLightsFrame::TimerRgbSeq(long msec)
     }
 
     int frame = curt / SeqData.FrameTime();
+    SequenceData::FramePin pin(SeqData, frame);
     //have the frame, copy from SeqData
     if (playModel != nullptr) {
         int nn = playModel->GetNodeCount();
@@ -587,6 +587,9 @@ bool xLightsApp::OnInit()
         { wxCMD_LINE_SWITCH, "h", "help", "displays help on the command line parameters", wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
         { wxCMD_LINE_SWITCH, "d", "debug", "enable debug mode"},
         { wxCMD_LINE_SWITCH, "r", "render", "render files and exit"},
+        { wxCMD_LINE_OPTION, "", "report", "with -r write a per sequence render timing csv to this file" },
+        { wxCMD_LINE_OPTION, "", "processes", "with -r render this many sequences at once, each in its own xLights process", wxCMD_LINE_VAL_NUMBER },
+        { wxCMD_LINE_SWITCH, "", "verifyrender", "render models that are split into frame chunks again in order and log any frames that differ" },
         { wxCMD_LINE_OPTION, "m", "media", "specify media directory"},
         { wxCMD_LINE_OPTION, "s", "show", "specify show directory" },
         { wxCMD_LINE_OPTION, "g", "opengl", "specify OpenGL version" },
@@ -744,9 +747,24 @@ bool xLightsApp::OnInit()
     if (parser.Found("r")) {
         logger_base.info("-r: Render mode is ON");
         topFrame->_renderMode = true;
+        wxString report;
+        if (parser.Found("report", &report)) {
+            logger_base.info("--report: Render report will be written to %s.", (const char *)report.c_str());
+            topFrame->_renderReportFile = report;
+        }
+        long processes = 1;
+        if (parser.Found("processes", &processes) && processes > 1) {
+            logger_base.info("--processes: Rendering up to %ld sequences at once.", processes);
+            topFrame->StartBatchRenderProcesses(sequenceFiles, (int)processes, showDir, mediaDir);
+        }
         topFrame->CallAfter(&xLightsFrame::OpenRenderAndSaveSequences, sequenceFiles, true);
     }
 
+    if (parser.Found("verifyrender")) {
+        logger_base.info("--verifyrender: Chunked renders will be checked against an in order render");
+        topFrame->_verifyChunkedRender = true;
+    }
+
     if (parser.Found("o"))
     {
         logger_base.info("-o: Turning on output to lights");
@@ -782,6 +800,10 @@ bool xLightsApp::ProcessIdle() {
     uint64_t now = wxGetLocalTimeMillis().GetValue();
     if (now > _nextIdleTime) {
         _nextIdleTime = now + 100;
+        // nothing on the UI thread is holding on to frame data while it is idle
+        if (__frame != nullptr) {
+            __frame->SeqData.ReleaseThreadPins();
+        }
         return wxApp::ProcessIdle();
     }
     return false;
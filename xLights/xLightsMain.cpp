@@ -1309,6 +1309,12 @@ xLightsFrame::xLightsFrame(wxWindow* parent, wxWindowID id) : mSequenceElements(
 
     config->Read("xLightsFSEQVersion", &_fseqVersion, 2);
 
+    // sequences with more frame data than this are kept in compressed pages, 0 keeps everything uncompressed
+    int pagedSequenceDataMB = 0;
+    config->Read("xLightsPagedSequenceDataMB", &pagedSequenceDataMB, 0);
+    SequenceData::SetPagedMemoryLimit((size_t)pagedSequenceDataMB * 1024 * 1024);
+    logger_base.debug("Paged sequence data limit: %dMB.", pagedSequenceDataMB);
+
     config->Read("xLightsPlayVolume", &playVolume, 100);
     MenuItem_LoudVol->Check(playVolume == 100);
     MenuItem_MedVol->Check(playVolume == 66);
@@ -5123,31 +5129,13 @@ void xLightsFrame::CheckSequence(bool display)
     LogAndWrite(f, "Overlapping model channels");
 
     // Check for overlapping channels in models
-    for (auto it = std::begin(AllModels); it != std::end(AllModels); ++it)
+    for (const auto& it : AllModels.GetOverlappingModels())
     {
-        if (it->second->GetDisplayAs() != "ModelGroup")
-        {
-            auto m1start = it->second->GetFirstChannel() + 1;
-            auto m1end = it->second->GetLastChannel() + 1;
-
-            for (auto it2 = std::next(it); it2 != std::end(AllModels); ++it2)
-            {
-                if (it2->second->GetDisplayAs() != "ModelGroup")
-                {
-                    auto m2start = it2->second->GetFirstChannel() + 1;
-                    auto m2end = it2->second->GetLastChannel() + 1;
-
-                    if (m2start <= m1end && m2end >= m1start)
-                    {
-                        wxString msg = wxString::Format("    WARN: Probable model overlap '%s' (%d-%d) and '%s' (%d-%d).",
-                            it->first, m1start, m1end,
-                            it2->first, m2start, m2end);
-                        LogAndWrite(f, msg.ToStdString());
-                        warncount++;
-                    }
-                }
-            }
-        }
+        wxString msg = wxString::Format("    WARN: Probable model overlap '%s' (%d-%d) and '%s' (%d-%d).",
+            it.first->GetName(), it.first->GetFirstChannel() + 1, it.first->GetLastChannel() + 1,
+            it.second->GetName(), it.second->GetFirstChannel() + 1, it.second->GetLastChannel() + 1);
+        LogAndWrite(f, msg.ToStdString());
+        warncount++;
     }
     if (errcount + warncount == errcountsave + warncountsave)
     {
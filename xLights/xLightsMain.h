@@ -1171,6 +1171,8 @@ public:
     bool UnsavedRgbEffectsChanges;
     unsigned int modelsChangeCount;
     bool _renderMode;
+    wxString _renderReportFile;
+    bool _verifyChunkedRender = false;
 
     void SuspendAutoSave(bool dosuspend) { _suspendAutoSave = dosuspend; }
     void ClearLastPeriod();
@@ -1181,6 +1183,8 @@ public:
     void ReadXlightsFile(const wxString& FileName, wxString *mediaFilename = nullptr);
     void ReadFalconFile(const wxString& FileName, ConvertDialog* convertdlg);
     void WriteFalconPiFile(const wxString& filename); //  Falcon Pi Player *.pseq
+    void WriteFalconPiFile(const wxString& filename, SequenceData& data, wxString& media);
+    void BatchFseqWriteDone(size_t statIndex, size_t bytes, long writeMS);
     OutputManager* GetOutputManager() { return &_outputManager; };
     OutputModelManager* GetOutputModelManager() { return&_outputModelManager; }
 
@@ -1282,6 +1286,30 @@ protected:
     void BackupDirectory(wxString sourceDir, wxString targetDirName, wxString lastCreatedDirectory, bool forceallfiles, std::string& errors);
     void CreateMissingDirectories(wxString targetDirName, wxString lastCreatedDirectory, std::string& errors);
     void OpenRenderAndSaveSequences(const wxArrayString &filenames, bool exitOnDone);
+    void FinishBatchRender();
+    void SaveBatchRenderedSequence(size_t statIndex);
+    void WaitForBatchFseqWrites(size_t bytesNeeded, size_t budget);
+    void StartBatchRenderProcesses(wxArrayString& fileNames, int processes, const wxString& showDir, const wxString& mediaDir);
+    void WaitForBatchRenderProcesses(bool cancel);
+    void BatchRenderProcessEnded(int pid, int status);
+
+    // per sequence timings for the batch render report
+    struct BatchRenderStat {
+        wxString sequence;
+        unsigned int frames = 0;
+        unsigned int channels = 0;
+        long openMS = 0;
+        long renderMS = 0;
+        long writeMS = 0;
+        bool backgroundWrite = false;
+    };
+    std::vector<BatchRenderStat> _batchRenderStats;
+    std::mutex _batchWriteLock;
+    std::condition_variable _batchWriteSignal;
+    size_t _batchWriteBytes = 0;
+    int _batchWritesPending = 0;
+    std::list<long> _batchRenderProcesses; // other xLights processes rendering part of the batch
+    wxArrayString _batchRenderProcessReports;
     void AddAllModelsToSequence();
     void ShowPreviewTime(long ElapsedMSec);
     void PreviewOutput(int period);
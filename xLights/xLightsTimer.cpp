@@ -12,6 +12,7 @@
 #include <wx/thread.h>
 #include <log4cpp/Category.hh>
 #include <mutex>
+#include <chrono>
 
 #ifndef __WXOSX__
 #define USE_THREADED_TIMER
@@ -54,7 +55,7 @@ private:
     // released. Once the timer thread gets it it immediately releases it.
     std::mutex _suspendLock;
 
-    void DoSleep(int millis);
+    void DoSleepUntil(std::chrono::steady_clock::time_point deadline);
     virtual ExitCode Entry() override;
 };
 
@@ -304,16 +305,18 @@ void xlTimerThread::Stop()
     logger_timer.debug("    Stop took %ldms", sw.Time());
 }
 
-void xlTimerThread::DoSleep(int millis)
+void xlTimerThread::DoSleepUntil(std::chrono::steady_clock::time_point deadline)
 {
     static log4cpp::Category &logger_timer = log4cpp::Category::getInstance(std::string("log_timer"));
+    int millis = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
     if (millis > 5000)
     {
         logger_timer.debug("THREAD: DoSleep(%d)", millis);
     }
 
-    // try to grab the lock but time out after the desired number of milliseconds
-    if (_waiter.try_lock_for(std::chrono::milliseconds(millis)))
+    // try to grab the lock but time out at the deadline. Sleeping to an absolute time rather than
+    // for an interval means time spent handling the last tick does not push the next one back
+    if (_waiter.try_lock_until(deadline))
     {
         if (millis > 5000)
         {
@@ -341,7 +344,7 @@ wxThread::ExitCode xlTimerThread::Entry()
     bool oneshot = _oneshot;
     int interval = _interval;
     int fudgefactor = _fudgefactor;
-    long long last = wxGetLocalTimeMillis().GetValue();
+    auto deadline = std::chrono::steady_clock::now();
 
     while (!_stop)
     {
@@ -375,7 +378,7 @@ wxThread::ExitCode xlTimerThread::Entry()
             }
 
             logger_timer.debug("THREAD: Timer %s thread unsuspended.", (const char *)_name.c_str());
-            last = wxGetLocalTimeMillis().GetValue();
+            deadline = std::chrono::steady_clock::now();
         }
 
         oneshot = _oneshot;
@@ -383,19 +386,23 @@ wxThread::ExitCode xlTimerThread::Entry()
 
         if (!_stop)
         {
-            long long now = wxGetLocalTimeMillis().GetValue();
-            long long toSleep = last + interval + fudgefactor - now;
-            //if (log)
-            //{
-            //    logger_base.debug("Timer sleeping for %ldms", (std::max)(1, (int)toSleep));
-            //}
-            DoSleep((std::max)(1, (int)toSleep));
-
-            last = wxGetLocalTimeMillis().GetValue();
+            // each tick is due one interval after the previous one was due, but if we have fallen
+            // more than a whole interval behind start again from now rather than firing a burst
+            auto step = std::chrono::milliseconds((std::max)(1, interval + fudgefactor));
+            deadline += step;
+            auto now = std::chrono::steady_clock::now();
+            if (deadline + step < now)
+            {
+                deadline = now;
+            }
+            DoSleepUntil(deadline);
+
             bool suspend = _suspend;
             fudgefactor = _fudgefactor;
             if (!_stop && !suspend)
             {
+                long long late = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - deadline).count();
+                _timer->SetScheduledFireMS(wxGetLocalTimeMillis().GetValue() - (std::max)(0LL, late));
                 logger_timer.debug("THREAD: Timer %s fired.", (const char *)_name.c_str());
                 _timer->Notify();
             }
@@ -33,6 +33,7 @@ class xLightsTimer :
     xLightsTimerCallback* _timerCallback;
     std::atomic<bool> _suspend;
     std::atomic<bool> _log;
+    std::atomic<long long> _scheduledFireMS{ 0 };
     std::string _name;
 
 public:
@@ -47,6 +48,11 @@ public:
     int GetInterval() const;
     void SetLog(bool log) { _log = true; }
 
+    // The wxGetLocalTimeMillis time the most recent tick was due, 0 if not known. Comparing
+    // this to the time the tick is handled gives how late it was.
+    long long GetScheduledFireMS() const { return _scheduledFireMS; }
+    void SetScheduledFireMS(long long ms) { _scheduledFireMS = ms; }
+
     // If you use this method to receive the timer notification then be sure that you dont do any UI
     // updates in the callback function as it will be called on another thread. Also if you are going
     // to delete objects used in the callback be sure to suspend the time first
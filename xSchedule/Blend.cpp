@@ -11,19 +11,41 @@
 
 #include "Blend.h"
 
-//#define SIMD
+// SSE2 is always there on x64 so the channel loops can do 16 at a time. Other platforms use the plain
+// loops which the compiler is free to vectorise itself.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD
+#endif
 
 #ifdef SIMD
-#include "emmintrin.h"
-#define ALIGNMENT (128 / 8)
+#include <emmintrin.h>
+#define SIMD_WIDTH (128 / 8)
 
-int GetMisalignedBytes(uint8_t* b1, uint8_t* b2)
+// Given 16 RGB pixels in a, b and c sets every byte of ma, mb and mc to FF where that pixel is black
+static inline void BlackPixels(__m128i a, __m128i b, __m128i c, __m128i& ma, __m128i& mb, __m128i& mc)
 {
-    int m1 = (size_t)b1 % ALIGNMENT;
-    int m2 = (size_t)b2 % ALIGNMENT;
-
-    if (m1 == m2) return m1;
-    return -1;
+    const __m128i zero = _mm_setzero_si128();
+    // 48 bytes is 16 pixels and the pixels start at these bytes in each register
+    const __m128i startA = _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1);
+    const __m128i startB = _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0);
+    const __m128i startC = _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0);
+
+    // or each byte with the two after it so the first byte of each pixel is non zero if any of its channels are
+    __m128i oa = _mm_or_si128(a, _mm_or_si128(_mm_or_si128(_mm_srli_si128(a, 1), _mm_slli_si128(b, 15)), _mm_or_si128(_mm_srli_si128(a, 2), _mm_slli_si128(b, 14))));
+    __m128i ob = _mm_or_si128(b, _mm_or_si128(_mm_or_si128(_mm_srli_si128(b, 1), _mm_slli_si128(c, 15)), _mm_or_si128(_mm_srli_si128(b, 2), _mm_slli_si128(c, 14))));
+    __m128i oc = _mm_or_si128(c, _mm_or_si128(_mm_srli_si128(c, 1), _mm_srli_si128(c, 2)));
+    oa = _mm_and_si128(oa, startA);
+    ob = _mm_and_si128(ob, startB);
+    oc = _mm_and_si128(oc, startC);
+
+    // then copy the first byte of each pixel over the other two
+    __m128i sa = _mm_or_si128(oa, _mm_or_si128(_mm_slli_si128(oa, 1), _mm_slli_si128(oa, 2)));
+    __m128i sb = _mm_or_si128(ob, _mm_or_si128(_mm_or_si128(_mm_slli_si128(ob, 1), _mm_srli_si128(oa, 15)), _mm_or_si128(_mm_slli_si128(ob, 2), _mm_srli_si128(oa, 14))));
+    __m128i sc = _mm_or_si128(oc, _mm_or_si128(_mm_or_si128(_mm_slli_si128(oc, 1), _mm_srli_si128(ob, 15)), _mm_or_si128(_mm_slli_si128(oc, 2), _mm_srli_si128(ob, 14))));
+
+    ma = _mm_cmpeq_epi8(sa, zero);
+    mb = _mm_cmpeq_epi8(sb, zero);
+    mc = _mm_cmpeq_epi8(sc, zero);
 }
 #endif
 
@@ -155,115 +177,78 @@ void Overwrite(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
     memcpy(buffer, blendBuffer, channels);
 }
 
+// The SIMD loops below use unaligned loads and stores so the buffers dont need to line up. They do as
+// many whole registers as they can and leave the rest to the plain loop.
+
 void OverwriteIfZero(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    __m128i zero = _mm_setzero_si128();
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            if (*(buffer + i) == 0x00)
-            {
-                *(buffer + i) = *(blendBuffer + i);
-            }
-        }
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-        __m128i zero = _mm_setr_epi32(0, 0, 0, 0);
-        int simd = channels / ALIGNMENT;
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
-
-            __m128i mask = _mm_cmpeq_epi8(b, zero); // sets FF where B is zero
-            __m128i newv = _mm_and_si128(mask, bb); // grab bb where B has zero
-            __m128i r = _mm_or_si128(b, newv); // merge them
-
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-        }
+        __m128i mask = _mm_cmpeq_epi8(b, zero); // sets FF where B is zero
+        __m128i newv = _mm_and_si128(mask, bb); // grab bb where B has zero
+        __m128i r = _mm_or_si128(b, newv); // merge them
 
-        // do the residual
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = misaligned + i + simd * ALIGNMENT;
-            if (*(buffer + offset) == 0)
-            {
-                *(buffer + offset) = *(blendBuffer + offset);
-            }
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
+        if (*(buffer + i) == 0x00)
         {
-            if (*(buffer + i) == 0x00)
-            {
-                *(buffer + i) = *(blendBuffer + i);
-            }
+            *(buffer + i) = *(blendBuffer + i);
         }
     }
 }
 
 void Mask(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    __m128i zero = _mm_setzero_si128();
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            if (*(blendBuffer + i) > 0)
-            {
-                *(buffer + i) = 0x00;
-            }
-        }
-
-        __m128i zero = _mm_setr_epi32(0, 0, 0, 0);
-        int simd = channels / ALIGNMENT;
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
-
-            __m128i mask = _mm_cmpeq_epi8(bb, zero); // sets FF where BB is zero
-            __m128i r = _mm_and_si128(mask, b); // and the mask
-
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-        }
+        __m128i mask = _mm_cmpeq_epi8(bb, zero); // sets FF where BB is zero
+        __m128i r = _mm_and_si128(mask, b); // and the mask
 
-        // do the residual
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = misaligned + i + simd * ALIGNMENT;
-            if (*(blendBuffer + offset) > 0)
-            {
-                *(buffer + offset) = 0x00;
-            }
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
+        if (*(blendBuffer + i) > 0)
         {
-            if (*(blendBuffer + i) > 0)
-            {
-                *(buffer + i) = 0x00;
-            }
+            *(buffer + i) = 0x00;
         }
     }
 }
 
 void MaskPixel(uint8_t* buffer, uint8_t* blendBuffer, size_t pixels)
 {
-    for (size_t i = 0; i < pixels; ++i)
+    size_t i = 0;
+#ifdef SIMD
+    for (; i + SIMD_WIDTH <= pixels; i += SIMD_WIDTH)
+    {
+        __m128i* pb = (__m128i*)(buffer + i * 3);
+        __m128i* pbb = (__m128i*)(blendBuffer + i * 3);
+        __m128i ma, mb, mc;
+        BlackPixels(_mm_loadu_si128(pbb), _mm_loadu_si128(pbb + 1), _mm_loadu_si128(pbb + 2), ma, mb, mc);
+
+        // keep the pixels where the blend pixel is black
+        _mm_storeu_si128(pb, _mm_and_si128(ma, _mm_loadu_si128(pb)));
+        _mm_storeu_si128(pb + 1, _mm_and_si128(mb, _mm_loadu_si128(pb + 1)));
+        _mm_storeu_si128(pb + 2, _mm_and_si128(mc, _mm_loadu_si128(pb + 2)));
+    }
+#endif
+    for (; i < pixels; ++i)
     {
         uint8_t* p = blendBuffer + i * 3;
         auto sum = *p + *(p + 1) + *(p + 2);
@@ -279,59 +264,47 @@ void MaskPixel(uint8_t* buffer, uint8_t* blendBuffer, size_t pixels)
 
 void Unmask(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    __m128i zero = _mm_setzero_si128();
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            if (*(blendBuffer + i) == 0)
-            {
-                *(buffer + i) = 0x00;
-            }
-        }
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-        __m128i zero = _mm_setr_epi32(0, 0, 0, 0);
-        int simd = channels / ALIGNMENT;
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
+        __m128i mask = _mm_cmpeq_epi8(bb, zero); // sets FF where BB is zero
+        __m128i r = _mm_andnot_si128(mask, b); // invert the mask and then and it
 
-            __m128i mask = _mm_cmpeq_epi8(bb, zero); // sets FF where BB is zero
-            __m128i r = _mm_andnot_si128(mask, b); // invert the mask and then and it
-
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-        }
-
-        // do the residual
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = misaligned + i + simd * ALIGNMENT;
-            if (*(blendBuffer + offset) == 0)
-            {
-                *(buffer + offset) = 0x00;
-            }
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
+        if (*(blendBuffer + i) == 0)
         {
-            if (*(blendBuffer + i) == 0)
-            {
-                *(buffer + i) = 0x00;
-            }
+            *(buffer + i) = 0x00;
         }
     }
 }
 
 void UnmaskPixel(uint8_t* buffer, uint8_t* blendBuffer, size_t pixels)
 {
-    for (size_t i = 0; i < pixels; ++i)
+    size_t i = 0;
+#ifdef SIMD
+    for (; i + SIMD_WIDTH <= pixels; i += SIMD_WIDTH)
+    {
+        __m128i* pb = (__m128i*)(buffer + i * 3);
+        __m128i* pbb = (__m128i*)(blendBuffer + i * 3);
+        __m128i ma, mb, mc;
+        BlackPixels(_mm_loadu_si128(pbb), _mm_loadu_si128(pbb + 1), _mm_loadu_si128(pbb + 2), ma, mb, mc);
+
+        // clear the pixels where the blend pixel is black
+        _mm_storeu_si128(pb, _mm_andnot_si128(ma, _mm_loadu_si128(pb)));
+        _mm_storeu_si128(pb + 1, _mm_andnot_si128(mb, _mm_loadu_si128(pb + 1)));
+        _mm_storeu_si128(pb + 2, _mm_andnot_si128(mc, _mm_loadu_si128(pb + 2)));
+    }
+#endif
+    for (; i < pixels; ++i)
     {
         uint8_t* p = blendBuffer + i * 3;
         auto sum = *p + *(p + 1) + *(p + 2);
@@ -347,132 +320,87 @@ void UnmaskPixel(uint8_t* buffer, uint8_t* blendBuffer, size_t pixels)
 
 void Average(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    __m128i one = _mm_set1_epi8(1);
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            *(buffer + i) = (uint8_t)(((int)*(buffer + i) + (int)*(blendBuffer + i)) / 2);
-        }
-
-        int simd = channels / ALIGNMENT;
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-            __m128i r = _mm_avg_epu8(b, bb);
+        // _mm_avg_epu8 rounds up so take off the carried bit to round down like the plain loop does
+        __m128i r = _mm_sub_epi8(_mm_avg_epu8(b, bb), _mm_and_si128(_mm_xor_si128(b, bb), one));
 
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-        }
-
-        // do the residual
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = i + misaligned + simd * ALIGNMENT;
-            *(buffer + offset) = (uint8_t)(((int)*(buffer + offset) + (int)*(blendBuffer + offset)) / 2);
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
-        {
-            *(buffer + i) = (uint8_t)(((int)*(buffer + i) + (int)*(blendBuffer + i)) / 2);
-        }
+        *(buffer + i) = (uint8_t)(((int)*(buffer + i) + (int)*(blendBuffer + i)) / 2);
     }
 }
 
 void Maximum(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            *(buffer + i) = std::max(*(buffer + i), *(blendBuffer + i));
-        }
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-        // do the aligned pieces using SIMD instructions ... up to 16 times faster
-        int simd = (channels - misaligned) / ALIGNMENT;
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
+        __m128i r = _mm_max_epu8(b, bb);
 
-            __m128i r = _mm_max_epu8(b, bb);
-
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-                                }
-
-        // do the residual part at the end where we dont have enough bytes to process
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = i + misaligned + simd * ALIGNMENT;
-            *(buffer + offset) = std::max(*(buffer + offset), *(blendBuffer + offset));
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
-        {
-            *(buffer + i) = std::max(*(buffer + i), *(blendBuffer + i));
-        }
+        *(buffer + i) = std::max(*(buffer + i), *(blendBuffer + i));
     }
 }
 
 void Minimum(uint8_t* buffer, uint8_t* blendBuffer, size_t channels)
 {
+    size_t i = 0;
 #ifdef SIMD
-    int misaligned = GetMisalignedBytes(buffer, blendBuffer);
-
-    if (misaligned >= 0 && (channels - misaligned) >= ALIGNMENT) // we can only use SIMD if misalignment is the same for both buffers and we have the minimum number of bytes to do
+    for (; i + SIMD_WIDTH <= channels; i += SIMD_WIDTH)
     {
-        // do the misaligned
-        for (size_t i = 0; i < misaligned; ++i)
-        {
-            *(buffer + i) = std::min(*(buffer + i), *(blendBuffer + i));
-        }
+        __m128i b = _mm_loadu_si128((__m128i*)(buffer + i));
+        __m128i bb = _mm_loadu_si128((__m128i*)(blendBuffer + i));
 
-        int simd = channels / ALIGNMENT;
-        for (size_t i = 0; i < simd; ++i)
-        {
-            size_t offset = misaligned + i * ALIGNMENT;
-            __m128i b = _mm_load_si128((__m128i*)(buffer + offset));
-            __m128i bb = _mm_load_si128((__m128i*)(blendBuffer + offset));
-
-            __m128i r = _mm_min_epu8(b, bb);
-
-            _mm_store_si128((__m128i*)(buffer + offset), r);
-        }
+        __m128i r = _mm_min_epu8(b, bb);
 
-        // do the residual
-        for (size_t i = 0; i < channels % ALIGNMENT; ++i)
-        {
-            size_t offset = i + misaligned + simd * ALIGNMENT;
-            *(buffer + offset) = std::min(*(buffer + offset), *(blendBuffer + offset));
-        }
+        _mm_storeu_si128((__m128i*)(buffer + i), r);
     }
-    else
 #endif
+    for (; i < channels; ++i)
     {
-        for (size_t i = 0; i < channels; ++i)
-        {
-            *(buffer + i) = std::min(*(buffer + i), *(blendBuffer + i));
-        }
+        *(buffer + i) = std::min(*(buffer + i), *(blendBuffer + i));
     }
 }
 
 void OverwriteIfBlack(uint8_t* buffer, uint8_t* blendBuffer, size_t pixels)
 {
-    for (size_t i = 0; i < pixels; ++i)
+    size_t i = 0;
+#ifdef SIMD
+    for (; i + SIMD_WIDTH <= pixels; i += SIMD_WIDTH)
+    {
+        __m128i* pb = (__m128i*)(buffer + i * 3);
+        __m128i* pbb = (__m128i*)(blendBuffer + i * 3);
+        __m128i a = _mm_loadu_si128(pb);
+        __m128i b = _mm_loadu_si128(pb + 1);
+        __m128i c = _mm_loadu_si128(pb + 2);
+        __m128i ma, mb, mc;
+        BlackPixels(a, b, c, ma, mb, mc);
+
+        // black pixels are all zero so we can just or in the blend pixel
+        _mm_storeu_si128(pb, _mm_or_si128(a, _mm_and_si128(ma, _mm_loadu_si128(pbb))));
+        _mm_storeu_si128(pb + 1, _mm_or_si128(b, _mm_and_si128(mb, _mm_loadu_si128(pbb + 1))));
+        _mm_storeu_si128(pb + 2, _mm_or_si128(c, _mm_and_si128(mc, _mm_loadu_si128(pbb + 2))));
+    }
+#endif
+    for (; i < pixels; ++i)
     {
         uint8_t* p = buffer + i * 3;
         auto sum = *p + *(p + 1) + *(p + 2);
@@ -22,6 +22,7 @@ ESEQFile::ESEQFile()
     _frames = 0;
     _fh = nullptr;
     _frameBuffer = nullptr;
+    _data = nullptr;
     _frame0Offset = 0;
     _ok = false;
 }
@@ -34,6 +35,7 @@ ESEQFile::ESEQFile(const std::string& filename)
     _frames = 0;
     _fh = nullptr;
     _frameBuffer = nullptr;
+    _data = nullptr;
     _frame0Offset = 0;
     _ok = true;
     Load(_filename);
@@ -60,6 +62,12 @@ void ESEQFile::Close()
         _frameBuffer = nullptr;
     }
 
+    if (_data != nullptr)
+    {
+        free(_data);
+        _data = nullptr;
+    }
+
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     logger_base.info("ESEQ file %s closed.", (const char *)_filename.c_str());
 
@@ -129,7 +137,24 @@ void ESEQFile::Load(const std::string& filename)
             wxFileName fn(_filename);
             _frames = (size_t)(fn.GetSize().ToULong() - _frame0Offset) / _channelsPerFrame;
 
-            logger_base.info("ESEQ file %s opened.", (const char *)_filename.c_str());
+            size_t dataSize = _frames * _channelsPerFrame;
+            if (dataSize > 0 && dataSize <= MAX_PRELOAD_SIZE)
+            {
+                _data = (uint8_t*)malloc(dataSize);
+                if (_data != nullptr)
+                {
+                    _fh->Seek(_frame0Offset, wxFromStart);
+                    if (_fh->Read(_data, dataSize) != (ssize_t)dataSize)
+                    {
+                        logger_base.warn("ESEQ file %s could not be preloaded ... it will be read from disk.", (const char *)_filename.c_str());
+                        free(_data);
+                        _data = nullptr;
+                    }
+                }
+            }
+
+            logger_base.info("ESEQ file %s opened. Frames %d, channels per frame %d, %s.", (const char *)_filename.c_str(),
+                (int)_frames, (int)_channelsPerFrame, _data == nullptr ? "reading from disk" : "preloaded");
         }
         else
         {
@@ -148,6 +173,12 @@ void ESEQFile::ReadData(uint8_t* buffer, size_t buffersize, size_t frame, APPLYM
 {
     if (frame >= _frames) return; // cant read past end of file
 
+    if (_data != nullptr)
+    {
+        Blend(buffer, buffersize, _data + _channelsPerFrame * frame, _modelSize, applyMethod, _offset - 1);
+        return;
+    }
+
     if (_fh->Tell() != _frame0Offset + _channelsPerFrame * frame)
     {
         // we need to seek to our frame
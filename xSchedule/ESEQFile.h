@@ -19,6 +19,9 @@
 
 class ESEQFile
 {
+    // files up to this size are read into memory when loaded so playing them does no disk io
+    static const size_t MAX_PRELOAD_SIZE = 64 * 1024 * 1024;
+
 	std::string _filename;
 	size_t _frames;
 	size_t _channelsPerFrame;
@@ -26,6 +29,7 @@ class ESEQFile
 	size_t _modelSize;
     wxFile* _fh;
     uint8_t* _frameBuffer;
+    uint8_t* _data; // all the frames when the file is small enough to hold in memory
     size_t _frame0Offset;
     bool _ok;
 
@@ -42,6 +46,7 @@ class ESEQFile
 		int GetLengthFrames() const { return _frames; }
 		void ReadData(uint8_t* buffer, size_t buffersize, size_t frame, APPLYMETHOD applyMethod);
 		bool IsOk() const { return _ok; }
+		bool IsPreloaded() const { return _data != nullptr; }
 		size_t GetChannels() const { return _channelsPerFrame; }
 		size_t GetOffset() const { return _offset; }
         void Close();
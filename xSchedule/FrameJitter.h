@@ -0,0 +1,81 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <atomic>
+#include <string>
+#include <wx/string.h>
+
+// Histogram of how late each frame timer tick was handled in 1ms buckets. Anything a
+// second or more late lands in the last bucket. It is updated from the frame timer and
+// read by the status api so it only uses atomics.
+class FrameJitter
+{
+    static const int BUCKETS = 1001;
+    std::atomic<uint32_t> _buckets[BUCKETS];
+    std::atomic<uint32_t> _count;
+    std::atomic<uint32_t> _max;
+
+public:
+    FrameJitter() { Reset(); }
+
+    void Reset()
+    {
+        for (auto& it : _buckets)
+        {
+            it = 0;
+        }
+        _count = 0;
+        _max = 0;
+    }
+
+    void Record(long long lateMS)
+    {
+        if (lateMS < 0) lateMS = 0;
+        uint32_t late = lateMS > 0xFFFFFFF ? 0xFFFFFFF : (uint32_t)lateMS;
+        _buckets[late < BUCKETS ? late : BUCKETS - 1]++;
+        _count++;
+        uint32_t max = _max;
+        while (late > max && !_max.compare_exchange_weak(max, late))
+        {
+        }
+    }
+
+    uint32_t GetCount() const { return _count; }
+    uint32_t GetMax() const { return _max; }
+
+    // the lateness in ms that pct percent of the ticks were at or under
+    uint32_t GetPercentile(int pct) const
+    {
+        uint64_t count = _count;
+        if (count == 0) return 0;
+        uint64_t target = (count * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++)
+        {
+            seen += _buckets[i];
+            if (seen >= target) return i;
+        }
+        return BUCKETS - 1;
+    }
+
+    std::string GetJSON() const
+    {
+        return wxString::Format("\"framejitter\":{\"count\":\"%u\",\"p50\":\"%u\",\"p99\":\"%u\",\"max\":\"%u\"}",
+            GetCount(), GetPercentile(50), GetPercentile(99), GetMax()).ToStdString();
+    }
+
+    std::string GetSummary() const
+    {
+        return wxString::Format("%u frames late by p50 %ums, p99 %ums, max %ums",
+            GetCount(), GetPercentile(50), GetPercentile(99), GetMax()).ToStdString();
+    }
+};
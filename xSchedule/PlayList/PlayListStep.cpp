@@ -481,6 +481,7 @@ bool PlayListStep::Frame(uint8_t* buffer, size_t size, bool outputframe)
     ReentrancyCounter rec(_reentrancyCounter);
 
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    static log4cpp::Category &logger_frame = log4cpp::Category::getInstance(std::string("log_frame"));
 
     size_t msPerFrame = 1000;
     PlayListItem* timesource = GetTimeSource(msPerFrame);
@@ -509,15 +510,31 @@ bool PlayListStep::Frame(uint8_t* buffer, size_t size, bool outputframe)
     //}
 
     wxStopWatch sw;
+    PlayListItem* slowest = nullptr;
+    long slowestMS = -1;
     // we do this backwards to ensure the right render order
     for (auto it = _items.rbegin(); it != _items.rend(); ++it)
     {
+        long itemStart = sw.Time();
         (*it)->Frame(buffer, size, frameMS, msPerFrame, outputframe);
+        long itemMS = sw.Time() - itemStart;
+
+        // time each item so a slow overlay shows up in the frame log
+        if (itemMS > slowestMS)
+        {
+            slowestMS = itemMS;
+            slowest = *it;
+        }
+        if (logger_frame.isDebugEnabled())
+        {
+            logger_frame.debug("    Step %s item %s %s frame %ld took %ldms.", (const char *)GetNameNoTime().c_str(), (const char *)(*it)->GetTitle().c_str(), (const char *)(*it)->GetNameNoTime().c_str(), (long)frameMS, itemMS);
+        }
     }
 
     if (sw.Time() > (float)msPerFrame * 0.8)
     {
-        logger_base.warn("Step %s frame %ld took longer than 80%% frame time to output: %ldms.", (const char *)GetNameNoTime().c_str(), (long)frameMS, (long)sw.Time());
+        logger_base.warn("Step %s frame %ld took longer than 80%% frame time to output: %ldms. Slowest item %s %ldms.", (const char *)GetNameNoTime().c_str(), (long)frameMS, (long)sw.Time(),
+            slowest == nullptr ? "" : (const char *)slowest->GetNameNoTime().c_str(), slowestMS);
     }
 
     //logger_base.debug("    Step %s frame %ld done in %ld.", (const char *)GetNameNoTime().c_str(), (long)frameMS, (long)sw.Time());
@@ -784,7 +801,35 @@ bool PlayListStep::IsRunningFSEQ(const std::string& fseqFile)
     return (fn.GetFullName().Lower() == wxString(fseqFile).Lower());
 }
 
-void PlayListStep::SetSyncPosition(size_t ms, size_t acceptableJitter, bool force)
+// Remote mode sync through the sync clock which slews the frame timer and only seeks when we are well out
+template <typename T>
+static void SyncItemToClock(SyncClock& clock, T* pli, size_t ms, size_t acceptableJitter)
+{
+    static log4cpp::Category &logger_sync = log4cpp::Category::getInstance(std::string("log_sync"));
+
+    // when audio controls the timing changing the frame timer wont move us so we can only seek
+    bool canSlew = pli->GetAudioManager() == nullptr;
+    long position = pli->GetPositionMS();
+
+    switch (clock.Update((long)ms, position, pli->GetFrameMS(), (int)acceptableJitter, canSlew))
+    {
+    case SyncClock::ACTION::SEEK:
+        logger_sync.debug("Sync: Position was %d:%ld - should be %d:%ld. Seek.", pli->GetCurrentFrame(), position, (int)(ms / pli->GetFrameMS()), (long)ms);
+        pli->SetPosition(ms / pli->GetFrameMS(), ms);
+        if (xScheduleFrame::GetScheduleManager() != nullptr)
+            xScheduleFrame::GetScheduleManager()->SetTimerAdjustment(0);
+        break;
+    case SyncClock::ACTION::SLEW:
+        logger_sync.debug("Sync: Offset %.1fms Jitter %.1fms -> Adjustment to frame time %d.", clock.GetOffset(), clock.GetJitter(), clock.GetAdjustment());
+        if (xScheduleFrame::GetScheduleManager() != nullptr)
+            xScheduleFrame::GetScheduleManager()->SetTimerAdjustment(clock.GetAdjustment());
+        break;
+    case SyncClock::ACTION::NONE:
+        break;
+    }
+}
+
+void PlayListStep::SetSyncPosition(size_t ms, size_t acceptableJitter, bool force, SyncClock* clock)
 {
     static log4cpp::Category &logger_sync = log4cpp::Category::getInstance(std::string("log_sync"));
     logger_sync.debug("SetSyncPosition: MS %ld Force %s.", (long)ms, force ? "true" : "false");
@@ -798,6 +843,11 @@ void PlayListStep::SetSyncPosition(size_t ms, size_t acceptableJitter, bool forc
             if ((*it)->GetTitle() == "FSEQ")
             {
                 PlayListItemFSEQ* pli = (PlayListItemFSEQ*)(*it);
+                if (fseq == pli->GetFSEQFileName() && clock != nullptr)
+                {
+                    SyncItemToClock(*clock, pli, ms, acceptableJitter);
+                    break;
+                }
                 if (fseq == pli->GetFSEQFileName())
                 {
                     // wxASSERT(abs((long)frame * (long)pli->GetFrameMS() - (long)ms) < pli->GetFrameMS());
@@ -873,6 +923,11 @@ void PlayListStep::SetSyncPosition(size_t ms, size_t acceptableJitter, bool forc
             else if ((*it)->GetTitle() == "FSEQ & Video")
             {
                 PlayListItemFSEQVideo* pli = (PlayListItemFSEQVideo*)(*it);
+                if (fseq == pli->GetFSEQFileName() && clock != nullptr)
+                {
+                    SyncItemToClock(*clock, pli, ms, acceptableJitter);
+                    break;
+                }
                 if (fseq == pli->GetFSEQFileName())
                 {
                     //wxASSERT(abs((long)frame * (long)pli->GetFrameMS() - (long)ms) < pli->GetFrameMS());
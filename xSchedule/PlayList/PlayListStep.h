@@ -22,6 +22,7 @@ class PlayListItem;
 class wxWindow;
 class AudioManager;
 class PlayList;
+class SyncClock;
 
 class PlayListStep
 {
@@ -102,7 +103,7 @@ public:
     size_t GetFrameMS();
     void AdjustTime(wxTimeSpan by);
     bool IsRunningFSEQ(const std::string& fseqFile);
-    void SetSyncPosition(size_t ms, size_t acceptableJitter, bool force = false);
+    void SetSyncPosition(size_t ms, size_t acceptableJitter, bool force = false, SyncClock* clock = nullptr);
     PlayListItem* FindRunProcessNamed(const std::string& item);
     AudioManager* GetAudioManager();
     #pragma endregion Getters and Setters
@@ -14,8 +14,11 @@
 #include <log4cpp/Category.hh>
 #include "City.h"
 
+#include <algorithm>
+
 int __scheduleid = 0;
 std::string Schedule::__city = "Sydney";
+int Schedule::__cityChangeCount = 0;
 
 Schedule::Schedule(wxXmlNode* node)
 {
@@ -108,6 +111,7 @@ wxTimeSpan Schedule::GetTimeSinceStartTime() const
 void Schedule::Load(wxXmlNode* node)
 {
     _changeCount = 0;
+    _activeCacheChangeCount = -1;
     _lastSavedChangeCount = 0;
 
     _name = node->GetAttribute("Name", "<unnamed>");
@@ -297,14 +301,20 @@ bool Schedule::IsOnDOW(const std::string& dow) const
 
 void Schedule::SetDOW(bool mon, bool tue, bool wed, bool thu, bool fri, bool sat, bool sun)
 {
-    _dow = "";
-    if (mon) _dow += "Mon";
-    if (tue) _dow += "Tue";
-    if (wed) _dow += "Wed";
-    if (thu) _dow += "Thu";
-    if (fri) _dow += "Fri";
-    if (sat) _dow += "Sat";
-    if (sun) _dow += "Sun";
+    std::string dow = "";
+    if (mon) dow += "Mon";
+    if (tue) dow += "Tue";
+    if (wed) dow += "Wed";
+    if (thu) dow += "Thu";
+    if (fri) dow += "Fri";
+    if (sat) dow += "Sat";
+    if (sun) dow += "Sun";
+
+    if (_dow != dow)
+    {
+        _dow = dow;
+        _changeCount++;
+    }
 }
 
 void Schedule::SetTime(wxDateTime& toset, std::string city, wxDateTime time, std::string timeString, int offset) const
@@ -400,6 +410,30 @@ void Schedule::Test()
     wxASSERT(s.CheckActiveAt(wxDateTime(26, (wxDateTime::Month)11, 2019, 19, 0)));
     wxASSERT(!s.CheckActiveAt(wxDateTime(2, (wxDateTime::Month)0, 2018, 19, 0)));
 
+    // the cached answer must match checking every time through a whole year including both daylight
+    // saving changes and sunrise/sunset times that move every day
+    s._enabled = true;
+    s._startDate = wxDateTime(1, (wxDateTime::Month)0, 2018);
+    s._endDate = wxDateTime(31, (wxDateTime::Month)11, 2018);
+    s._dow = "MonTueWedThuFriSat";
+    s._everyYear = false;
+    s._nthDay = 1;
+    s._nthDayOffset = 0;
+    const char* times[][2] = { { "17:45", "23:15" }, { "22:00", "02:30" }, { "sunset", "sunrise" }, { "sunrise", "18:00" }, { "06:00", "06:00" } };
+    for (const auto& it : times)
+    {
+        s.SetStartTime(it[0]);
+        s.SetEndTime(it[1]);
+        Schedule brute(s);
+        int differences = 0;
+        for (wxDateTime t = wxDateTime(30, (wxDateTime::Month)11, 2017, 12, 0, 7); t < wxDateTime(2, (wxDateTime::Month)0, 2019); t += wxTimeSpan(0, 0, 30))
+        {
+            if (s.CheckActiveCached(t) != brute.CheckActiveAt(t)) differences++;
+        }
+        wxASSERT(differences == 0);
+        logger_base.warn("    %s-%s cached schedule differences %d.", it[0], it[1], differences);
+    }
+
     logger_base.warn("    Schedule tests done.");
 }
 
@@ -410,7 +444,51 @@ bool Schedule::IsOkDOW(const wxDateTime& date)
 
 bool Schedule::CheckActive()
 {
-    return CheckActiveAt(wxDateTime::Now());
+    return CheckActiveCached(wxDateTime::Now());
+}
+
+bool Schedule::CheckActiveCached(const wxDateTime& now)
+{
+    if (_activeCacheChangeCount == _changeCount && _activeCacheCityChangeCount == __cityChangeCount &&
+        now >= _activeCacheFrom && now < _activeCacheUntil)
+    {
+        // GetNextTriggerTime checks other times so put back the answer for now
+        _active = _activeCache;
+        return _active;
+    }
+
+    _activeCache = CheckActiveAt(now);
+    _activeCacheFrom = now;
+    _activeCacheUntil = GetNextActiveCheck(now);
+    _activeCacheChangeCount = _changeCount;
+    _activeCacheCityChangeCount = __cityChangeCount;
+    return _activeCache;
+}
+
+// CheckActiveAt only compares the date and times on the start and end minute so its answer cannot
+// change until midnight or the next time the clock reaches the start or end minute. Any hour is
+// treated as a candidate because daylight saving can move the start and end by an hour.
+wxDateTime Schedule::GetNextActiveCheck(const wxDateTime& now) const
+{
+    wxDateTime s = now;
+    wxDateTime e = now;
+    SetTime(s, __city, _startTime, _startTimeString, _onOffsetMins);
+    SetTime(e, __city, _endTime, _endTimeString, _offOffsetMins);
+
+    int toStart = (s.GetMinute() - now.GetMinute() + 60) % 60;
+    int toEnd = (e.GetMinute() - now.GetMinute() + 60) % 60;
+
+    // during the start or end minute check every time
+    if (toStart == 0 || toEnd == 0) return now;
+
+    wxDateTime next = now;
+    next.SetSecond(0);
+    next.SetMillisecond(0);
+    next += wxTimeSpan(0, std::min(toStart, toEnd));
+
+    wxDateTime midnight = now.GetDateOnly() + wxDateSpan::Day();
+    if (midnight < next) return midnight;
+    return next;
 }
 
 bool Schedule::ShouldFire() const
@@ -879,6 +957,7 @@ std::string Schedule::GetNextTriggerTime()
 void Schedule::AddMinsToEndTime(int mins)
 {
     _endTime += wxTimeSpan(0, mins);
+    _activeCacheChangeCount = -1;
 }
 
 std::string Schedule::GetNextEndTime()
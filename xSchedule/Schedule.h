@@ -45,16 +45,27 @@ class Schedule
     int _offOffsetMins = 0;
     bool _hardStop = false;
 
+    // CheckActive is called for every schedule twice a second so the answer is kept until the next
+    // time it could change or the schedule is edited
+    static int __cityChangeCount;
+    bool _activeCache = false;
+    int _activeCacheChangeCount = -1;
+    int _activeCacheCityChangeCount = -1;
+    wxDateTime _activeCacheFrom;
+    wxDateTime _activeCacheUntil;
+
     void SetTime(wxDateTime& toset, std::string city, wxDateTime time, std::string timeString, int offset) const;
     bool IsOkDOW(const wxDateTime& date);
     bool IsOkNthDay(const wxDateTime& date);
     bool CheckActiveAt(const wxDateTime& now);
+    bool CheckActiveCached(const wxDateTime& now);
+    wxDateTime GetNextActiveCheck(const wxDateTime& now) const;
 
     public:
 
         static void Test();
 
-        static void SetCity(std::string city) { __city = city; }
+        static void SetCity(std::string city) { if (__city != city) { __city = city; __cityChangeCount++; } }
         wxUint32 GetId() const { return _id; }
         bool operator<(const Schedule& rhs) const { return _priority < rhs._priority; }
         bool operator==(const Schedule& rhs) const { return _id == rhs._id; }
@@ -48,9 +48,134 @@
 #include "../xLights/outputs/Controller.h"
 
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
 
 #include <log4cpp/Category.hh>
 
+// Sends finished frames to the lights on its own thread so slow network and serial
+// writes do not hold up the UI thread which builds the frames. Only the latest frame
+// is kept, if the outputs fall behind the older frame is dropped rather than queued.
+class FrameOutputThread : public wxThread
+{
+    OutputManager* _outputManager;
+    std::mutex _lock;
+    std::condition_variable _signal;
+    std::vector<uint8_t> _pending;
+    std::vector<uint8_t> _sending;
+    long _pendingMS = 0;
+    bool _pendingAllOff = false;
+    bool _hasPending = false;
+    bool _busy = false;
+    bool _stop = false;
+    bool _threaded = false;
+    uint32_t _dropped = 0;
+
+    void Output(long msec, uint8_t* buffer, size_t channels, bool allOff)
+    {
+        _outputManager->StartFrame(msec);
+        if (allOff)
+        {
+            _outputManager->AllOff(false);
+        }
+        _outputManager->SetManyChannels(0, buffer, channels);
+        _outputManager->EndFrame();
+    }
+
+public:
+
+    FrameOutputThread(OutputManager* outputManager) : wxThread(wxTHREAD_JOINABLE)
+    {
+        static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+
+        _outputManager = outputManager;
+        _threaded = Run() == wxTHREAD_NO_ERROR;
+        if (!_threaded)
+        {
+            logger_base.error("Failed to start frame output thread. Frames will be sent from the frame timer.");
+        }
+    }
+
+    virtual ~FrameOutputThread()
+    {
+        Stop();
+    }
+
+    void Stop()
+    {
+        {
+            std::unique_lock<std::mutex> locker(_lock);
+            if (_stop || !_threaded) return;
+            _signal.wait(locker, [this] { return !_hasPending && !_busy; });
+            _stop = true;
+            _signal.notify_all();
+        }
+        Wait();
+    }
+
+    // copies the frame and queues it to be sent. allOff turns the outputs off before the
+    // frame is set so they resend everything
+    void Send(long msec, const uint8_t* buffer, size_t channels, bool allOff)
+    {
+        if (!_threaded)
+        {
+            _sending.assign(buffer, buffer + channels);
+            Output(msec, _sending.data(), _sending.size(), allOff);
+            return;
+        }
+
+        std::unique_lock<std::mutex> locker(_lock);
+        if (_hasPending)
+        {
+            _dropped++;
+            allOff |= _pendingAllOff;
+        }
+        _pending.assign(buffer, buffer + channels);
+        _pendingMS = msec;
+        _pendingAllOff = allOff;
+        _hasPending = true;
+        _signal.notify_all();
+    }
+
+    // waits until everything queued has been sent so the output manager can be used directly
+    void Flush()
+    {
+        std::unique_lock<std::mutex> locker(_lock);
+        _signal.wait(locker, [this] { return !_hasPending && !_busy; });
+    }
+
+    uint32_t GetDroppedFrames()
+    {
+        std::unique_lock<std::mutex> locker(_lock);
+        return _dropped;
+    }
+
+    virtual void* Entry() override
+    {
+        std::unique_lock<std::mutex> locker(_lock);
+        while (true)
+        {
+            _signal.wait(locker, [this] { return _stop || _hasPending; });
+            if (_stop) break;
+
+            std::swap(_pending, _sending);
+            long msec = _pendingMS;
+            bool allOff = _pendingAllOff;
+            _hasPending = false;
+            _busy = true;
+            locker.unlock();
+
+            Output(msec, _sending.data(), _sending.size(), allOff);
+
+            locker.lock();
+            _busy = false;
+            _signal.notify_all();
+        }
+        return nullptr;
+    }
+};
+
 ScheduleManager::ScheduleManager(xScheduleFrame* frame, const std::string& showDir)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
@@ -62,6 +187,7 @@ ScheduleManager::ScheduleManager(xScheduleFrame* frame, const std::string& showD
     _syncManager = std::make_unique<SyncManager>(this);
     _testMode = false;
     _mainThread = wxThread::GetCurrentId();
+    _headless = frame != nullptr && frame->IsHeadless();
     _listenerManager = nullptr;
     _pinger = nullptr;
     _webRequestToggle = false;
@@ -85,6 +211,7 @@ ScheduleManager::ScheduleManager(xScheduleFrame* frame, const std::string& showD
     _timerAdjustment = 0;
     _lastXyzzyCommand = wxDateTime::Now();
     _outputManager = new OutputManager();
+    _frameOutput = new FrameOutputThread(_outputManager);
 
     _mode = (int)SYNCMODE::STANDALONE;
     _remoteMode = REMOTEMODE::DISABLED;
@@ -192,6 +319,7 @@ ScheduleManager::ScheduleManager(xScheduleFrame* frame, const std::string& showD
                 logger_base.warn("Warning: Lights output is already open in another process. This will cause issues.", "WARNING", 4 | wxCENTRE, frame);
             }
             DisableRemoteOutputs();
+            _frameOutput->Flush();
             _outputManager->StartOutput();
 #ifdef __WXMSW__
             ::SetPriorityClass(::GetCurrentProcess(), ABOVE_NORMAL_PRIORITY_CLASS);
@@ -284,12 +412,13 @@ int ScheduleManager::DoSync(const std::string& filename, long ms)
             {
                 logger_sync.debug("Remote sync with no filename ... wrong step was running '%s' switching to '%s'.", (const char *)pl->GetRunningStep()->GetNameNoTime().c_str(), (const char *)shouldberunning->GetNameNoTime().c_str());
                 pl->JumpToStep(shouldberunning->GetNameNoTime());
+                _syncClock.Reset();
                 wxCommandEvent event2(EVT_SCHEDULECHANGED);
                 wxPostEvent(wxGetApp().GetTopWindow(), event2);
             }
             if (pl->GetRunningStep() != nullptr)
             {
-                pl->GetRunningStep()->SetSyncPosition(ms, GetOptions()->GetRemoteAcceptableJitter(), true);
+                pl->GetRunningStep()->SetSyncPosition(ms, GetOptions()->GetRemoteAcceptableJitter(), true, &_syncClock);
             }
         }
         else
@@ -329,9 +458,10 @@ int ScheduleManager::DoSync(const std::string& filename, long ms)
                 logger_sync.debug("Remote sync with no filename ... starting playlist '%s' step '%s'.", (const char *)pl->GetNameNoTime().c_str(), (const char *)shouldberunning->GetNameNoTime().c_str());
                 pl->Start(false, false, false);
                 pl->JumpToStep(shouldberunning->GetNameNoTime());
+                _syncClock.Reset();
                 if (pl->GetRunningStep() != nullptr)
                 {
-                    pl->GetRunningStep()->SetSyncPosition(ms, GetOptions()->GetRemoteAcceptableJitter(), true);
+                    pl->GetRunningStep()->SetSyncPosition(ms, GetOptions()->GetRemoteAcceptableJitter(), true, &_syncClock);
                 }
                 _immediatePlay = pl;
                 wxCommandEvent event2(EVT_SCHEDULECHANGED);
@@ -356,6 +486,7 @@ int ScheduleManager::DoSync(const std::string& filename, long ms)
         {
             StartStep(filename);
         }
+        _syncClock.Reset();
         pl = GetRunningPlayList();
         if (pl != nullptr) pls = pl->GetRunningStep();
         wxCommandEvent event2(EVT_SCHEDULECHANGED);
@@ -395,7 +526,7 @@ int ScheduleManager::DoSync(const std::string& filename, long ms)
         }
         else
         {
-            pls->SetSyncPosition((size_t)ms, GetOptions()->GetRemoteAcceptableJitter(), true);
+            pls->SetSyncPosition((size_t)ms, GetOptions()->GetRemoteAcceptableJitter(), true, &_syncClock);
         }
     }
 
@@ -420,6 +551,7 @@ ScheduleManager::~ScheduleManager()
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
     AllOff();
+    _frameOutput->Flush();
     _outputManager->StopOutput();
 #ifdef __WXMSW__
     ::SetPriorityClass(::GetCurrentProcess(), NORMAL_PRIORITY_CLASS);
@@ -430,7 +562,12 @@ ScheduleManager::~ScheduleManager()
 
     if (IsDirty())
     {
-        if (wxMessageBox("Unsaved changes to the schedule. Save now?", "Unsaved changes", wxYES_NO) == wxYES)
+        if (_headless)
+        {
+            logger_base.info("Saving changes to the schedule.");
+            Save();
+        }
+        else if (wxMessageBox("Unsaved changes to the schedule. Save now?", "Unsaved changes", wxYES_NO) == wxYES)
         {
             Save();
         }
@@ -511,6 +648,8 @@ ScheduleManager::~ScheduleManager()
     }
 
     delete _scheduleOptions;
+    delete _frameOutput;
+    _frameOutput = nullptr;
     delete _outputManager;
     _syncManager = nullptr;
 
@@ -718,7 +857,6 @@ void ScheduleManager::AllOff()
     logger_base.debug("Turning all the lights off.");
 
     memset(_buffer, 0x00, _outputManager->GetTotalChannels()); // clear out any prior frame data
-    _outputManager->StartFrame(0);
 
     if ((_backgroundPlayList != nullptr || _eventPlayLists.size() > 0) && _scheduleOptions->IsSendBackgroundWhenNotRunning())
     {
@@ -790,8 +928,7 @@ void ScheduleManager::AllOff()
         it->Frame(_buffer, _outputManager->GetTotalChannels());
     }
 
-    _outputManager->SetManyChannels(0, _buffer, _outputManager->GetTotalChannels());
-    _outputManager->EndFrame();
+    _frameOutput->Send(0, _buffer, _outputManager->GetTotalChannels(), false);
 }
 
 int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
@@ -826,7 +963,6 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
         if (outputframe)
         {
             memset(_buffer, 0x00, totalChannels); // clear out any prior frame data
-            _outputManager->StartFrame(msec);
             TestFrame(_buffer, totalChannels, msec);
         }
 
@@ -859,8 +995,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
         if (outputframe)
         {
-            _outputManager->SetManyChannels(0, _buffer, totalChannels);
-            _outputManager->EndFrame();
+            _frameOutput->Send(msec, _buffer, totalChannels, false);
         }
     }
     else
@@ -884,7 +1019,6 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
             if (outputframe)
             {
                 memset(_buffer, 0x00, totalChannels); // clear out any prior frame data
-                _outputManager->StartFrame(msec);
             }
 
             bool done = false;
@@ -1013,13 +1147,9 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                 logger_frame.debug("Frame: Listening done %ldms", sw.Time());
 
-                _outputManager->SetManyChannels(0, _buffer, totalChannels);
-
-                logger_frame.debug("Frame: Data set %ldms", sw.Time());
-
-                _outputManager->EndFrame();
+                _frameOutput->Send(msec, _buffer, totalChannels, false);
 
-                logger_frame.debug("Frame: Data sent %ldms", sw.Time());
+                logger_frame.debug("Frame: Data queued for output %ldms", sw.Time());
             }
 
             if (done)
@@ -1048,8 +1178,6 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
                 if (outputframe)
                 {
                     memset(_buffer, 0x00, totalChannels); // clear out any prior frame data
-                    _outputManager->StartFrame(0);
-                    _outputManager->AllOff(false);
                 }
 
                 if ((_backgroundPlayList != nullptr || _eventPlayLists.size() > 0) && _scheduleOptions->IsSendBackgroundWhenNotRunning())
@@ -1125,8 +1253,7 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                 if (outputframe)
                 {
-                    _outputManager->SetManyChannels(0, _buffer, totalChannels);
-                    _outputManager->EndFrame();
+                    _frameOutput->Send(0, _buffer, totalChannels, true);
                 }
             }
             else
@@ -1136,8 +1263,6 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
                     if (outputframe)
                     {
                         memset(_buffer, 0x00, totalChannels); // clear out any prior frame data
-                        _outputManager->StartFrame(0);
-                        _outputManager->AllOff(false);
                     }
 
                     auto it = _eventPlayLists.begin();
@@ -1188,13 +1313,13 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
 
                     if (outputframe)
                     {
-                        _outputManager->SetManyChannels(0, _buffer, totalChannels);
-                        _outputManager->EndFrame();
+                        _frameOutput->Send(0, _buffer, totalChannels, true);
                     }
 
                     if (_eventPlayLists.size() == 0)
                     {
                         // last event playlist ended ... turn everything off
+                        _frameOutput->Flush();
                         _outputManager->AllOff(true);
                         for (auto& it2 : *GetOptions()->GetVirtualMatrices())
                         {
@@ -1218,6 +1343,11 @@ int ScheduleManager::Frame(bool outputframe, xScheduleFrame* frame)
     return rate;
 }
 
+uint32_t ScheduleManager::GetDroppedOutputFrames() const
+{
+    return _frameOutput->GetDroppedFrames();
+}
+
 bool ScheduleManager::IsSlave() const
 {
     if (_syncManager != nullptr)
@@ -3698,7 +3828,7 @@ bool ScheduleManager::Query(const wxString& command, const wxString& parameters,
                 "\",\"reference\":\"" + reference +
                 "\",\"passwordset\":\"" + (_scheduleOptions->GetPassword() == ""? "false" : "true") +
                 "\",\"time\":\""+ wxDateTime::Now().Format("%Y-%m-%d %H:%M:%S") +
-                "\"," + GetPingStatus() +"}";
+                "\"," + _frameJitter.GetJSON() + "," + _syncClock.GetJSON() + "," + GetPingStatus() +"}";
         }
         else
         {
@@ -3764,7 +3894,7 @@ bool ScheduleManager::Query(const wxString& command, const wxString& parameters,
                 "\",\"autooutputtolights\":\"" + (_manualOTL ? "false" : "true") +
                 "\",\"passwordset\":\"" + (_scheduleOptions->GetPassword() == "" ? "false" : "true") +
                 "\",\"outputtolights\":\"" + std::string(_outputManager->IsOutputting() ? "true" : "false") + 
-                "\"," + GetPingStatus() + "}";
+                "\"," + _frameJitter.GetJSON() + "," + _syncClock.GetJSON() + "," + GetPingStatus() + "}";
             //static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
             //logger_base.info("%s", (const char*)data.c_str());
         }
@@ -4045,6 +4175,7 @@ void ScheduleManager::SetOutputToLights(xScheduleFrame* frame, bool otl, bool in
                     wxMessageBox("Warning: Lights output is already open in another process. This will cause issues.", "WARNING", 4 | wxCENTRE, frame);
                 }
                 DisableRemoteOutputs();
+                _frameOutput->Flush();
                 bool success = _outputManager->StartOutput();
 #ifdef __WXMSW__
                 ::SetPriorityClass(::GetCurrentProcess(), ABOVE_NORMAL_PRIORITY_CLASS);
@@ -4063,6 +4194,7 @@ void ScheduleManager::SetOutputToLights(xScheduleFrame* frame, bool otl, bool in
         {
             if (IsOutputToLights())
             {
+                _frameOutput->Flush();
                 _outputManager->StopOutput();
 #ifdef __WXMSW__
                 ::SetPriorityClass(::GetCurrentProcess(), NORMAL_PRIORITY_CLASS);
@@ -4089,6 +4221,7 @@ void ScheduleManager::ManualOutputToLightsClick(xScheduleFrame* frame)
             wxMessageBox("Warning: Lights output is already open in another process. This will cause issues.", "WARNING", 4 | wxCENTRE, frame);
         }
         DisableRemoteOutputs();
+        _frameOutput->Flush();
         _outputManager->StartOutput();
 #ifdef __WXMSW__
             ::SetPriorityClass(::GetCurrentProcess(), ABOVE_NORMAL_PRIORITY_CLASS);
@@ -4099,6 +4232,7 @@ void ScheduleManager::ManualOutputToLightsClick(xScheduleFrame* frame)
     }
     else if (_manualOTL == 0)
     {
+        _frameOutput->Flush();
         _outputManager->StopOutput();
 #ifdef __WXMSW__
         ::SetPriorityClass(::GetCurrentProcess(), NORMAL_PRIORITY_CLASS);
@@ -20,6 +20,8 @@
 #include "wxMIDI/src/wxMidi.h"
 #include "Blend.h"
 #include "SyncManager.h"
+#include "FrameJitter.h"
+#include "SyncClock.h"
 
 class PlayListItemText;
 class ScheduleOptions;
@@ -33,6 +35,7 @@ class PlayListItem;
 class xScheduleFrame;
 class Pinger;
 class ListenerManager;
+class FrameOutputThread;
 
 class PixelData
 {
@@ -73,6 +76,7 @@ class ScheduleManager
     int _mode = (int)SYNCMODE::STANDALONE;
     REMOTEMODE _remoteMode = REMOTEMODE::DISABLED;
     bool _testMode = false;
+    bool _headless = false;
     int _manualOTL = 0;
     std::string _showDir;
     int _lastSavedChangeCount = 0;
@@ -80,6 +84,7 @@ class ScheduleManager
 	std::list<PlayList*> _playLists;
     ScheduleOptions* _scheduleOptions;
     OutputManager* _outputManager;
+    FrameOutputThread* _frameOutput = nullptr;
     uint8_t* _buffer = nullptr;
     wxUint32 _startTime = 0;
     PlayList* _immediatePlay = nullptr;
@@ -106,6 +111,8 @@ class ScheduleManager
     bool _webRequestToggle = false;
     Pinger* _pinger = nullptr;
     std::unique_ptr<SyncManager> _syncManager = nullptr;
+    FrameJitter _frameJitter;
+    SyncClock _syncClock;
 
     void DisableRemoteOutputs();
     std::string GetPingStatus();
@@ -137,6 +144,9 @@ class ScheduleManager
         std::list<RunningSchedule*> GetRunningSchedules() const { return _activeSchedules; }
         const SyncManager* GetSyncManager() const { return _syncManager.get(); }
         int GetTimerAdjustment() const { return _timerAdjustment; }
+        FrameJitter& GetFrameJitter() { return _frameJitter; }
+        uint32_t GetDroppedOutputFrames() const;
+        SyncClock& GetSyncClock() { return _syncClock; }
         std::string GetOurIP() const;
         void SetTimerAdjustment(int timerAdjustment) { _timerAdjustment = timerAdjustment; }
         PlayList* GetPlayList(int  id) const;
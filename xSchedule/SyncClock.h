@@ -0,0 +1,125 @@
+#pragma once
+
+/***************************************************************
+ * This source files comes from the xLights project
+ * https://www.xlights.org
+ * https://github.com/smeighan/xLights
+ * See the github commit history for a record of contributing
+ * developers.
+ * Copyright claimed based on commit dates recorded in Github
+ * License: https://github.com/smeighan/xLights/blob/master/License.txt
+ **************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <wx/string.h>
+
+// Software phase locked loop used in remote mode. Each sync packet gives the master's position which
+// is compared with our own playback position. Rather than jumping on every packet the difference is
+// filtered and turned into a small change to the frame timer so playback slews back into step. Only
+// a difference too big to slew away, such as the master seeking, results in a jump.
+class SyncClock
+{
+public:
+    enum class ACTION
+    {
+        NONE,
+        SLEW,
+        SEEK
+    };
+
+private:
+    static constexpr double OFFSET_GAIN = 0.25; // how quickly the filtered offset follows each sample
+    static constexpr double JITTER_GAIN = 0.0625;
+    static constexpr double PROPORTIONAL_GAIN = 0.05; // ms of timer adjustment per ms of offset
+    static constexpr double INTEGRAL_GAIN = 0.0005;
+    static constexpr double MAX_SLEW = 0.1; // never change the frame time by more than 10%
+    static const int SEEK_THRESHOLD_MS = 1000;
+
+    bool _locked = false;
+    double _offset = 0.0; // filtered master - local position in ms, positive means we are behind
+    double _jitter = 0.0; // smoothed mean deviation of each sample from the filtered offset
+    double _integral = 0.0;
+    int _adjustment = 0;
+    long _lastError = 0;
+    uint32_t _samples = 0;
+    uint32_t _seeks = 0;
+
+public:
+    SyncClock() {}
+
+    // call when playback starts again from somewhere else so the next sync is trusted as is
+    void Reset()
+    {
+        _locked = false;
+        _offset = 0.0;
+        _integral = 0.0;
+        _adjustment = 0;
+    }
+
+    // Feed in one sync. masterMS is where the master says we should be and localMS where we are.
+    // acceptableJitter is the offset left alone and canSlew is false when something like audio
+    // controls our timing so changing the frame timer would do nothing.
+    ACTION Update(long masterMS, long localMS, int frameMS, int acceptableJitter, bool canSlew)
+    {
+        long error = masterMS - localMS;
+        _lastError = error;
+        _samples++;
+
+        int seekThreshold = canSlew ? std::max((int)SEEK_THRESHOLD_MS, acceptableJitter * 4) : acceptableJitter * 2;
+        if (!_locked || std::abs(error) > seekThreshold)
+        {
+            _locked = true;
+            _offset = 0.0;
+            _integral = 0.0;
+            _adjustment = 0;
+            _seeks++;
+            return ACTION::SEEK;
+        }
+
+        _offset += OFFSET_GAIN * (error - _offset);
+        _jitter += JITTER_GAIN * (std::abs(error - _offset) - _jitter);
+
+        if (!canSlew)
+        {
+            // a single late packet should not cause a seek so go on the filtered offset
+            if (std::abs(_offset) > acceptableJitter)
+            {
+                _offset = 0.0;
+                _seeks++;
+                return ACTION::SEEK;
+            }
+            return ACTION::NONE;
+        }
+
+        // the integral learns any steady difference between our clock and the master's while the
+        // proportional part only kicks in once we are further out than the acceptable jitter
+        double maxSlew = frameMS * MAX_SLEW;
+        _integral = std::min(maxSlew, std::max(-maxSlew, _integral + INTEGRAL_GAIN * _offset));
+        double adjustment = _integral;
+        if (std::abs(_offset) >= acceptableJitter)
+        {
+            adjustment += PROPORTIONAL_GAIN * _offset;
+        }
+        // the frame timer runs at half the frame time in whole ms so only even adjustments make a difference
+        int newAdjustment = 2 * (int)std::lround(std::min(maxSlew, std::max(-maxSlew, adjustment)) / 2.0);
+
+        if (newAdjustment == _adjustment) return ACTION::NONE;
+        _adjustment = newAdjustment;
+        return ACTION::SLEW;
+    }
+
+    // the change to the frame time in ms ... positive makes frames shorter so we catch up
+    int GetAdjustment() const { return _adjustment; }
+    double GetOffset() const { return _offset; }
+    double GetJitter() const { return _jitter; }
+    uint32_t GetSamples() const { return _samples; }
+    uint32_t GetSeeks() const { return _seeks; }
+
+    std::string GetJSON() const
+    {
+        return wxString::Format("\"syncclock\":{\"samples\":\"%u\",\"seeks\":\"%u\",\"offset\":\"%.1f\",\"jitter\":\"%.1f\",\"lasterror\":\"%ld\",\"adjustment\":\"%d\"}",
+            _samples, _seeks, _offset, _jitter, _lastError, _adjustment).ToStdString();
+    }
+};
@@ -419,6 +419,19 @@ int xScheduleApp::OnExit()
     return 0;
 }
 
+#ifndef __WXMSW__
+#include <csignal>
+
+static void OnQuitSignal(int signal)
+{
+    static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
+    logger_base.info("Signal %d received. Closing xSchedule.", signal);
+
+    wxCommandEvent event(EVT_QUIT);
+    wxPostEvent(wxGetApp().GetTopWindow(), event);
+}
+#endif
+
 bool xScheduleApp::OnInit()
 {
     _checker = nullptr;
@@ -455,6 +468,7 @@ bool xScheduleApp::OnInit()
         { wxCMD_LINE_OPTION, "s", "show", "specify show directory" },
         { wxCMD_LINE_OPTION, "p", "playlist", "specify the playlist to play" },
         { wxCMD_LINE_SWITCH, "w", "wipe", "wipe settings clean" },
+        { wxCMD_LINE_SWITCH, "n", "nogui", "run without showing the user interface or any dialogs, control it through the web api. On Linux a display is still needed, Xvfb will do" },
         { wxCMD_LINE_NONE }
     };
 
@@ -462,6 +476,7 @@ bool xScheduleApp::OnInit()
     bool wipeSettings = false;
     wxString showDir;
     wxString playlist;
+    bool headless = false;
     wxCmdLineParser parser(cmdLineDesc, argc, argv);
     switch (parser.Parse()) {
     case -1:
@@ -483,10 +498,18 @@ bool xScheduleApp::OnInit()
             parmfound = true;
             logger_base.info("-p: Playlist to play %s.", (const char*)playlist.c_str());
         }
+        if (parser.Found("n")) {
+            parmfound = true;
+            headless = true;
+            logger_base.info("-n: Running without the user interface.");
+        }
         if (!parmfound && parser.GetParamCount() > 0)
         {
             logger_base.info("Unrecognised command line parameter found.");
-            wxMessageBox("Unrecognised command line parameter found.", _("Command Line Options")); //give positive feedback*/
+            if (!headless)
+            {
+                wxMessageBox("Unrecognised command line parameter found.", _("Command Line Options")); //give positive feedback*/
+            }
         }
         break;
     default:
@@ -506,7 +529,10 @@ bool xScheduleApp::OnInit()
             // WOuld be nice to switch focuse here to the existing instance ... but that doesnt work ... this only sees windows in this process
             //wxWindow* x = FindWindowByLabel(_("xLights Scheduler"));
 
-            wxMessageBox("Another instance of xSchedule is already running. A second instance not allowed. Exiting.");
+            if (!headless)
+            {
+                wxMessageBox("Another instance of xSchedule is already running. A second instance not allowed. Exiting.");
+            }
 
             return false;
         }
@@ -521,8 +547,19 @@ bool xScheduleApp::OnInit()
     wxInitAllImageHandlers();
     if (wxsOK)
     {
-        xScheduleFrame* Frame = new xScheduleFrame(0, showDir, playlist);
-        Frame->Show();
+        xScheduleFrame* Frame = new xScheduleFrame(0, showDir, playlist, headless);
+        if (!headless)
+        {
+            Frame->Show();
+        }
+#ifndef __WXMSW__
+        else
+        {
+            // let a service manager stop it cleanly, the handler runs from the event loop
+            SetSignalHandler(SIGTERM, &OnQuitSignal);
+            SetSignalHandler(SIGINT, &OnQuitSignal);
+        }
+#endif
         SetTopWindow(Frame);
         if (wipeSettings) Frame->GetPluginManager().WipeSettings();
     }
@@ -361,10 +361,12 @@ BEGIN_EVENT_TABLE(xScheduleFrame,wxFrame)
 // Number of MS after a slow event to show the slow icon for
 #define SLOW_FOR_MS 1500
 
-xScheduleFrame::xScheduleFrame(wxWindow* parent, const std::string& showdir, const std::string& playlist, wxWindowID id)
+xScheduleFrame::xScheduleFrame(wxWindow* parent, const std::string& showdir, const std::string& playlist, bool headless, wxWindowID id)
 {
     static log4cpp::Category &logger_base = log4cpp::Category::getInstance(std::string("log_base"));
 
+    _headless = headless;
+
     OutputManager::SetInteractive(false);
     _pinger = nullptr;
     __schedule = nullptr;
@@ -810,6 +812,12 @@ xScheduleFrame::xScheduleFrame(wxWindow* parent, const std::string& showdir, con
 
     while (!wxDir::Exists(_showDir))
     {
+        if (_headless)
+        {
+            logger_base.error("Show folder '%s' does not exist. Using the current folder.", (const char*)_showDir.c_str());
+            _showDir = ".";
+            break;
+        }
         SelectShowFolder();
     }
 
@@ -1105,7 +1113,13 @@ void xScheduleFrame::OnQuit(wxCommandEvent& event)
 
     if (__schedule->IsDirty())
     {
-        if (wxMessageBox("Unsaved changes to the schedule. Save now?", "Unsaved changes", wxYES_NO) == wxYES)
+        if (_headless)
+        {
+            // changes can only have come from the web api so keep them
+            logger_base.info("Saving changes to the schedule.");
+            __schedule->Save();
+        }
+        else if (wxMessageBox("Unsaved changes to the schedule. Save now?", "Unsaved changes", wxYES_NO) == wxYES)
         {
             __schedule->Save();
         }
@@ -1414,7 +1428,12 @@ void xScheduleFrame::LoadShowDir()
             logger_base.debug("Could not read show folder from 'xLights::LastDir'.");
             DirDialog1->SetPath(_showDir);
 
-            if (DirDialog1->ShowModal() == wxID_OK)
+            if (_headless)
+            {
+                logger_base.error("No show folder set and no user interface to ask for one. Use -s to specify it. Using the current folder.");
+                _showDir = ".";
+            }
+            else if (DirDialog1->ShowModal() == wxID_OK)
             {
                 _showDir = DirDialog1->GetPath().ToStdString();
                 logger_base.debug("User selected show folder '%s'.", (const char *)_showDir.c_str());
@@ -1518,6 +1537,31 @@ void xScheduleFrame::On_timerTrigger(wxTimerEvent& event)
         return;
     }
 
+    // how late this tick is against when the timer thread wanted it, which includes any time
+    // it sat waiting for the UI thread
+    long long due = _timer.GetScheduledFireMS();
+    if (due != 0)
+    {
+        __schedule->GetFrameJitter().Record(now - due);
+    }
+    static long long lastJitterLog = now;
+    if (now - lastJitterLog > 300000)
+    {
+        lastJitterLog = now;
+        if (__schedule->IsOutputToLights())
+        {
+            logger_base.info("Frame timer lateness: %s, frames dropped by output %u", (const char*)__schedule->GetFrameJitter().GetSummary().c_str(), __schedule->GetDroppedOutputFrames());
+        }
+
+        // logged with and without the user interface so the cost of each can be compared
+        static double lastCPU = 0;
+        double cpu;
+        long rss;
+        GetProcessUsage(cpu, rss);
+        logger_base.info("Process usage%s: cpu %.1f%% over the last 5 minutes, resident memory %ldKB.", _headless ? " (no user interface)" : "", (cpu - lastCPU) * 100.0 / 300.0, rss);
+        lastCPU = cpu;
+    }
+
     logger_frame.info("Timer: Start frame %d", elapsed);
     if (elapsed > _timer.GetInterval() * 4)
     {
@@ -1574,6 +1618,14 @@ void xScheduleFrame::UpdateSchedule()
     wxStopWatch sw;
     logger_frame.debug("Updating the schedule.");
 
+    if (_headless)
+    {
+        CorrectTimer(__schedule->CheckSchedule());
+        UpdateScheduleTimer();
+        logger_frame.debug("    Schedule updated %ldms", sw.Time());
+        return;
+    }
+
     TreeCtrl_PlayListsSchedules->Freeze();
 
     int rate = __schedule->CheckSchedule();
@@ -1648,7 +1700,22 @@ void xScheduleFrame::UpdateSchedule()
     logger_frame.debug("    Tree updated %ldms", sw.Time());
 
     CorrectTimer(rate);
+    UpdateScheduleTimer();
 
+    logger_frame.debug("    Timers sorted %ldms", sw.Time());
+
+    UpdateUI();
+
+    logger_frame.debug("    UI updated %ldms", sw.Time());
+
+    TreeCtrl_PlayListsSchedules->Thaw();
+    TreeCtrl_PlayListsSchedules->Refresh();
+
+    logger_frame.debug("    Schedule updated %ldms", sw.Time());
+}
+
+void xScheduleFrame::UpdateScheduleTimer()
+{
     // Ensure I am firing on the minute
     if (wxDateTime::Now().GetSecond() != 0)
     {
@@ -1660,17 +1727,6 @@ void xScheduleFrame::UpdateSchedule()
     {
         _timerSchedule.Start(60000, false);
     }
-
-    logger_frame.debug("    Timers sorted %ldms", sw.Time());
-
-    UpdateUI();
-
-    logger_frame.debug("    UI updated %ldms", sw.Time());
-
-    TreeCtrl_PlayListsSchedules->Thaw();
-    TreeCtrl_PlayListsSchedules->Refresh();
-
-    logger_frame.debug("    Schedule updated %ldms", sw.Time());
 }
 
 void xScheduleFrame::On_timerScheduleTrigger(wxTimerEvent& event)
@@ -2501,6 +2557,12 @@ void xScheduleFrame::CreateDebugReport(wxDebugReportCompress *report) {
 
     report->Process();
 
+    if (_headless && cb == "Prompt user")
+    {
+        // there is no one to ask so keep the report but do not send it
+        cb = "Silently exit without sending crash log";
+    }
+
     if (cb == "Silently exit after sending crash log" || (cb == "Prompt user" && wxDebugReportPreviewStd().Show(*report))) {
         if (cb != "Silently exit after sending crash log")
         {
@@ -3212,6 +3274,8 @@ void xScheduleFrame::UpdateUI(bool force)
 {
     wxASSERT(wxThread::IsMain());
 
+    if (_headless) return;
+
     wxStopWatch sw;
     static log4cpp::Category &logger_frame = log4cpp::Category::getInstance(std::string("log_frame"));
     logger_frame.debug("        Update UI");
@@ -71,6 +71,7 @@ class xScheduleFrame : public wxFrame
     wxBitmap _slowicon;
     bool _webIconDisplayed;
     bool _slowDisplayed;
+    bool _headless = false;
     wxLongLong _lastSlow;
     PluginManager _pluginManager;
 
@@ -83,6 +84,7 @@ class xScheduleFrame : public wxFrame
     void CreateButtons();
     void UpdateStatus(bool force = false);
     void UpdateSchedule();
+    void UpdateScheduleTimer();
     void SendReport(const wxString &loc, wxDebugReportCompress &report);
     std::string GetScheduleName(Schedule* schedule, const std::list<RunningSchedule*>& active) const;
     void LoadSchedule();
@@ -125,12 +127,16 @@ class xScheduleFrame : public wxFrame
 public:
 
         static ScheduleManager* GetScheduleManager() { return __schedule; }
-        xScheduleFrame(wxWindow* parent, const std::string& showdir = "", const std::string& playlist = "", wxWindowID id = -1);
+        xScheduleFrame(wxWindow* parent, const std::string& showdir = "", const std::string& playlist = "", bool headless = false, wxWindowID id = -1);
         virtual ~xScheduleFrame();
         void CreateDebugReport(wxDebugReportCompress *report);
         void CreateButton(const std::string& label, const wxColor& c);
         void SetTempMessage(const std::string& msg);
         PluginManager& GetPluginManager() { return _pluginManager; }
+
+        // when headless the window is never shown, none of the periodic UI updates are done
+        // and nothing waits on a dialog
+        bool IsHeadless() const { return _headless; }
         std::string GetWebPluginRequest(const std::string& request);
         wxString ProcessPluginRequest(const wxString& plugin, const wxString& command, const wxString& parameters, const wxString& data, const wxString& reference);
         void ManipulateBuffer(uint8_t* buffer, size_t bufferSize);